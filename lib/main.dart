@@ -1,9 +1,11 @@
 import 'package:flutter/cupertino.dart';
 import 'package:flutter/material.dart';
 import 'package:gem_kit/core.dart' as gem;
+import 'package:gem_kit/landmark_store.dart' as gem;
 import 'package:gem_kit/map.dart' as gem;
 import 'package:gem_kit/navigation.dart' as gem;
 import 'package:gem_kit/routing.dart' as gem;
+import 'package:gem_kit/search.dart' as gem;
 import 'package:gem_kit/sense.dart' as gem;
 import 'package:permission_handler/permission_handler.dart';
 import 'package:geolocator/geolocator.dart';
@@ -31,6 +33,9 @@ const Color kPrimaryColor = Color(0xFF287EE8);
 const Duration kApiTimeout = Duration(seconds: 30);
 const Duration kLocationUpdateInterval = Duration(seconds: 1);
 const double kArrivalThreshold = 50.0; // meters
+const double kOffRouteThreshold = 50.0; // meters
+const int kOffRouteFixes = 3;
+const Duration kRerouteCooldown = Duration(seconds: 15);
 const String kApiKeyEndpoint = 
   'https://personal-d9p61k4i.outsystemscloud.com/production/rest/v1/token';
 const String kSearchEndpoint = 
@@ -38,6 +43,8 @@ const String kSearchEndpoint =
 const String kOneSignalAppId = "34f8a9aa-4822-485a-bd21-9d3c20692dd9";
 const String kMapStyleAsset = "assets/map.style";
 const String kLogoAsset = "assets/logo.png";
+const String kRecentDestinationsStore = "routico_recent_destinations";
+const String kRecentDestinationsIndexKey = "recent_destinations_index";
 const String kArabicLanguageCode = "ar";
 const int kMaxApiRetries = 5;
 const int kRouteCalculationTimeout = 30; // seconds
@@ -412,6 +419,8 @@ class _MyHomePageState extends State<MyHomePage> with WidgetsBindingObserver {
   Position? _currentPosition;
   gem.Coordinates? _destinationCoords;
   gem.Route? _currentRoute;
+  late final gem.TrafficEventTracker _trafficTracker =
+      gem.TrafficEventTracker(onDiff: _logTrafficDiff);
   gem.TimeDistance? _currentTimeDistance;
   gem.TimeDistance? _remainingTimeDistance;
   gem.NavigationInstruction? currentInstruction;
@@ -439,7 +448,14 @@ class _MyHomePageState extends State<MyHomePage> with WidgetsBindingObserver {
   // Data
   String? _destinationName;
   final TextEditingController _searchController = TextEditingController();
-  List<dynamic> _searchResults = [];
+  List<gem.Landmark> _searchResults = [];
+  List<gem.Landmark> _recentResults = [];
+  late final gem.TypeAheadSearch _typeAheadSearch;
+  gem.LandmarkStore? _recentDestinations;
+  gem.LandmarkPrefixIndex? _recentDestinationsIndex;
+  StreamSubscription<gem.TypeAheadResults>? _searchSubscription;
+  String _latestSearchQuery = '';
+  bool _isSearchErrorShown = false;
   
   // Global scaffold key
   final GlobalKey<ScaffoldState> _scaffoldKey = GlobalKey<ScaffoldState>();
@@ -448,6 +464,7 @@ class _MyHomePageState extends State<MyHomePage> with WidgetsBindingObserver {
   late FlutterTts _flutterTts;
   late StreamSubscription<List<ConnectivityResult>> _connectivitySubscription;
   StreamSubscription<Position>? _positionStream;
+  gem.ExternalPositionFeed? _positionFeed;
 
   // Navigation Metrics
   double _remainingDistance = 0.0;
@@ -456,12 +473,26 @@ class _MyHomePageState extends State<MyHomePage> with WidgetsBindingObserver {
   double _totalDistance = 0.0;
   DateTime? _expectedArrivalTime;
 
+  // Off-route detection
+  int _offRouteFixes = 0;
+  DateTime? _lastRerouteTime;
+  // Incremented when a navigation is replaced, so the replaced one's
+  // cancellation does not stop the guidance
+  int _navigationGeneration = 0;
+
 @override
 void initState() {
   super.initState();
   
   // Add lifecycle observer
   WidgetsBinding.instance.addObserver(this);
+
+  _typeAheadSearch = gem.TypeAheadSearch(remoteProvider: _searchRemote);
+  _searchSubscription = _typeAheadSearch.results.listen((results) {
+    if (mounted) {
+      setState(() => _searchResults = [..._recentResults, ...results.landmarks]);
+    }
+  });
   
   // Initialize UI-dependent services only after widget is built
   WidgetsBinding.instance.addPostFrameCallback((_) {
@@ -744,6 +775,10 @@ Future<void> _updateDispatchOrderCount() async {
     try {
       _connectivitySubscription.cancel();
       _positionStream?.cancel();
+      _positionFeed?.stop(restoreLiveDataSource: false);
+      _recentDestinationsIndex?.dispose();
+      _searchSubscription?.cancel();
+      _typeAheadSearch.dispose();
       gem.RoutingService.cancelRoute(_routingHandler!);
       gem.NavigationService.cancelNavigation(_navigationHandler);
       _flutterTts.stop();
@@ -979,7 +1014,13 @@ Future<void> _updateDispatchOrderCount() async {
     }
 
     try {
-      if (!_hasLiveDataSource) {
+      // Feed the SDK from the same Geolocator stream the UI uses, so only
+      // one GPS consumer runs during navigation
+      _positionFeed ??= gem.ExternalPositionFeed.start(
+        maxAccuracyH: 10.0,
+        minInterval: kLocationUpdateInterval,
+      );
+      if (_positionFeed == null && !_hasLiveDataSource) {
         gem.PositionService.instance.setLiveDataSource();
         _hasLiveDataSource = true;
       }
@@ -1010,12 +1051,28 @@ Future<void> _updateDispatchOrderCount() async {
       ).listen(
         (position) {
           if (!mounted) return;
+          final feed = _positionFeed;
+          final accepted = feed != null
+              ? feed.push(
+                  timestamp: position.timestamp,
+                  latitude: position.latitude,
+                  longitude: position.longitude,
+                  altitude: position.altitude,
+                  speed: position.speed,
+                  course: position.heading,
+                  accuracyH: position.accuracy,
+                  accuracyV: position.altitudeAccuracy,
+                  speedAccuracy: position.speedAccuracy,
+                  courseAccuracy: position.headingAccuracy,
+                )
+              : position.accuracy <= 10.0;
           // Only update if GPS accuracy is extremely high
-          if (position.accuracy <= 10.0) {
+          if (accepted) {
             setState(() => _currentPosition = position);
             _updateNavigationProgress();
+            _checkOffRoute();
           } else {
-            debugPrint('GPS accuracy too low (${position.accuracy}m), ignoring movement');
+            debugPrint('GPS fix filtered (${position.accuracy}m), ignoring movement');
           }
         },
         onError: (error) {
@@ -1052,43 +1109,110 @@ Future<void> _updateDispatchOrderCount() async {
     });
   }
 
+  // Reroutes once several consecutive fixes are away from the route
+  void _checkOffRoute() {
+    final route = _currentRoute;
+    final position = _currentPosition;
+    if (route == null || position == null || _isCalculatingRoute) return;
+
+    final coords = gem.Coordinates(
+      latitude: position.latitude,
+      longitude: position.longitude,
+    );
+    final distance = route.getDistanceOnRoute(coords, false);
+    final offset = distance < 0
+        ? double.infinity
+        : route.getCoordinateOnRoute(distance).distance(coords);
+    if (offset <= kOffRouteThreshold) {
+      _offRouteFixes = 0;
+      return;
+    }
+    if (++_offRouteFixes < kOffRouteFixes) return;
+
+    final now = DateTime.now();
+    if (_lastRerouteTime != null &&
+        now.difference(_lastRerouteTime!) < kRerouteCooldown) {
+      return;
+    }
+    _offRouteFixes = 0;
+    _lastRerouteTime = now;
+    debugPrint('Off route by ${offset.toStringAsFixed(0)}m, rerouting');
+    _rerouteFromCurrentPosition();
+  }
+
   void _handleArrival() {
     setState(() => _showArrivalMessage = true);
     Future.delayed(const Duration(seconds: 10), _stopNavigation);
   }
 
-  Future<void> _performSearch(String query) async {
-    if (query.isEmpty) {
-      setState(() => _searchResults = []);
-      return;
-    }
+  void _performSearch(String query) {
+    final reference = _currentPosition != null
+        ? gem.Coordinates(
+            latitude: _currentPosition!.latitude,
+            longitude: _currentPosition!.longitude,
+          )
+        : gem.Coordinates(latitude: 0, longitude: 0);
+    _latestSearchQuery = query;
+    _typeAheadSearch.update(query, reference);
+
+    // Recent destinations are answered locally and listed first, without
+    // waiting for the backend
+    final index = _recentDestinationsIndex;
+    if (index == null) return;
+    index.lookup(query, reference).then((recent) {
+      if (!mounted || query != _latestSearchQuery) return;
+      setState(() {
+        final previous = _recentResults.length;
+        _recentResults = recent;
+        _searchResults = [...recent, ..._searchResults.skip(previous)];
+      });
+    });
+  }
 
+  Future<List<gem.Landmark>> _searchRemote(String query, gem.Coordinates reference) async {
     try {
-      final response = await http.get(
-        Uri.parse('$kSearchEndpoint?q=$query')
-      ).timeout(kApiTimeout);
-      
-      if (response.statusCode == 200) {
-        setState(() => _searchResults = json.decode(response.body));
-      } else {
+      final uri = Uri.parse(kSearchEndpoint).replace(queryParameters: {'q': query});
+      final response = await http.get(uri).timeout(kApiTimeout);
+
+      if (response.statusCode != 200) {
         throw Exception('فشل تحميل نتائج البحث');
       }
+
+      final List<dynamic> items = json.decode(response.body);
+      _isSearchErrorShown = false;
+      return items.map((item) {
+        return gem.Landmark.withLatLng(
+          latitude: (item['latitude'] as num).toDouble(),
+          longitude: (item['longitude'] as num).toDouble(),
+        )
+          ..name = item['firstname'] ?? 'Unknown'
+          ..description = "${item['street']}, ${item['area']}, ${item['governorate']}";
+      }).toList();
     } catch (e) {
-      _showSnackBar('$kSearchFailed: $e');
+      // Superseded keystrokes fail silently, and a failing backend is
+      // reported once until a search succeeds again
+      if (query == _latestSearchQuery && !_isSearchErrorShown) {
+        _isSearchErrorShown = true;
+        _showSnackBar('$kSearchFailed: $e');
+      }
+      rethrow;
     }
   }
 
-  void _selectDestination(dynamic result) {
+  void _selectDestination(gem.Landmark result) {
     FocusScope.of(context).unfocus();
+    _typeAheadSearch.cancel();
+    _latestSearchQuery = '';
+    _saveRecentDestination(result);
+    final coords = result.coordinates;
     
+    // The previous route leads to the old destination, it must not be rerouted
+    _currentRoute = null;
     setState(() {
-      _destinationName = result['firstname'];
+      _destinationName = result.name;
       _isSearching = false;
       _searchController.clear();
-      _destinationCoords = gem.Coordinates(
-        latitude: result['latitude'],
-        longitude: result['longitude'],
-      );
+      _destinationCoords = coords;
     });
 
     if (_currentPosition != null) {
@@ -1097,10 +1221,7 @@ Future<void> _updateDispatchOrderCount() async {
           latitude: _currentPosition!.latitude,
           longitude: _currentPosition!.longitude,
         ),
-        gem.Landmark.withLatLng(
-          latitude: result['latitude'],
-          longitude: result['longitude'],
-        ),
+        gem.Landmark.withCoordinates(coords),
       );
     } else {
       _showSnackBar('بانتظار الموقع الحالي...');
@@ -1136,6 +1257,38 @@ Future<void> _updateDispatchOrderCount() async {
     );
   }
 
+  // A new calculation from the current position with the previous route's
+  // preferences, following its remaining part up to the next stop. No search
+  // state of the previous calculation is reused
+  void _rerouteFromCurrentPosition() {
+    setState(() => _isCalculatingRoute = true);
+
+    _routingHandler = gem.RoutingService.recalculateRoute(
+      _currentRoute!,
+      gem.Coordinates(
+        latitude: _currentPosition!.latitude,
+        longitude: _currentPosition!.longitude,
+      ),
+      (err, routes) {
+        if (!mounted) return;
+
+        setState(() => _isCalculatingRoute = false);
+
+        if (err == gem.GemError.success && routes.isNotEmpty) {
+          _handleRouteSuccess(routes.first);
+          // Guidance continues on the new route
+          if (_navigationHandler != null) {
+            _navigationGeneration++;
+            gem.NavigationService.cancelNavigation(_navigationHandler);
+            _beginNavigation(routes.first);
+          }
+        } else {
+          _handleRouteError(err);
+        }
+      },
+    );
+  }
+
   void _handleRouteSuccess(gem.Route route) {
     _currentRoute = route;
     _currentTimeDistance = route.getTimeDistance(activePart: false);
@@ -1158,8 +1311,23 @@ Future<void> _updateDispatchOrderCount() async {
   }
 
   void _logTrafficEvents(gem.Route route) {
-    for (final event in route.trafficEvents) {
-      debugPrint('Traffic Event: ${event.description}');
+    // A new route starts a new tracking, every event is reported as added
+    _trafficTracker
+      ..reset()
+      ..updateFromRoute(route);
+  }
+
+  void _logTrafficDiff(gem.TrafficEventSnapshotDiff diff) {
+    final current = diff.current;
+    for (final i in diff.added) {
+      debugPrint('Traffic Event: ${current.descriptions[i]}');
+    }
+    for (final i in diff.changed) {
+      debugPrint('Traffic Event updated: ${current.descriptions[i]} '
+          '(${current.delays[i]} s)');
+    }
+    for (final i in diff.removed) {
+      debugPrint('Traffic Event cleared: ${diff.previous!.descriptions[i]}');
     }
   }
 
@@ -1169,16 +1337,53 @@ Future<void> _updateDispatchOrderCount() async {
         : kRouteCalculationFailed;
         
     _showSnackBar(errorMsg);
+    _currentRoute = null;
     setState(() => _areRoutesBuilt = false);
   }
 
   void _onMapCreated(gem.GemMapController controller) {
     _mapController = controller;
     _configureSdkLanguage();
+    _initRecentDestinations();
     _setupMapCallbacks();
     _centerMapIfPositionExists();
   }
 
+  Future<void> _initRecentDestinations() async {
+    try {
+      final store = gem.LandmarkStoreService.createLandmarkStore(kRecentDestinationsStore);
+      final prefs = await SharedPreferences.getInstance();
+      final saved = prefs.getString(kRecentDestinationsIndexKey);
+
+      _recentDestinations = store;
+      _recentDestinationsIndex = saved != null
+          ? gem.LandmarkPrefixIndex.fromBytes(store, base64Decode(saved))
+          : gem.LandmarkPrefixIndex.build(store);
+    } catch (e) {
+      debugPrint("Recent destinations index error: $e");
+    }
+  }
+
+  Future<void> _saveRecentDestination(gem.Landmark destination) async {
+    final store = _recentDestinations;
+    final index = _recentDestinationsIndex;
+    if (store == null || index == null) return;
+
+    try {
+      final coords = destination.coordinates;
+      final isKnown = index
+          .search(destination.name, position: coords, limit: 1, maxEdits: 0)
+          .any((match) => match.name == destination.name && match.distance < 50);
+      if (isKnown) return;
+
+      store.addLandmark(destination);
+      final prefs = await SharedPreferences.getInstance();
+      await prefs.setString(kRecentDestinationsIndexKey, base64Encode(index.toBytes()));
+    } catch (e) {
+      debugPrint("Error saving recent destination: $e");
+    }
+  }
+
   void _configureSdkLanguage() {
     try {
       final arabicLang = gem.SdkSettings.languageList
@@ -1257,8 +1462,17 @@ Future<void> _updateDispatchOrderCount() async {
       await Future.delayed(const Duration(milliseconds: 300));
     }
 
+    _beginNavigation(mainRoute);
+
+    _speak("أبدأ الملاحة إلى وجهتك");
+    
+    }
+
+  void _beginNavigation(gem.Route route) {
+    final generation = ++_navigationGeneration;
+    _offRouteFixes = 0;
     _navigationHandler = gem.NavigationService.startNavigation(
-      mainRoute,
+      route,
       null,
       onNavigationInstruction: (instruction, events) {
         if (!mounted) return;
@@ -1277,17 +1491,20 @@ Future<void> _updateDispatchOrderCount() async {
       onTextToSpeechInstruction: (ttsInstruction) {
         if (!_isVoiceMuted) _speak(ttsInstruction);
       },
+      onRouteUpdated: (route) {
+        // Keep progress computed against the route the engine recalculated
+        _currentRoute = route;
+        _trafficTracker.updateFromRoute(route);
+      },
       onError: (error) {
+        if (generation != _navigationGeneration) return;
         if (error != gem.GemError.cancel && mounted) {
           _showSnackBar('$kNavigationFailed: $error');
         }
         _stopNavigation();
       },
     );
-    
-    _speak("أبدأ الملاحة إلى وجهتك");
-    
-    }
+  }
   
   Future<bool> _speak(String text) async {
     if (_isVoiceMuted) return false;
@@ -1307,7 +1524,10 @@ Future<void> _updateDispatchOrderCount() async {
     
     WakelockPlus.disable();
     gem.NavigationService.cancelNavigation(_navigationHandler);
+    _navigationHandler = null;
     _positionStream?.cancel();
+    _positionFeed?.stop();
+    _positionFeed = null;
     _flutterTts.stop();
     
     setState(() {
@@ -1851,9 +2071,9 @@ Future<void> _updateDispatchOrderCount() async {
             final result = _searchResults[index];
             return ListTile(
               leading: const Icon(Icons.location_on, color: kPrimaryColor),
-              title: Text(result['firstname'] ?? 'Unknown', textDirection: TextDirection.rtl),
+              title: Text(result.name, textDirection: TextDirection.rtl),
               subtitle: Text(
-                "${result['street']}, ${result['area']}, ${result['governorate']}",
+                result.description,
                 overflow: TextOverflow.ellipsis,
                 textDirection: TextDirection.rtl,
               ),
@@ -223,6 +223,38 @@ window.callHeapU8Subarray = function(imgBufferPtr, imgBufferSize) {
     }
   }
 
+  // Runs a batch of native calls described by a table in the WebAssembly heap.
+  // Each record holds the request pointer and length, and receives the response pointer and length.
+  // The responses held by the first freeCount records are freed first, so a call with a count of 0 frees a decoded batch.
+  window.gemNativeCallBatch = function gemNativeCallBatch(table, count, freeCount) {
+    const base = table >> 2;
+    for (let i = 0; i < freeCount; i++) {
+      const response = Module.HEAP32[base + i * 4 + 2];
+      if (response !== 0) {
+        Module._gemFree(response);
+      }
+    }
+    for (let i = 0; i < count; i++) {
+      const record = base + i * 4;
+      const response = Module._native_call(Module.HEAP32[record], Module.HEAP32[record + 1]);
+      // The heap views are replaced if the call grew the memory
+      Module.HEAP32[record + 2] = response;
+      Module.HEAP32[record + 3] = response === 0 ? 0 : Module.HEAPU8.indexOf(0, response) - response;
+    }
+  }
+
+  // Runs a single native call whose request was written in the WebAssembly heap.
+  // The response is decoded and freed here, so the call takes a single interop hop. Returns null if the call failed.
+  window.gemNativeCall = function gemNativeCall(request, length) {
+    const response = Module._native_call(request, length);
+    if (response === 0) {
+      return null;
+    }
+    const result = Module.UTF8ToString(response);
+    Module._gemFree(response);
+    return result;
+  }
+
   window.registerWeakPtr = function registerWeakPtr(pointerId)
   {
     return new Module.AutoReleaseObject(pointerId);
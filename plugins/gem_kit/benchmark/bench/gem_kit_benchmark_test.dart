@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+// Runs the benchmarks headlessly and writes the results as JSON.
+//
+// Settings, from the environment:
+// * GEM_BENCHMARK_OUTPUT: results file, benchmark_results.json by default
+// * GEM_BENCHMARK_BASELINE: results of a previous run to compare with
+// * GEM_BENCHMARK_TOLERANCE: allowed throughput loss, 0.1 by default
+// * GEM_BENCHMARK_FILTER: only run the benchmarks containing this text
+// * GEM_BENCHMARK_DURATION_MS: measuring time of each benchmark
+
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit_benchmark/gem_kit_benchmark.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  test(
+    'gem_kit benchmarks',
+    () async {
+      final Map<String, String> env = Platform.environment;
+
+      // The plugin side of the initialization needs an embedder, the SDK is
+      // initialized from the native library only
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(
+        const MethodChannel('plugins.flutter.dev/gem_engine'),
+        (final MethodCall call) async => null,
+      );
+      await GemKit.initialize(allowInternetConnection: false);
+
+      final BenchmarkRunner runner = BenchmarkRunner(
+        duration: Duration(
+          milliseconds:
+              int.tryParse(env['GEM_BENCHMARK_DURATION_MS'] ?? '') ?? 3000,
+        ),
+        filter: env['GEM_BENCHMARK_FILTER'],
+      );
+      final List<BenchmarkResult> results = await runner.runAll(
+        allBenchmarks(),
+        BenchmarkContext(),
+        onResult: (final BenchmarkResult result) {
+          // ignore: avoid_print
+          print(
+            !result.hasRun
+                ? '${result.name}: '
+                    '${result.isSkipped ? 'skipped' : 'failed'} '
+                    '(${result.skipReason ?? result.failure})'
+                : '${result.name}: '
+                    '${result.unitsPerSecond.toStringAsFixed(1)} '
+                    '${result.unit}/s, '
+                    'p50 ${result.p50Microseconds.toStringAsFixed(2)} us, '
+                    'p99 ${result.p99Microseconds.toStringAsFixed(2)} us',
+          );
+        },
+      );
+
+      final Map<String, dynamic> report = <String, dynamic>{
+        'time': DateTime.now().toUtc().toIso8601String(),
+        'os': Platform.operatingSystemVersion,
+        'results':
+            results.map((final BenchmarkResult r) => r.toJson()).toList(),
+      };
+
+      List<BenchmarkComparison> comparisons = <BenchmarkComparison>[];
+      final String? baselinePath = env['GEM_BENCHMARK_BASELINE'];
+      if (baselinePath != null) {
+        final Map<String, dynamic> baseline =
+            jsonDecode(await File(baselinePath).readAsString());
+        comparisons = compareWithBaseline(
+          results,
+          (baseline['results'] as List<dynamic>)
+              .map(
+                (final dynamic json) => BenchmarkResult.fromJson(json),
+              )
+              .toList(),
+          tolerance:
+              double.tryParse(env['GEM_BENCHMARK_TOLERANCE'] ?? '') ?? 0.1,
+          filter: env['GEM_BENCHMARK_FILTER'],
+        );
+        report['baseline'] = baselinePath;
+        report['comparisons'] = comparisons
+            .map((final BenchmarkComparison c) => c.toJson())
+            .toList();
+      }
+
+      final File output =
+          File(env['GEM_BENCHMARK_OUTPUT'] ?? 'benchmark_results.json');
+      await output.writeAsString(
+        const JsonEncoder.withIndent('  ').convert(report),
+      );
+
+      final List<String> regressions = comparisons
+          .where((final BenchmarkComparison c) => c.isRegression)
+          .map(
+            (final BenchmarkComparison c) => c.failure != null
+                ? '${c.name} (${c.failure})'
+                : '${c.name} (${(c.change * 100).toStringAsFixed(1)}%)',
+          )
+          .toList();
+      expect(regressions, isEmpty, reason: 'Regressed from the baseline');
+    },
+    timeout: Timeout.none,
+  );
+}
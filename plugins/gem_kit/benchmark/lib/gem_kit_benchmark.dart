@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'src/bridge_benchmarks.dart';
+import 'src/geometry_benchmarks.dart';
+import 'src/harness.dart';
+import 'src/landmark_store_benchmarks.dart';
+import 'src/map_benchmarks.dart';
+import 'src/service_benchmarks.dart';
+
+export 'src/bridge_benchmarks.dart';
+export 'src/geometry_benchmarks.dart';
+export 'src/harness.dart';
+export 'src/landmark_store_benchmarks.dart';
+export 'src/map_benchmarks.dart';
+export 'src/service_benchmarks.dart';
+
+/// All the benchmark cases, cheapest first.
+List<GemBenchmark> allBenchmarks() => <GemBenchmark>[
+      ObjectMethodRoundTripBenchmark(),
+      EventDispatchBenchmark(),
+      GemListIterationBenchmark(),
+      ImageRenderingBenchmark(),
+      SerializeMarkersBenchmark(),
+      AddMarkerListBenchmark(),
+      TransformWgsListToScreenBenchmark(),
+      SensePushBenchmark(batched: false),
+      SensePushBenchmark(batched: true),
+      PolygonContainsBenchmark(prepared: false),
+      PolygonContainsBenchmark(prepared: true),
+      PreparedPolygonContainsAllBenchmark(),
+      PreparedPolygonCollectionBenchmark(),
+      AddLandmarkColumnsBenchmark(),
+      for (final int count in <int>[10000, 100000, 1000000])
+        BuildSpatialIndexBenchmark(count: count),
+      for (final int count in <int>[10000, 100000, 1000000])
+        for (final SpatialQuery query in SpatialQuery.values)
+          SpatialIndexQueryBenchmark(query, count: count),
+      SearchBenchmark(),
+      CalculateRouteBenchmark(),
+    ];
@@ -0,0 +1,207 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+// ignore_for_file: implementation_imports
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:typed_data';
+import 'dart:ui' show Size;
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/sense.dart';
+import 'package:gem_kit/src/core/event_handler.dart';
+import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+
+import 'harness.dart';
+
+/// Round trip of a method call without work on the native side.
+class ObjectMethodRoundTripBenchmark extends GemBenchmark {
+  ObjectMethodRoundTripBenchmark({this.calls = 200})
+      : super('bridge.objectMethod', unit: 'call');
+
+  final int calls;
+
+  @override
+  int run(final BenchmarkContext context) {
+    for (int i = 0; i < calls; i++) {
+      Debug.isMainThread();
+    }
+    return calls;
+  }
+}
+
+/// Iteration of a list held by the native side, one call per item.
+class GemListIterationBenchmark extends GemBenchmark {
+  GemListIterationBenchmark({this.length = 500})
+      : super('bridge.gemListIteration', unit: 'item');
+
+  final int length;
+  late LandmarkList _list;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    _list = LandmarkList.fromList(
+      List<Landmark>.generate(
+        length,
+        (final int i) => Landmark.withLatLng(
+          latitude: context.origin.latitude + i * 1e-4,
+          longitude: context.origin.longitude,
+        ),
+      ),
+    );
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    double sum = 0;
+    for (final Landmark landmark in _list) {
+      sum += landmark.coordinates.latitude;
+    }
+    metrics['checksum'] = sum;
+    return _list.length;
+  }
+}
+
+/// Rendering of an image to renderable bytes.
+class ImageRenderingBenchmark extends GemBenchmark {
+  ImageRenderingBenchmark({this.width = 256, this.height = 256})
+      : super('bridge.imageRendering', unit: 'image');
+
+  final int width;
+  final int height;
+  late Img _image;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    _image = Img(gradientBitmap(width, height), format: ImageFileFormat.bmp);
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    final Uint8List? bytes = _image.getRenderableImageBytes(
+      size: Size(width.toDouble(), height.toDouble()),
+    );
+    if (bytes == null) {
+      throw StateError('The image could not be rendered');
+    }
+    metrics['bytes'] = bytes.length;
+    return 1;
+  }
+}
+
+/// Dispatch of native events to their handlers, from the received message to the handler call.
+class EventDispatchBenchmark extends GemBenchmark {
+  EventDispatchBenchmark({this.events = 1000})
+      : super('bridge.eventDispatch', unit: 'event');
+
+  static const int _handlerId = 0x7fff0001;
+
+  final int events;
+  final _CountingEventHandler _handler = _CountingEventHandler();
+  late String _message;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    GemKitPlatform.instance.registerEventHandler(_handlerId, _handler);
+    _message = jsonEncode(<String, dynamic>{
+      'eventName': '$_handlerId',
+      'arguments': <String, dynamic>{
+        'event_subtype': 'onProgress',
+        'progress': 42,
+      },
+    });
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    final int start = _handler.count;
+    for (int i = 0; i < events; i++) {
+      GemKitPlatform.instance.nativeMethodHandler(jsonDecode(_message));
+    }
+    if (_handler.count - start != events) {
+      throw StateError('Events were not dispatched');
+    }
+    return events;
+  }
+
+  @override
+  void tearDown(final BenchmarkContext context) {
+    GemKitPlatform.instance.unregisterEventHandler(_handlerId);
+  }
+}
+
+class _CountingEventHandler implements EventHandler {
+  int count = 0;
+
+  @override
+  void handleEvent(final Map<dynamic, dynamic> arguments) => count++;
+
+  @override
+  FutureOr<void> dispose() {}
+}
+
+/// Sustained push of acceleration samples to an external data source, one call per sample or as a [SenseDataBatch].
+class SensePushBenchmark extends GemBenchmark {
+  SensePushBenchmark({required this.batched, this.samples = 500})
+      : super(
+          batched ? 'sense.pushBatch' : 'sense.pushData',
+          unit: 'sample',
+        );
+
+  final bool batched;
+  final int samples;
+  DataSource? _dataSource;
+  final SenseDataBatch _batch = SenseDataBatch();
+  int _timestamp = 0;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    final DataSource? dataSource =
+        DataSource.createExternalDataSource(<DataType>[DataType.acceleration]);
+    if (dataSource == null) {
+      throw StateError('The external data source could not be created');
+    }
+    _dataSource = dataSource..start();
+    _timestamp = DateTime.now().millisecondsSinceEpoch;
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    final DataSource dataSource = _dataSource!;
+    int accepted = 0;
+    if (batched) {
+      for (int i = 0; i < samples; i++) {
+        _batch.addAcceleration(_timestamp++, 0.01 * i, 0.02, 0.98);
+      }
+      accepted = dataSource.pushBatch(_batch);
+    } else {
+      for (int i = 0; i < samples; i++) {
+        final Acceleration sample = SenseDataFactory.produceAcceleration(
+          acquisitionTime: DateTime.fromMillisecondsSinceEpoch(_timestamp++),
+          x: 0.01 * i,
+          y: 0.02,
+          z: 0.98,
+        );
+        if (dataSource.pushData(sample)) {
+          accepted++;
+        }
+      }
+    }
+    metrics['accepted'] = accepted;
+    return samples;
+  }
+
+  @override
+  void tearDown(final BenchmarkContext context) {
+    _dataSource?.stop();
+    _dataSource = null;
+  }
+}
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+
+import 'harness.dart';
+
+/// Star shaped polygon with [vertexCount] vertices and a radius of about [radius] degrees.
+PolygonGeographicArea _starPolygon(
+  final Coordinates center,
+  final int vertexCount, {
+  final double radius = 0.05,
+}) {
+  return PolygonGeographicArea(
+    coordinates: List<Coordinates>.generate(vertexCount, (final int i) {
+      final double angle = 2 * pi * i / vertexCount;
+      final double r = i.isEven ? radius : radius * 0.6;
+      return Coordinates(
+        latitude: center.latitude + r * sin(angle),
+        longitude: center.longitude + r * cos(angle),
+      );
+    }),
+  );
+}
+
+/// Random points around [center], as interleaved latitude and longitude values.
+Float64List _randomPoints(
+  final Coordinates center,
+  final int count, {
+  final double span = 0.12,
+  final int seed = 17,
+}) {
+  final Random random = Random(seed);
+  final Float64List points = Float64List(2 * count);
+  for (int i = 0; i < count; i++) {
+    points[2 * i] = center.latitude + (random.nextDouble() - 0.5) * span;
+    points[2 * i + 1] = center.longitude + (random.nextDouble() - 0.5) * span;
+  }
+  return points;
+}
+
+/// Point in polygon tests, with a plain or a prepared polygon.
+class PolygonContainsBenchmark extends GemBenchmark {
+  PolygonContainsBenchmark({
+    required this.prepared,
+    this.vertexCount = 1000,
+    this.points = 10000,
+  }) : super(
+          prepared
+              ? 'geometry.preparedPolygon.contains.$vertexCount'
+              : 'geometry.polygon.containsCoordinates.$vertexCount',
+          unit: 'point',
+        );
+
+  final bool prepared;
+  final int vertexCount;
+  final int points;
+  late GeographicArea _area;
+  late List<Coordinates> _points;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    final PolygonGeographicArea polygon =
+        _starPolygon(context.origin, vertexCount);
+    _area = prepared ? PreparedPolygonGeographicArea(polygon) : polygon;
+    final Float64List latLons = _randomPoints(context.origin, points);
+    _points = List<Coordinates>.generate(
+      points,
+      (final int i) => Coordinates(
+        latitude: latLons[2 * i],
+        longitude: latLons[2 * i + 1],
+      ),
+    );
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    int inside = 0;
+    for (final Coordinates point in _points) {
+      if (_area.containsCoordinates(point)) {
+        inside++;
+      }
+    }
+    metrics['inside'] = inside;
+    return points;
+  }
+}
+
+/// Batch point in polygon tests with [PreparedPolygonGeographicArea.containsAll].
+class PreparedPolygonContainsAllBenchmark extends GemBenchmark {
+  PreparedPolygonContainsAllBenchmark({
+    this.vertexCount = 1000,
+    this.points = 10000,
+  }) : super(
+          'geometry.preparedPolygon.containsAll.$vertexCount',
+          unit: 'point',
+        );
+
+  final int vertexCount;
+  final int points;
+  late PreparedPolygonGeographicArea _area;
+  late Float64List _latLons;
+  late Uint8List _result;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    _area = PreparedPolygonGeographicArea(
+      _starPolygon(context.origin, vertexCount),
+    );
+    _latLons = _randomPoints(context.origin, points);
+    _result = Uint8List(points);
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    _area.containsAll(_latLons, _result);
+    return points;
+  }
+}
+
+/// Assignment of points to the first containing polygon of a [PreparedPolygonCollection].
+class PreparedPolygonCollectionBenchmark extends GemBenchmark {
+  PreparedPolygonCollectionBenchmark({
+    this.polygonCount = 500,
+    this.vertexCount = 64,
+    this.points = 10000,
+  }) : super(
+          'geometry.preparedPolygonCollection.firstContaining.$polygonCount',
+          unit: 'point',
+        );
+
+  final int polygonCount;
+  final int vertexCount;
+  final int points;
+  late PreparedPolygonCollection _collection;
+  late Float64List _latLons;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    final Random random = Random(19);
+    _collection = PreparedPolygonCollection(
+      List<PreparedPolygonGeographicArea>.generate(
+        polygonCount,
+        (final int i) => PreparedPolygonGeographicArea(
+          _starPolygon(
+            Coordinates(
+              latitude: context.origin.latitude + random.nextDouble() - 0.5,
+              longitude: context.origin.longitude + random.nextDouble() - 0.5,
+            ),
+            vertexCount,
+            radius: 0.02,
+          ),
+        ),
+      ),
+    );
+    _latLons = _randomPoints(context.origin, points, span: 1.0);
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    final Int32List first = _collection.firstContaining(_latLons);
+    int assigned = 0;
+    for (final int index in first) {
+      if (index >= 0) {
+        assigned++;
+      }
+    }
+    metrics['assigned'] = assigned;
+    return points;
+  }
+}
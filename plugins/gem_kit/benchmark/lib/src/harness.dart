@@ -0,0 +1,463 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/map.dart';
+
+/// Shared inputs of the benchmarks.
+class BenchmarkContext {
+  BenchmarkContext({
+    this.mapController,
+    final Coordinates? origin,
+    final Coordinates? destination,
+    this.searchText = 'restaurant',
+  })  : origin = origin ?? Coordinates(latitude: 48.8566, longitude: 2.3522),
+        destination =
+            destination ?? Coordinates(latitude: 48.8049, longitude: 2.1204);
+
+  /// Map used by the map view benchmarks. They are skipped when null
+  final GemMapController? mapController;
+
+  /// Start of the routes, and reference position of the searches. Must be covered by the offline maps
+  final Coordinates origin;
+
+  /// End of the routes. Must be covered by the offline maps
+  final Coordinates destination;
+
+  /// Text of the searches
+  final String searchText;
+}
+
+/// A benchmark case.
+///
+/// [run] is called repeatedly, and each call is one sample. It returns the number of units it processed, so rates are reported per unit.
+abstract class GemBenchmark {
+  GemBenchmark(this.name, {this.unit = 'op'});
+
+  /// The benchmark name, used as key in the results and baselines
+  final String name;
+
+  /// The processed unit
+  final String unit;
+
+  /// Additional measurements, reported with the results
+  final Map<String, num> metrics = <String, num>{};
+
+  /// The reason why the benchmark cannot run in the context, or null if it can run.
+  String? skipReason(final BenchmarkContext context) => null;
+
+  /// Prepare the inputs. Not measured.
+  FutureOr<void> setUp(final BenchmarkContext context) {}
+
+  /// Prepare a sample. Not measured.
+  FutureOr<void> beforeEach(final BenchmarkContext context) {}
+
+  /// Run one sample.
+  ///
+  /// **Returns**
+  ///
+  /// * The number of processed units.
+  FutureOr<int> run(final BenchmarkContext context);
+
+  /// Release the inputs. Not measured.
+  FutureOr<void> tearDown(final BenchmarkContext context) {}
+}
+
+/// Result of a benchmark.
+class BenchmarkResult {
+  BenchmarkResult({
+    required this.name,
+    required this.unit,
+    this.samples = 0,
+    this.units = 0,
+    this.unitsPerSecond = 0,
+    this.p50Microseconds = 0,
+    this.p90Microseconds = 0,
+    this.p99Microseconds = 0,
+    this.metrics = const <String, num>{},
+    this.skipReason,
+    this.failure,
+  });
+
+  factory BenchmarkResult.fromJson(final Map<String, dynamic> json) {
+    return BenchmarkResult(
+      name: json['name'],
+      unit: json['unit'],
+      samples: json['samples'] ?? 0,
+      units: json['units'] ?? 0,
+      unitsPerSecond: (json['unitsPerSecond'] as num? ?? 0).toDouble(),
+      p50Microseconds: (json['p50Us'] as num? ?? 0).toDouble(),
+      p90Microseconds: (json['p90Us'] as num? ?? 0).toDouble(),
+      p99Microseconds: (json['p99Us'] as num? ?? 0).toDouble(),
+      metrics: Map<String, num>.from(json['metrics'] ?? <String, num>{}),
+      skipReason: json['skipped'],
+      failure: json['failed'],
+    );
+  }
+
+  final String name;
+  final String unit;
+
+  /// Number of measured samples
+  final int samples;
+
+  /// Number of processed units
+  final int units;
+
+  /// Throughput
+  final double unitsPerSecond;
+
+  /// Median time per unit, in microseconds
+  final double p50Microseconds;
+
+  /// 90th percentile time per unit, in microseconds
+  final double p90Microseconds;
+
+  /// 99th percentile time per unit, in microseconds
+  final double p99Microseconds;
+
+  /// Additional measurements of the benchmark
+  final Map<String, num> metrics;
+
+  /// The reason why the benchmark was skipped, null if it ran
+  final String? skipReason;
+
+  /// The error which stopped the benchmark, null if it completed
+  final String? failure;
+
+  bool get isSkipped => skipReason != null;
+
+  bool get isFailed => failure != null;
+
+  /// Whether the benchmark produced measurements
+  bool get hasRun => !isSkipped && !isFailed;
+
+  Map<String, dynamic> toJson() {
+    final Map<String, dynamic> json = <String, dynamic>{};
+    json['name'] = name;
+    json['unit'] = unit;
+    if (skipReason != null) {
+      json['skipped'] = skipReason;
+      return json;
+    }
+    if (failure != null) {
+      json['failed'] = failure;
+      return json;
+    }
+    json['samples'] = samples;
+    json['units'] = units;
+    json['unitsPerSecond'] = unitsPerSecond;
+    json['p50Us'] = p50Microseconds;
+    json['p90Us'] = p90Microseconds;
+    json['p99Us'] = p99Microseconds;
+    if (metrics.isNotEmpty) {
+      json['metrics'] = metrics;
+    }
+    return json;
+  }
+}
+
+/// Runs benchmark cases.
+class BenchmarkRunner {
+  BenchmarkRunner({
+    this.warmUp = const Duration(milliseconds: 500),
+    this.duration = const Duration(seconds: 3),
+    this.minSamples = 5,
+    this.maxSamples = 10000,
+    this.filter,
+  });
+
+  /// Time spent running each case before measuring
+  final Duration warmUp;
+
+  /// Time spent measuring each case, once [minSamples] samples are taken
+  final Duration duration;
+
+  final int minSamples;
+  final int maxSamples;
+
+  /// Only the cases with a name matching this pattern are run
+  final Pattern? filter;
+
+  /// Run the benchmarks.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *benchmarks* The cases.
+  /// * **IN** *context* The shared inputs.
+  /// * **IN** *onResult* Called after each case.
+  ///
+  /// **Returns**
+  ///
+  /// * The results, in the order of the cases.
+  Future<List<BenchmarkResult>> runAll(
+    final List<GemBenchmark> benchmarks,
+    final BenchmarkContext context, {
+    final void Function(BenchmarkResult result)? onResult,
+  }) async {
+    final List<BenchmarkResult> results = <BenchmarkResult>[];
+    for (final GemBenchmark benchmark in benchmarks) {
+      if (filter != null && !benchmark.name.contains(filter!)) {
+        continue;
+      }
+      final BenchmarkResult result = await run(benchmark, context);
+      results.add(result);
+      onResult?.call(result);
+    }
+    return results;
+  }
+
+  /// Run a benchmark.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *benchmark* The case.
+  /// * **IN** *context* The shared inputs.
+  ///
+  /// **Returns**
+  ///
+  /// * The result. Failures of the case, including runs processing no units, are reported as failed results.
+  Future<BenchmarkResult> run(
+    final GemBenchmark benchmark,
+    final BenchmarkContext context,
+  ) async {
+    final String? reason = benchmark.skipReason(context);
+    if (reason != null) {
+      return BenchmarkResult(
+        name: benchmark.name,
+        unit: benchmark.unit,
+        skipReason: reason,
+      );
+    }
+
+    try {
+      await benchmark.setUp(context);
+
+      final Stopwatch total = Stopwatch()..start();
+      while (total.elapsed < warmUp) {
+        await benchmark.beforeEach(context);
+        await benchmark.run(context);
+      }
+
+      final List<double> perUnit = <double>[];
+      final Stopwatch sample = Stopwatch();
+      int units = 0;
+      int elapsed = 0;
+      // Runs processing no units are not sampled but still bound the loop
+      int runs = 0;
+      total.reset();
+      while (runs < maxSamples &&
+          (runs < minSamples || total.elapsed < duration)) {
+        runs++;
+        await benchmark.beforeEach(context);
+        sample
+          ..reset()
+          ..start();
+        final int count = await benchmark.run(context);
+        sample.stop();
+        final int microseconds = sample.elapsedMicroseconds;
+        if (count > 0) {
+          units += count;
+          elapsed += microseconds;
+          perUnit.add(microseconds / count);
+        }
+      }
+      if (units == 0) {
+        return BenchmarkResult(
+          name: benchmark.name,
+          unit: benchmark.unit,
+          failure: 'no ${benchmark.unit} processed in $runs runs',
+        );
+      }
+
+      perUnit.sort();
+      return BenchmarkResult(
+        name: benchmark.name,
+        unit: benchmark.unit,
+        samples: perUnit.length,
+        units: units,
+        unitsPerSecond: units * 1e6 / max(elapsed, 1),
+        p50Microseconds: _percentile(perUnit, 0.5),
+        p90Microseconds: _percentile(perUnit, 0.9),
+        p99Microseconds: _percentile(perUnit, 0.99),
+        metrics: Map<String, num>.of(benchmark.metrics),
+      );
+    } catch (e) {
+      return BenchmarkResult(
+        name: benchmark.name,
+        unit: benchmark.unit,
+        failure: '$e',
+      );
+    } finally {
+      await benchmark.tearDown(context);
+    }
+  }
+
+  static double _percentile(final List<double> sorted, final double fraction) {
+    if (sorted.isEmpty) {
+      return 0;
+    }
+    final int index =
+        min(sorted.length - 1, (sorted.length * fraction).floor());
+    return sorted[index];
+  }
+}
+
+/// Comparison of a benchmark result with its baseline.
+class BenchmarkComparison {
+  BenchmarkComparison({
+    required this.name,
+    required this.baseline,
+    required this.current,
+    required this.tolerance,
+    this.failure,
+  });
+
+  final String name;
+
+  /// Baseline throughput, in units per second
+  final double baseline;
+
+  /// Current throughput, in units per second
+  final double current;
+
+  /// Allowed throughput loss, as a fraction of the baseline
+  final double tolerance;
+
+  /// Why the benchmark has no current measurement, null if it ran
+  final String? failure;
+
+  /// Relative throughput change. Negative values are slowdowns
+  double get change => baseline == 0 ? 0 : current / baseline - 1;
+
+  /// Whether the benchmark is slower than the tolerance allows, or did not run
+  bool get isRegression => failure != null || change < -tolerance;
+
+  Map<String, dynamic> toJson() {
+    final Map<String, dynamic> json = <String, dynamic>{};
+    json['name'] = name;
+    json['baseline'] = baseline;
+    json['current'] = current;
+    json['change'] = change;
+    json['regression'] = isRegression;
+    if (failure != null) {
+      json['failed'] = failure;
+    }
+    return json;
+  }
+}
+
+/// Compare results with a baseline.
+///
+/// A benchmark which ran in the baseline and is missing, skipped or failed in the current results is a regression, as is any failed benchmark.
+/// Benchmarks which did not run in the baseline are otherwise not compared.
+///
+/// **Parameters**
+///
+/// * **IN** *results* The current results.
+/// * **IN** *baseline* The baseline results.
+/// * **IN** *tolerance* Allowed throughput loss, as a fraction of the baseline.
+/// * **IN** *filter* The filter of the current run. Baseline benchmarks not matching it are not expected in the results.
+///
+/// **Returns**
+///
+/// * The comparisons, in the order of the baseline, followed by the failed benchmarks missing from it.
+List<BenchmarkComparison> compareWithBaseline(
+  final List<BenchmarkResult> results,
+  final List<BenchmarkResult> baseline, {
+  final double tolerance = 0.1,
+  final Pattern? filter,
+}) {
+  final Map<String, BenchmarkResult> resultByName = <String, BenchmarkResult>{
+    for (final BenchmarkResult result in results) result.name: result,
+  };
+  final Set<String> compared = <String>{};
+  final List<BenchmarkComparison> comparisons = <BenchmarkComparison>[];
+  for (final BenchmarkResult reference in baseline) {
+    if (!reference.hasRun ||
+        (filter != null && !reference.name.contains(filter))) {
+      continue;
+    }
+    final BenchmarkResult? result = resultByName[reference.name];
+    String? failure;
+    if (result == null) {
+      failure = 'missing';
+    } else if (result.isSkipped) {
+      failure = 'skipped: ${result.skipReason}';
+    } else if (result.isFailed) {
+      failure = result.failure;
+    }
+    compared.add(reference.name);
+    comparisons.add(
+      BenchmarkComparison(
+        name: reference.name,
+        baseline: reference.unitsPerSecond,
+        current: failure == null ? result!.unitsPerSecond : 0,
+        tolerance: tolerance,
+        failure: failure,
+      ),
+    );
+  }
+  for (final BenchmarkResult result in results) {
+    if (result.isFailed && !compared.contains(result.name)) {
+      comparisons.add(
+        BenchmarkComparison(
+          name: result.name,
+          baseline: 0,
+          current: 0,
+          tolerance: tolerance,
+          failure: result.failure,
+        ),
+      );
+    }
+  }
+  return comparisons;
+}
+
+/// Create a 24 bits BMP image with a gradient.
+///
+/// **Parameters**
+///
+/// * **IN** *width* The image width.
+/// * **IN** *height* The image height.
+///
+/// **Returns**
+///
+/// * The BMP file bytes.
+Uint8List gradientBitmap(final int width, final int height) {
+  final int rowSize = (width * 3 + 3) & ~3;
+  final int size = 54 + rowSize * height;
+  final ByteData data = ByteData(size)
+    ..setUint8(0, 0x42)
+    ..setUint8(1, 0x4d)
+    ..setUint32(2, size, Endian.little)
+    ..setUint32(10, 54, Endian.little)
+    ..setUint32(14, 40, Endian.little)
+    ..setInt32(18, width, Endian.little)
+    ..setInt32(22, height, Endian.little)
+    ..setUint16(26, 1, Endian.little)
+    ..setUint16(28, 24, Endian.little)
+    ..setUint32(34, rowSize * height, Endian.little);
+  // Rows are stored bottom-up
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      final int offset = 54 + y * rowSize + x * 3;
+      data
+        ..setUint8(offset, x * 255 ~/ width)
+        ..setUint8(offset + 1, y * 255 ~/ height)
+        ..setUint8(offset + 2, 128);
+    }
+  }
+  return data.buffer.asUint8List();
+}
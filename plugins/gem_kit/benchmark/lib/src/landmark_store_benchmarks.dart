@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/landmark_store.dart';
+
+import 'harness.dart';
+
+/// Landmarks spread over a square of [span] degrees around [center].
+LandmarkColumns _randomColumns(
+  final Coordinates center,
+  final int count, {
+  final double span = 1.0,
+}) {
+  final Random random = Random(11);
+  final Float64List latitudes = Float64List(count);
+  final Float64List longitudes = Float64List(count);
+  for (int i = 0; i < count; i++) {
+    latitudes[i] = center.latitude + (random.nextDouble() - 0.5) * span;
+    longitudes[i] = center.longitude + (random.nextDouble() - 0.5) * span;
+  }
+  return LandmarkColumns(
+    names: List<String>.generate(count, (final int i) => 'landmark $i'),
+    latitudes: latitudes,
+    longitudes: longitudes,
+  );
+}
+
+Future<void> _addColumns(
+  final LandmarkStore store,
+  final LandmarkColumns columns,
+  final Img image,
+) {
+  final Completer<void> completer = Completer<void>();
+  store.addLandmarkColumns(
+    columns,
+    image: image,
+    onCompleteCallback: (final GemError error) {
+      if (error != GemError.success) {
+        completer.completeError(StateError('Import failed: $error'));
+      } else {
+        completer.complete();
+      }
+    },
+  );
+  return completer.future;
+}
+
+/// A landmark store created for a benchmark and removed after it.
+class _BenchmarkStore {
+  LandmarkStore? store;
+  Img? image;
+
+  LandmarkStore open(final String name) {
+    image = Img(gradientBitmap(16, 16), format: ImageFileFormat.bmp);
+    final LandmarkStore created =
+        LandmarkStoreService.createLandmarkStore(name);
+    created.removeAllLandmarks();
+    return store = created;
+  }
+
+  void close() {
+    final LandmarkStore? current = store;
+    if (current != null) {
+      LandmarkStoreService.removeLandmarkStore(current.id);
+    }
+    store = null;
+  }
+}
+
+/// Bulk addition of landmarks to a store with [LandmarkStore.addLandmarkColumns].
+class AddLandmarkColumnsBenchmark extends GemBenchmark {
+  AddLandmarkColumnsBenchmark({this.count = 10000})
+      : super('landmarkStore.addLandmarkColumns', unit: 'landmark');
+
+  final int count;
+  final _BenchmarkStore _store = _BenchmarkStore();
+  late LandmarkColumns _columns;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    _store.open('benchmark_columns');
+    _columns = _randomColumns(context.origin, count);
+  }
+
+  @override
+  void beforeEach(final BenchmarkContext context) {
+    _store.store!.removeAllLandmarks();
+  }
+
+  @override
+  Future<int> run(final BenchmarkContext context) async {
+    await _addColumns(_store.store!, _columns, _store.image!);
+    return count;
+  }
+
+  @override
+  void tearDown(final BenchmarkContext context) => _store.close();
+}
+
+/// Construction of a [LandmarkSpatialIndex] over a store.
+class BuildSpatialIndexBenchmark extends GemBenchmark {
+  BuildSpatialIndexBenchmark({required this.count})
+      : super('landmarkSpatialIndex.build.$count', unit: 'landmark');
+
+  final int count;
+  final _BenchmarkStore _store = _BenchmarkStore();
+
+  @override
+  Future<void> setUp(final BenchmarkContext context) {
+    final LandmarkStore store = _store.open('benchmark_spatial_$count');
+    return _addColumns(
+      store,
+      _randomColumns(context.origin, count),
+      _store.image!,
+    );
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    LandmarkSpatialIndex.build(_store.store!).dispose();
+    return count;
+  }
+
+  @override
+  void tearDown(final BenchmarkContext context) => _store.close();
+}
+
+/// Kind of [LandmarkSpatialIndex] query.
+enum SpatialQuery { nearest, withinRadius, countInArea }
+
+/// Queries of a [LandmarkSpatialIndex] around random positions.
+class SpatialIndexQueryBenchmark extends GemBenchmark {
+  SpatialIndexQueryBenchmark(
+    this.query, {
+    this.count = 100000,
+    this.queries = 100,
+  }) : super('landmarkSpatialIndex.${query.name}.$count', unit: 'query');
+
+  final SpatialQuery query;
+  final int count;
+  final int queries;
+  final _BenchmarkStore _store = _BenchmarkStore();
+  LandmarkSpatialIndex? _index;
+  late List<Coordinates> _positions;
+
+  @override
+  Future<void> setUp(final BenchmarkContext context) async {
+    final LandmarkStore store = _store.open('benchmark_query_$count');
+    await _addColumns(
+      store,
+      _randomColumns(context.origin, count),
+      _store.image!,
+    );
+    _index = LandmarkSpatialIndex.build(store);
+
+    final Random random = Random(13);
+    _positions = List<Coordinates>.generate(
+      queries,
+      (final int i) => Coordinates(
+        latitude: context.origin.latitude + random.nextDouble() - 0.5,
+        longitude: context.origin.longitude + random.nextDouble() - 0.5,
+      ),
+    );
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    final LandmarkSpatialIndex index = _index!;
+    int found = 0;
+    for (final Coordinates position in _positions) {
+      switch (query) {
+        case SpatialQuery.nearest:
+          found += index.nearest(position, 10).totalCount;
+        case SpatialQuery.withinRadius:
+          found += index.withinRadius(position, 1000).totalCount;
+        case SpatialQuery.countInArea:
+          found += index.countInArea(
+            RectangleGeographicArea(
+              topLeft: Coordinates(
+                latitude: position.latitude + 0.01,
+                longitude: position.longitude - 0.01,
+              ),
+              bottomRight: Coordinates(
+                latitude: position.latitude - 0.01,
+                longitude: position.longitude + 0.01,
+              ),
+            ),
+          );
+      }
+    }
+    metrics['found'] = found;
+    return queries;
+  }
+
+  @override
+  void tearDown(final BenchmarkContext context) {
+    _index?.dispose();
+    _index = null;
+    _store.close();
+  }
+}
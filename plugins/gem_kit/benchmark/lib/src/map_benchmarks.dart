@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+// ignore_for_file: implementation_imports
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/map.dart';
+import 'package:gem_kit/src/gem_kit_native_utils.dart';
+
+import 'harness.dart';
+
+const String _noMapReason = 'requires a map view';
+
+List<MarkerWithRenderSettings> _markers(
+  final Coordinates center,
+  final int count,
+) {
+  final Random random = Random(7);
+  return List<MarkerWithRenderSettings>.generate(
+    count,
+    (final int i) => MarkerWithRenderSettings(
+      MarkerJson(
+        coords: <Coordinates>[
+          Coordinates(
+            latitude: center.latitude + (random.nextDouble() - 0.5) * 0.2,
+            longitude: center.longitude + (random.nextDouble() - 0.5) * 0.2,
+          ),
+        ],
+        name: 'marker $i',
+      ),
+      MarkerRenderSettings(),
+    ),
+  );
+}
+
+/// Serialization of a marker list to the buffer sent to the native side.
+class SerializeMarkersBenchmark extends GemBenchmark {
+  SerializeMarkersBenchmark({this.count = 1000})
+      : super('markers.serialize', unit: 'marker');
+
+  final int count;
+  late List<MarkerWithRenderSettings> _list;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    _list = _markers(context.origin, count);
+  }
+
+  @override
+  int run(final BenchmarkContext context) {
+    final Uint8List bytes = serializeListOfMarkers(_list);
+    metrics['bytes'] = bytes.length;
+    return count;
+  }
+}
+
+/// Addition of a marker list to a map view, including the serialization.
+class AddMarkerListBenchmark extends GemBenchmark {
+  AddMarkerListBenchmark({this.count = 1000})
+      : super('markers.addList', unit: 'marker');
+
+  final int count;
+  late List<MarkerWithRenderSettings> _list;
+
+  @override
+  String? skipReason(final BenchmarkContext context) =>
+      context.mapController == null ? _noMapReason : null;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    _list = _markers(context.origin, count);
+  }
+
+  @override
+  Future<void> beforeEach(final BenchmarkContext context) =>
+      context.mapController!.preferences.markers.clear();
+
+  @override
+  Future<int> run(final BenchmarkContext context) async {
+    final List<int> ids =
+        await context.mapController!.preferences.markers.addList(
+      list: _list,
+      settings: MarkerCollectionRenderSettings(),
+      name: 'benchmark',
+    );
+    return ids.length;
+  }
+
+  @override
+  Future<void> tearDown(final BenchmarkContext context) async {
+    await context.mapController?.preferences.markers.clear();
+  }
+}
+
+/// Transformation of WGS coordinates to screen coordinates.
+class TransformWgsListToScreenBenchmark extends GemBenchmark {
+  TransformWgsListToScreenBenchmark({this.count = 1000})
+      : super('map.transformWgsListToScreen', unit: 'point');
+
+  final int count;
+  late List<Coordinates> _coordinates;
+
+  @override
+  String? skipReason(final BenchmarkContext context) =>
+      context.mapController == null ? _noMapReason : null;
+
+  @override
+  void setUp(final BenchmarkContext context) {
+    _coordinates = _markers(context.origin, count)
+        .map((final MarkerWithRenderSettings item) => item.marker.coords.first)
+        .toList();
+  }
+
+  @override
+  int run(final BenchmarkContext context) =>
+      context.mapController!.transformWgsListToScreen(_coordinates).length;
+}
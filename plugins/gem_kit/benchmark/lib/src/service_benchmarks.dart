@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/routing.dart';
+import 'package:gem_kit/search.dart';
+
+import 'harness.dart';
+
+/// Route calculation between the context origin and destination, using the offline maps.
+class CalculateRouteBenchmark extends GemBenchmark {
+  CalculateRouteBenchmark() : super('routing.calculateRoute', unit: 'route');
+
+  @override
+  Future<int> run(final BenchmarkContext context) {
+    final Completer<int> completer = Completer<int>();
+    RoutingService.calculateRoute(
+      <Landmark>[
+        Landmark.withCoordinates(context.origin),
+        Landmark.withCoordinates(context.destination),
+      ],
+      RoutePreferences(),
+      (final GemError err, final List<Route> routes) {
+        if (err != GemError.success) {
+          completer.completeError(StateError('Routing failed: $err'));
+          return;
+        }
+        metrics['routes'] = routes.length;
+        completer.complete(1);
+      },
+    );
+    return completer.future;
+  }
+}
+
+/// Text search around the context origin, using the offline maps.
+class SearchBenchmark extends GemBenchmark {
+  SearchBenchmark() : super('search.search', unit: 'search');
+
+  @override
+  Future<int> run(final BenchmarkContext context) {
+    final Completer<int> completer = Completer<int>();
+    SearchService.search(
+      context.searchText,
+      context.origin,
+      (final GemError err, final List<Landmark> results) {
+        if (err != GemError.success && err != GemError.reducedResult) {
+          completer.completeError(StateError('Search failed: $err'));
+          return;
+        }
+        metrics['results'] = results.length;
+        completer.complete(1);
+      },
+    );
+    return completer.future;
+  }
+}
@@ -11,6 +11,8 @@
 /// Content store related classes
 library;
 
+export 'src/contentstore/content_delta_update.dart';
+export 'src/contentstore/content_download_scheduler.dart';
 export 'src/contentstore/content_store.dart';
 export 'src/contentstore/content_store_item.dart';
 export 'src/contentstore/content_store_item_status.dart';
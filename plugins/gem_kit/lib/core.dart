@@ -15,6 +15,8 @@ export 'src/core/address_info.dart';
 export 'src/core/alarm_list.dart';
 export 'src/core/alarm_listener.dart';
 export 'src/core/alarm_service.dart';
+export 'src/core/bridge_profiler.dart'
+    show BridgeCallKind, BridgeCallStats, BridgeProfile;
 export 'src/core/auto_update_settings.dart';
 export 'src/core/contact_info.dart';
 export 'src/core/coordinates.dart';
@@ -24,7 +26,9 @@ export 'src/core/exceptions.dart';
 export 'src/core/external_info.dart';
 export 'src/core/gem_error.dart';
 export 'src/core/gem_kit.dart';
+export 'src/core/gem_scope.dart';
 export 'src/core/generic_categories.dart';
+export 'src/core/geofence_engine.dart';
 export 'src/core/geographic_area.dart';
 export 'src/core/image_handler.dart';
 export 'src/core/image_ids.dart';
@@ -34,11 +38,21 @@ export 'src/core/landmark.dart';
 export 'src/core/landmark_category.dart';
 export 'src/core/language.dart';
 export 'src/core/map_view_routes_collection.dart';
+export 'src/core/object_lifetime_tracker.dart'
+    show
+        ObjectClassStats,
+        ObjectMemorySample,
+        ObjectStats,
+        objectAgeBucketLimits;
 export 'src/core/offboard_listener.dart';
+export 'src/core/packed_geometry.dart';
+export 'src/core/packed_terrain_profile.dart';
 export 'src/core/parameters.dart';
 export 'src/core/path.dart';
 export 'src/core/persistent_roadblock_listener.dart';
+export 'src/core/persistent_roadblock_set.dart' hide PersistentRoadblockSets;
 export 'src/core/position_quality.dart';
+export 'src/core/prepared_geographic_area.dart';
 export 'src/core/progress_listener.dart'; // Remove
 export 'src/core/route.dart';
 export 'src/core/sdk_settings.dart';
@@ -51,6 +65,7 @@ export 'src/core/terrain_profile.dart';
 export 'src/core/time_distance_coordinates.dart';
 export 'src/core/timezone.dart';
 export 'src/core/traffic.dart';
+export 'src/core/traffic_event_snapshot.dart';
 export 'src/core/transfer_statistics.dart';
 export 'src/core/turn_details.dart';
 export 'src/core/types.dart';
@@ -12,6 +12,10 @@
 library;
 
 export 'src/landmarkstore/landmark_browse_session.dart';
+export 'src/landmarkstore/landmark_columns.dart';
+export 'src/landmarkstore/landmark_prefix_index.dart';
+export 'src/landmarkstore/landmark_record_page.dart';
+export 'src/landmarkstore/landmark_spatial_index.dart';
 export 'src/landmarkstore/landmark_store.dart';
 export 'src/landmarkstore/landmark_store_collection.dart';
 export 'src/landmarkstore/landmark_store_listener.dart';
@@ -17,3 +17,4 @@ export 'src/core/generic_categories_ids.dart';
 export 'src/search/guided_address_search.dart';
 export 'src/search/search_preferences.dart';
 export 'src/search/search_service.dart';
+export 'src/search/type_ahead_search.dart';
@@ -12,12 +12,17 @@
 library;
 
 export 'src/core/position_road_modifier.dart';
+export 'src/position/external_position_feed.dart';
 export 'src/position/position_service.dart';
 export 'src/sense/data_source_listener.dart';
+export 'src/sense/log_chunk_uploader.dart';
 export 'src/sense/log_uploader.dart';
 export 'src/sense/logupload_listener.dart';
 export 'src/sense/recorder.dart';
 export 'src/sense/recorder_data_types.dart';
+export 'src/sense/recorder_log_catalog.dart';
 export 'src/sense/sense_data.dart';
+export 'src/sense/sense_data_batch.dart';
+export 'src/sense/sense_data_columns.dart';
 export 'src/sense/sense_data_source.dart';
 export 'src/sense/sense_data_types.dart';
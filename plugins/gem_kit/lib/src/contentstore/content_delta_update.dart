@@ -0,0 +1,569 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/contentstore/content_store.dart';
+import 'package:gem_kit/src/contentstore/content_store_item.dart';
+import 'package:gem_kit/src/core/gem_error.dart';
+import 'package:gem_kit/src/core/types.dart';
+
+/// Block layout of a version of a content file, used for delta updates.
+///
+/// The file is split in blocks of [blockSize] bytes, the last one possibly shorter, and each block is identified by a 53 bit hash.
+///
+/// {@category Content}
+class ContentBlockManifest {
+  /// Create a manifest.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *blockSize* The size of a block in bytes.
+  /// * **IN** *fileSize* The size of the file in bytes.
+  /// * **IN** *blockHashes* The hash of each block, computed with [hashBlock].
+  ///
+  /// **Throws**
+  ///
+  /// * [ArgumentError] if the number of hashes does not match the file size.
+  ContentBlockManifest({
+    required this.blockSize,
+    required this.fileSize,
+    required this.blockHashes,
+  }) {
+    if (blockSize <= 0 ||
+        fileSize < 0 ||
+        blockHashes.length != (fileSize + blockSize - 1) ~/ blockSize) {
+      throw ArgumentError('The block hashes do not match the file size');
+    }
+  }
+
+  /// Load a manifest saved with [toBytes].
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *bytes* The saved manifest.
+  ///
+  /// **Returns**
+  ///
+  /// * The manifest.
+  ///
+  /// **Throws**
+  ///
+  /// * [FormatException] if the data is not a manifest.
+  factory ContentBlockManifest.fromBytes(final Uint8List bytes) {
+    if (bytes.length < _headerSize) {
+      throw const FormatException('Invalid content block manifest');
+    }
+    final ByteData data = ByteData.sublistView(bytes);
+    final int blockSize = data.getUint32(4);
+    final int fileSize = _getUint64(data, 8);
+    final int count = data.getUint32(16);
+    if (data.getUint32(0) != _magic ||
+        bytes.length != _headerSize + count * 8) {
+      throw const FormatException('Invalid content block manifest');
+    }
+
+    final List<int> hashes = List<int>.filled(count, 0);
+    for (int i = 0; i < count; i++) {
+      hashes[i] = _getUint64(data, _headerSize + i * 8);
+    }
+    try {
+      return ContentBlockManifest(
+        blockSize: blockSize,
+        fileSize: fileSize,
+        blockHashes: hashes,
+      );
+    } on ArgumentError {
+      throw const FormatException('Invalid content block manifest');
+    }
+  }
+
+  /// Compute the manifest of a file.
+  ///
+  /// Used by update servers, or their local stand-ins, to publish the manifest of a new content version.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *path* The path of the file.
+  /// * **IN** *blockSize* The size of a block in bytes.
+  ///
+  /// **Returns**
+  ///
+  /// * The manifest of the file.
+  ///
+  /// **Throws**
+  ///
+  /// * [FileSystemException] if the file cannot be read.
+  static Future<ContentBlockManifest> fromFile(
+    final String path, {
+    final int blockSize = 64 * 1024,
+  }) async {
+    final RandomAccessFile file = await File(path).open();
+    try {
+      final int fileSize = await file.length();
+      final int count = (fileSize + blockSize - 1) ~/ blockSize;
+      final List<int> hashes = List<int>.filled(count, 0);
+      final Uint8List buffer = Uint8List(blockSize);
+      for (int i = 0; i < count; i++) {
+        final int read = await readFully(file, buffer);
+        hashes[i] = hashBlock(Uint8List.sublistView(buffer, 0, read));
+      }
+      return ContentBlockManifest(
+        blockSize: blockSize,
+        fileSize: fileSize,
+        blockHashes: hashes,
+      );
+    } finally {
+      await file.close();
+    }
+  }
+
+  /// The size of a block in bytes.
+  final int blockSize;
+
+  /// The size of the file in bytes.
+  final int fileSize;
+
+  /// The hash of each block.
+  final List<int> blockHashes;
+
+  /// Number of blocks.
+  int get blockCount => blockHashes.length;
+
+  /// Get the size of a block in bytes.
+  int blockLength(final int index) =>
+      min(blockSize, fileSize - index * blockSize);
+
+  /// Save the manifest.
+  ///
+  /// **Returns**
+  ///
+  /// * The saved manifest, to be loaded with [ContentBlockManifest.fromBytes].
+  Uint8List toBytes() {
+    final ByteData data = ByteData(_headerSize + blockCount * 8)
+      ..setUint32(0, _magic)
+      ..setUint32(4, blockSize)
+      ..setUint32(16, blockCount);
+    _setUint64(data, 8, fileSize);
+    for (int i = 0; i < blockCount; i++) {
+      _setUint64(data, _headerSize + i * 8, blockHashes[i]);
+    }
+    return data.buffer.asUint8List();
+  }
+
+  /// Compute the hash of a block.
+  ///
+  /// Two 32 bit FNV-1a hashes, over the block bytes in forward and reverse order, combined in 53 bits so that the hash is exact on all platforms.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *block* The block data.
+  ///
+  /// **Returns**
+  ///
+  /// * The hash of the block.
+  static int hashBlock(final Uint8List block) {
+    final int length = block.length;
+    int low = _fnvBasis;
+    int high = (_fnvBasis ^ length) & 0xFFFFFFFF;
+    for (int i = 0; i < length; i++) {
+      low = _fnvMultiply(low ^ block[i]);
+      high = _fnvMultiply(high ^ block[length - 1 - i]);
+    }
+    return (high & 0x1FFFFF) * 0x100000000 + low;
+  }
+
+  /// Read from the current position of a file until the buffer is full or the end of the file is reached.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *file* The file.
+  /// * **OUT** *buffer* Receives the data.
+  ///
+  /// **Returns**
+  ///
+  /// * The number of bytes read. Less than the buffer length only at the end of the file.
+  ///
+  /// **Throws**
+  ///
+  /// * [FileSystemException] if the file cannot be read.
+  static Future<int> readFully(
+    final RandomAccessFile file,
+    final Uint8List buffer,
+  ) async {
+    int total = 0;
+    while (total < buffer.length) {
+      final int read = await file.readInto(buffer, total);
+      if (read == 0) {
+        break;
+      }
+      total += read;
+    }
+    return total;
+  }
+
+  // 32 bit multiplication by the FNV prime 2^24 + 0x193, split so that no
+  // intermediate value exceeds 53 bits
+  static int _fnvMultiply(final int hash) =>
+      (((hash & 0xFF) << 24) + hash * 0x193) & 0xFFFFFFFF;
+
+  // 64 bit ByteData accessors are not supported on the web
+  static int _getUint64(final ByteData data, final int offset) =>
+      data.getUint32(offset) * 0x100000000 + data.getUint32(offset + 4);
+
+  static void _setUint64(
+    final ByteData data,
+    final int offset,
+    final int value,
+  ) {
+    data
+      ..setUint32(offset, value ~/ 0x100000000)
+      ..setUint32(offset + 4, value % 0x100000000);
+  }
+
+  static const int _fnvBasis = 0x811C9DC5;
+
+  static const int _magic = 0x43424D46;
+  static const int _headerSize = 20;
+}
+
+/// Provides the delta updates of content files. Implemented on top of an update server, or of a local stand-in.
+///
+/// {@category Content}
+abstract class ContentDeltaSource {
+  /// Get the manifest of a content version.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *itemId* The [ContentStoreItem.id] of the content.
+  /// * **IN** *version* The version of the content.
+  ///
+  /// **Returns**
+  ///
+  /// * The manifest, or null if no delta update is available for this content.
+  Future<ContentBlockManifest?> getManifest(
+    final int itemId,
+    final Version version,
+  );
+
+  /// Get blocks of a content version.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *itemId* The [ContentStoreItem.id] of the content.
+  /// * **IN** *version* The version of the content.
+  /// * **IN** *blocks* The indexes of the blocks, in increasing order.
+  ///
+  /// **Returns**
+  ///
+  /// * The data of the blocks, concatenated in the order of [blocks].
+  Future<Uint8List> getBlocks(
+    final int itemId,
+    final Version version,
+    final List<int> blocks,
+  );
+}
+
+/// Result of a delta update
+///
+/// {@category Content}
+class ContentDeltaStatistics {
+  /// Number of bytes downloaded.
+  int downloadedBytes = 0;
+
+  /// Number of bytes a full update of the same items would have downloaded.
+  int fullUpdateBytes = 0;
+
+  /// Number of blocks downloaded.
+  int changedBlocks = 0;
+
+  /// Number of blocks in the updated files.
+  int totalBlocks = 0;
+
+  /// The ids of the items updated with a delta.
+  final List<int> updatedItems = <int>[];
+
+  /// The ids of the items which could not be updated with a delta and need a full update.
+  final List<int> failedItems = <int>[];
+
+  /// Number of bytes saved compared to a full update, by id of the items updated with a delta.
+  ///
+  /// The items downloaded again in full by the content updater are removed.
+  final Map<int, int> savedBytesByItem = <int, int>{};
+
+  /// Number of bytes saved compared to a full update, counting only the items whose full download was skipped.
+  int get savedBytes => savedBytesByItem.values
+      .fold(0, (final int total, final int bytes) => total + bytes);
+}
+
+/// Applies delta updates to content files.
+///
+/// Only the blocks which differ from the local file are downloaded.
+/// The new file is written next to the local one and verified block by block before replacing it, so the local file is kept if anything fails.
+///
+/// {@category Content}
+class ContentDeltaUpdater {
+  /// Create an updater.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *source* Provides the manifests and the blocks.
+  /// * **IN** *maxBlocksPerRequest* The maximum number of blocks requested at once from the source.
+  ContentDeltaUpdater(this.source, {this.maxBlocksPerRequest = 64});
+
+  /// Provides the manifests and the blocks.
+  final ContentDeltaSource source;
+
+  /// The maximum number of blocks requested at once from the source.
+  final int maxBlocksPerRequest;
+
+  /// Update content store items.
+  ///
+  /// The items must not be in use by a map or a routing operation. [ContentStore.refresh] is called if any item was updated.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *items* The items to update, with an update available.
+  /// * **IN** *onProgressUpdated* Called with the progress, between 0 and 100.
+  ///
+  /// **Returns**
+  ///
+  /// * The statistics of the update. The items listed in [ContentDeltaStatistics.failedItems] need a full update.
+  Future<ContentDeltaStatistics> updateItems(
+    final List<ContentStoreItem> items, {
+    final void Function(int progress)? onProgressUpdated,
+  }) async {
+    final ContentDeltaStatistics statistics = ContentDeltaStatistics();
+    for (int i = 0; i < items.length; i++) {
+      final ContentStoreItem item = items[i];
+      final Version version = item.updateVersion;
+      final String path = item.fileName;
+
+      GemError error = GemError.notSupported;
+      if (item.isUpdatable && path.isNotEmpty) {
+        final ContentDeltaStatistics itemStatistics = ContentDeltaStatistics();
+        error = await updateFile(path, item.id, version, itemStatistics);
+        if (error == GemError.success) {
+          statistics
+            ..downloadedBytes += itemStatistics.downloadedBytes
+            ..fullUpdateBytes += item.updateSize
+            ..changedBlocks += itemStatistics.changedBlocks
+            ..totalBlocks += itemStatistics.totalBlocks
+            ..savedBytesByItem[item.id] =
+                max(item.updateSize - itemStatistics.downloadedBytes, 0);
+        }
+      }
+      (error == GemError.success
+              ? statistics.updatedItems
+              : statistics.failedItems)
+          .add(item.id);
+      onProgressUpdated?.call((i + 1) * 100 ~/ items.length);
+    }
+
+    if (statistics.updatedItems.isNotEmpty) {
+      ContentStore.refresh();
+    }
+    return statistics;
+  }
+
+  /// Update a content file.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *path* The path of the local file.
+  /// * **IN** *itemId* The id of the content, passed to the [source].
+  /// * **IN** *version* The new version, passed to the [source].
+  /// * **OUT** *statistics* Receives the downloaded bytes and blocks.
+  ///
+  /// **Returns**
+  ///
+  /// * [GemError.success] on success. The file is replaced.
+  /// * [GemError.notSupported] if the source has no delta for this content.
+  /// * [GemError.invalidInput] if the received blocks do not match the manifest.
+  /// * [GemError.networkFailed] if the source failed.
+  /// * [GemError.io] if a file system error occurred.
+  ///
+  /// The local file is left unchanged on error.
+  Future<GemError> updateFile(
+    final String path,
+    final int itemId,
+    final Version version,
+    final ContentDeltaStatistics statistics,
+  ) async {
+    final ContentBlockManifest? manifest;
+    try {
+      manifest = await source.getManifest(itemId, version);
+    } catch (_) {
+      return GemError.networkFailed;
+    }
+    if (manifest == null) {
+      return GemError.notSupported;
+    }
+
+    final File local = File(path);
+    final File staged = File('$path.delta');
+    final File backup = File('$path.bak');
+    RandomAccessFile? input;
+    RandomAccessFile? output;
+    try {
+      input = await local.open();
+      final List<int> changed = await _changedBlocks(input, manifest);
+      statistics
+        ..changedBlocks += changed.length
+        ..totalBlocks += manifest.blockCount;
+
+      output = await staged.open(mode: FileMode.write);
+      final GemError error = await _writeBlocks(
+        input,
+        output,
+        manifest,
+        changed,
+        itemId,
+        version,
+        statistics,
+      );
+      await output.close();
+      output = null;
+      await input.close();
+      input = null;
+      if (error != GemError.success) {
+        await staged.delete();
+        return error;
+      }
+
+      if (!await _verify(staged, manifest)) {
+        await staged.delete();
+        return GemError.invalidInput;
+      }
+
+      await local.rename(backup.path);
+      try {
+        await staged.rename(path);
+      } catch (_) {
+        await backup.rename(path);
+        rethrow;
+      }
+      try {
+        await backup.delete();
+      } on FileSystemException {
+        // The file is already updated, a leftover backup is replaced by the
+        // next update
+      }
+      return GemError.success;
+    } on FileSystemException {
+      await output?.close();
+      await input?.close();
+      if (await staged.exists()) {
+        await staged.delete();
+      }
+      return GemError.io;
+    }
+  }
+
+  Future<List<int>> _changedBlocks(
+    final RandomAccessFile input,
+    final ContentBlockManifest manifest,
+  ) async {
+    final int localSize = await input.length();
+    final Uint8List buffer = Uint8List(manifest.blockSize);
+    final List<int> changed = <int>[];
+    for (int i = 0; i < manifest.blockCount; i++) {
+      final int length = manifest.blockLength(i);
+      final int offset = i * manifest.blockSize;
+      if (offset + length > localSize) {
+        changed.add(i);
+        continue;
+      }
+      await input.setPosition(offset);
+      final Uint8List block = Uint8List.sublistView(buffer, 0, length);
+      final int read = await ContentBlockManifest.readFully(input, block);
+      if (read != length ||
+          ContentBlockManifest.hashBlock(block) != manifest.blockHashes[i]) {
+        changed.add(i);
+      }
+    }
+    return changed;
+  }
+
+  Future<GemError> _writeBlocks(
+    final RandomAccessFile input,
+    final RandomAccessFile output,
+    final ContentBlockManifest manifest,
+    final List<int> changed,
+    final int itemId,
+    final Version version,
+    final ContentDeltaStatistics statistics,
+  ) async {
+    final Uint8List buffer = Uint8List(manifest.blockSize);
+    int next = 0;
+    Uint8List batch = Uint8List(0);
+    int batchOffset = 0;
+
+    for (int i = 0; i < manifest.blockCount; i++) {
+      final int length = manifest.blockLength(i);
+      if (next < changed.length && changed[next] == i) {
+        if (batchOffset == batch.length) {
+          final List<int> blocks = changed.sublist(
+            next,
+            min(next + maxBlocksPerRequest, changed.length),
+          );
+          try {
+            batch = await source.getBlocks(itemId, version, blocks);
+          } catch (_) {
+            return GemError.networkFailed;
+          }
+          batchOffset = 0;
+          statistics.downloadedBytes += batch.length;
+        }
+        if (batchOffset + length > batch.length) {
+          return GemError.invalidInput;
+        }
+        final Uint8List block =
+            Uint8List.sublistView(batch, batchOffset, batchOffset + length);
+        if (ContentBlockManifest.hashBlock(block) != manifest.blockHashes[i]) {
+          return GemError.invalidInput;
+        }
+        await output.writeFrom(block);
+        batchOffset += length;
+        next++;
+      } else {
+        await input.setPosition(i * manifest.blockSize);
+        final Uint8List block = Uint8List.sublistView(buffer, 0, length);
+        final int read = await ContentBlockManifest.readFully(input, block);
+        if (read != length) {
+          throw FileSystemException('Unexpected end of file', input.path);
+        }
+        await output.writeFrom(block);
+      }
+    }
+    return GemError.success;
+  }
+
+  Future<bool> _verify(
+    final File staged,
+    final ContentBlockManifest manifest,
+  ) async {
+    final ContentBlockManifest written = await ContentBlockManifest.fromFile(
+      staged.path,
+      blockSize: manifest.blockSize,
+    );
+    if (written.fileSize != manifest.fileSize) {
+      return false;
+    }
+    for (int i = 0; i < manifest.blockCount; i++) {
+      if (written.blockHashes[i] != manifest.blockHashes[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
@@ -0,0 +1,579 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:math';
+
+import 'package:gem_kit/src/contentstore/content_store.dart';
+import 'package:gem_kit/src/contentstore/content_store_item.dart';
+import 'package:gem_kit/src/core/gem_error.dart';
+import 'package:gem_kit/src/core/progress_listener.dart';
+
+/// Priority of a download in a [ContentDownloadScheduler] queue
+///
+/// {@category Content}
+enum ContentDownloadPriority {
+  /// Started before all the other queued downloads
+  high,
+
+  /// Default priority
+  normal,
+
+  /// Started after all the other queued downloads
+  low,
+}
+
+/// Something that can be downloaded by a [ContentDownloadScheduler].
+///
+/// Use [ContentDownloadTarget.item] for content store items. Other implementations can be used to run the scheduler against a local HTTP server.
+///
+/// {@category Content}
+abstract class ContentDownloadTarget {
+  /// Create a target downloading a content store item.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *item* The content store item.
+  factory ContentDownloadTarget.item(final ContentStoreItem item) =
+      _ContentStoreItemTarget;
+
+  /// Unique id of the target.
+  int get id;
+
+  /// Size of the whole content in bytes.
+  int get totalSize;
+
+  /// Size of the content already downloaded in bytes.
+  int get downloadedSize;
+
+  /// Check if the content is completely downloaded.
+  bool get isCompleted;
+
+  /// Start or resume the download.
+  ///
+  /// The data already downloaded must be kept and the download must continue from there.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *onComplete* Called when the download ends. [GemError.success] on success.
+  /// * **IN** *onProgress* Called with the download progress, between 0 and 100.
+  /// * **IN** *allowChargedNetworks* Allow downloading on charged networks.
+  /// * **IN** *priority* The priority of the download threads.
+  void start({
+    required final void Function(GemError error) onComplete,
+    required final void Function(int progress) onProgress,
+    required final bool allowChargedNetworks,
+    required final ContentDownloadThreadPriority priority,
+  });
+
+  /// Pause the download, keeping the data already downloaded.
+  GemError pause();
+
+  /// Cancel the download, deleting the data already downloaded.
+  GemError cancel();
+}
+
+class _ContentStoreItemTarget implements ContentDownloadTarget {
+  _ContentStoreItemTarget(this.item);
+
+  final ContentStoreItem item;
+  ProgressListener? _listener;
+
+  @override
+  int get id => item.id;
+
+  @override
+  int get totalSize => item.totalSize;
+
+  @override
+  int get downloadedSize => item.availableSize;
+
+  @override
+  bool get isCompleted => item.isCompleted;
+
+  @override
+  void start({
+    required final void Function(GemError error) onComplete,
+    required final void Function(int progress) onProgress,
+    required final bool allowChargedNetworks,
+    required final ContentDownloadThreadPriority priority,
+  }) {
+    _listener = item.asyncDownload(
+      (final GemError error) {
+        _listener = null;
+        onComplete(error);
+      },
+      onProgressCallback: onProgress,
+      allowChargedNetworks: allowChargedNetworks,
+      priority: priority,
+    );
+  }
+
+  @override
+  GemError pause() {
+    _listener = null;
+    return item.pauseDownload();
+  }
+
+  @override
+  GemError cancel() {
+    final ProgressListener? listener = _listener;
+    _listener = null;
+    if (listener != null) {
+      ContentStore.cancel(listener);
+    }
+    return item.cancelDownload();
+  }
+}
+
+/// Statistics about a download of a [ContentDownloadScheduler]
+///
+/// {@category Content}
+class ContentDownloadStatistics {
+  ContentDownloadStatistics._(this.id, this.priority);
+
+  /// The id of the [ContentDownloadTarget].
+  final int id;
+
+  /// The queue priority of the download.
+  ContentDownloadPriority priority;
+
+  /// Size of the content in bytes.
+  int totalSize = 0;
+
+  /// Size of the content already downloaded in bytes.
+  int downloadedSize = 0;
+
+  /// Size of the content downloaded since the download was enqueued, in bytes.
+  int transferredSize = 0;
+
+  /// Recent download speed in bytes per second.
+  double bytesPerSecond = 0;
+
+  /// Number of times the download was resumed after a network error.
+  int retryCount = 0;
+
+  /// Time spent downloading, excluding the time spent in the queue.
+  Duration activeTime = Duration.zero;
+
+  /// Check if the download is running.
+  bool isActive = false;
+
+  /// The last error of the download. [GemError.success] if there was no error.
+  GemError lastError = GemError.success;
+
+  /// Estimated time until the download is completed. Null if the speed is not known yet.
+  Duration? get estimatedTimeLeft {
+    if (bytesPerSecond <= 0) {
+      return null;
+    }
+    final int left = max(totalSize - downloadedSize, 0);
+    return Duration(milliseconds: (left * 1000 / bytesPerSecond).round());
+  }
+
+  /// Average download speed in bytes per second since the download was enqueued.
+  double get averageBytesPerSecond => activeTime.inMilliseconds == 0
+      ? 0
+      : transferredSize * 1000 / activeTime.inMilliseconds;
+}
+
+/// Download scheduler for content store items and other [ContentDownloadTarget]s.
+///
+/// Downloads are started in priority order, at most [maxParallelDownloads] at a time.
+/// Downloads interrupted by network errors are resumed from the data already downloaded after a delay growing with each retry.
+/// Statistics including speed and estimated time left are kept for each download.
+///
+/// The chunking of each download is done by the SDK. [ContentStore.setParallelDownloadsLimit] should not be lower than [maxParallelDownloads].
+///
+/// {@category Content}
+class ContentDownloadScheduler {
+  /// Create a scheduler.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *maxParallelDownloads* The maximum number of downloads running at the same time.
+  /// * **IN** *maxRetries* The maximum number of times a download is resumed after a network error before it fails.
+  /// * **IN** *retryDelay* The delay before the first retry. Doubled with each retry.
+  /// * **IN** *maxRetryDelay* The maximum delay before a retry.
+  /// * **IN** *allowChargedNetworks* Allow downloading on charged networks.
+  ContentDownloadScheduler({
+    this.maxParallelDownloads = 2,
+    this.maxRetries = 5,
+    this.retryDelay = const Duration(seconds: 2),
+    this.maxRetryDelay = const Duration(minutes: 1),
+    this.allowChargedNetworks = false,
+  }) : assert(maxParallelDownloads > 0, 'At least one download must run');
+
+  /// The maximum number of downloads running at the same time.
+  final int maxParallelDownloads;
+
+  /// The maximum number of times a download is resumed after a network error before it fails.
+  final int maxRetries;
+
+  /// The delay before the first retry.
+  final Duration retryDelay;
+
+  /// The maximum delay before a retry.
+  final Duration maxRetryDelay;
+
+  /// Allow downloading on charged networks.
+  final bool allowChargedNetworks;
+
+  final Map<ContentDownloadPriority, ListQueue<_Download>> _queues =
+      <ContentDownloadPriority, ListQueue<_Download>>{
+    for (final ContentDownloadPriority priority
+        in ContentDownloadPriority.values)
+      priority: ListQueue<_Download>(),
+  };
+  final Map<int, _Download> _downloads = <int, _Download>{};
+  int _activeCount = 0;
+  bool _isPaused = false;
+
+  /// Number of downloads running.
+  int get activeCount => _activeCount;
+
+  /// Number of downloads waiting to be started.
+  int get queuedCount {
+    int count = 0;
+    for (final ListQueue<_Download> queue in _queues.values) {
+      count += queue.length;
+    }
+    return count;
+  }
+
+  /// Check if the scheduler is paused.
+  bool get isPaused => _isPaused;
+
+  /// Add a download.
+  ///
+  /// If the target is already scheduled, only its priority and callbacks are updated.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *target* The content to download.
+  /// * **IN** *priority* The queue priority.
+  /// * **IN** *onComplete* Called when the download ends. [GemError.success] on success.
+  /// * **IN** *onStatisticsUpdated* Called when the statistics of the download change.
+  void enqueue(
+    final ContentDownloadTarget target, {
+    final ContentDownloadPriority priority = ContentDownloadPriority.normal,
+    final void Function(GemError error)? onComplete,
+    final void Function(ContentDownloadStatistics statistics)?
+        onStatisticsUpdated,
+  }) {
+    final _Download? existing = _downloads[target.id];
+    if (existing != null) {
+      existing
+        ..onComplete = onComplete
+        ..onStatisticsUpdated = onStatisticsUpdated;
+      setPriority(target.id, priority);
+      return;
+    }
+
+    if (target.isCompleted) {
+      onComplete?.call(GemError.success);
+      return;
+    }
+
+    final _Download download = _Download(
+      target,
+      ContentDownloadStatistics._(target.id, priority)
+        ..totalSize = target.totalSize
+        ..downloadedSize = target.downloadedSize,
+    )
+      ..onComplete = onComplete
+      ..onStatisticsUpdated = onStatisticsUpdated;
+    _downloads[target.id] = download;
+    _queues[priority]!.addLast(download);
+    _schedule();
+  }
+
+  /// Change the priority of a download.
+  ///
+  /// A running download keeps running. A queued download is moved to the end of its new queue.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *id* The id of the target.
+  /// * **IN** *priority* The new priority.
+  ///
+  /// **Returns**
+  ///
+  /// * True if the download is scheduled, false otherwise.
+  bool setPriority(final int id, final ContentDownloadPriority priority) {
+    final _Download? download = _downloads[id];
+    if (download == null) {
+      return false;
+    }
+    final ContentDownloadPriority previous = download.statistics.priority;
+    download.statistics.priority = priority;
+    if (_queues[previous]!.remove(download)) {
+      _queues[priority]!.addLast(download);
+      _schedule();
+    }
+    return true;
+  }
+
+  /// Remove a download.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *id* The id of the target.
+  /// * **IN** *deleteData* Delete the data already downloaded. If false, the download can be resumed later.
+  ///
+  /// **Returns**
+  ///
+  /// * True if the download was scheduled, false otherwise.
+  bool remove(final int id, {final bool deleteData = false}) {
+    final _Download? download = _downloads.remove(id);
+    if (download == null) {
+      return false;
+    }
+    _queues[download.statistics.priority]!.remove(download);
+    download.retryTimer?.cancel();
+    if (download.statistics.isActive || deleteData) {
+      _stop(download, deleteData: deleteData);
+    }
+    _schedule();
+    return true;
+  }
+
+  /// Pause all the running downloads, keeping their data. They are resumed by [resume].
+  void pause() {
+    if (_isPaused) {
+      return;
+    }
+    _isPaused = true;
+    for (final _Download download in _downloads.values) {
+      if (download.statistics.isActive) {
+        _stop(download, deleteData: false);
+        _queues[download.statistics.priority]!.addFirst(download);
+      }
+    }
+  }
+
+  /// Resume the downloads paused by [pause].
+  void resume() {
+    _isPaused = false;
+    _schedule();
+  }
+
+  /// Get the statistics of a download.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *id* The id of the target.
+  ///
+  /// **Returns**
+  ///
+  /// * The statistics if the download is scheduled, null otherwise.
+  ContentDownloadStatistics? statisticsOf(final int id) =>
+      _downloads[id]?.statistics;
+
+  /// Get the statistics of all the scheduled downloads.
+  List<ContentDownloadStatistics> get statistics => _downloads.values
+      .map((final _Download download) => download.statistics)
+      .toList();
+
+  /// Pause all the downloads and forget them.
+  void dispose() {
+    pause();
+    for (final _Download download in _downloads.values) {
+      download.retryTimer?.cancel();
+    }
+    _downloads.clear();
+    for (final ListQueue<_Download> queue in _queues.values) {
+      queue.clear();
+    }
+  }
+
+  void _schedule() {
+    while (!_isPaused && _activeCount < maxParallelDownloads) {
+      final _Download? next = _dequeue();
+      if (next == null) {
+        return;
+      }
+      _start(next);
+    }
+  }
+
+  _Download? _dequeue() {
+    for (final ContentDownloadPriority priority
+        in ContentDownloadPriority.values) {
+      final ListQueue<_Download> queue = _queues[priority]!;
+      if (queue.isNotEmpty) {
+        return queue.removeFirst();
+      }
+    }
+    return null;
+  }
+
+  void _start(final _Download download) {
+    final ContentDownloadStatistics statistics = download.statistics;
+    final int generation = ++download.generation;
+    statistics
+      ..isActive = true
+      ..bytesPerSecond = 0;
+    download.stopwatch.start();
+    download.lastSampleSize = statistics.downloadedSize;
+    download.lastSampleTime = download.stopwatch.elapsedMilliseconds;
+    _activeCount++;
+
+    download.target.start(
+      onComplete: (final GemError error) {
+        if (download.generation == generation && statistics.isActive) {
+          _onComplete(download, error);
+        }
+      },
+      onProgress: (final int progress) {
+        if (download.generation == generation && statistics.isActive) {
+          _onProgress(download);
+        }
+      },
+      allowChargedNetworks: allowChargedNetworks,
+      priority: _threadPriority(statistics.priority),
+    );
+  }
+
+  void _stop(final _Download download, {required final bool deleteData}) {
+    final ContentDownloadStatistics statistics = download.statistics;
+    if (statistics.isActive) {
+      statistics.isActive = false;
+      download.stopwatch.stop();
+      statistics.activeTime = download.stopwatch.elapsed;
+      _activeCount--;
+    }
+    download.generation++;
+    if (deleteData) {
+      download.target.cancel();
+    } else {
+      download.target.pause();
+    }
+  }
+
+  void _onProgress(final _Download download) {
+    final ContentDownloadStatistics statistics = download.statistics;
+    final int size = download.target.downloadedSize;
+    final int now = download.stopwatch.elapsedMilliseconds;
+    final int elapsed = now - download.lastSampleTime;
+
+    statistics
+      ..transferredSize += max(size - statistics.downloadedSize, 0)
+      ..downloadedSize = size
+      ..activeTime = download.stopwatch.elapsed;
+
+    // Average the speed over at least half a second to smooth out bursts
+    if (elapsed >= 500) {
+      final double speed = (size - download.lastSampleSize) * 1000 / elapsed;
+      statistics.bytesPerSecond = statistics.bytesPerSecond == 0
+          ? speed
+          : statistics.bytesPerSecond * 0.7 + speed * 0.3;
+      download
+        ..lastSampleSize = size
+        ..lastSampleTime = now;
+    }
+
+    download.onStatisticsUpdated?.call(statistics);
+  }
+
+  void _onComplete(final _Download download, final GemError error) {
+    final ContentDownloadStatistics statistics = download.statistics;
+    statistics
+      ..isActive = false
+      ..lastError = error
+      ..activeTime = download.stopwatch.elapsed;
+    download.stopwatch.stop();
+    _activeCount--;
+
+    if (error == GemError.success) {
+      statistics
+        ..transferredSize +=
+            max(statistics.totalSize - statistics.downloadedSize, 0)
+        ..downloadedSize = statistics.totalSize
+        ..bytesPerSecond = 0;
+      _finish(download, error);
+    } else if (_isRetryable(error) && statistics.retryCount < maxRetries) {
+      final int delay = min(
+        retryDelay.inMilliseconds * (1 << statistics.retryCount),
+        maxRetryDelay.inMilliseconds,
+      );
+      statistics.retryCount++;
+      download.onStatisticsUpdated?.call(statistics);
+      download.retryTimer = Timer(Duration(milliseconds: delay), () {
+        download.retryTimer = null;
+        if (_downloads[download.target.id] == download) {
+          _queues[statistics.priority]!.addFirst(download);
+          _schedule();
+        }
+      });
+    } else {
+      _finish(download, error);
+    }
+
+    _schedule();
+  }
+
+  void _finish(final _Download download, final GemError error) {
+    _downloads.remove(download.target.id);
+    download.onStatisticsUpdated?.call(download.statistics);
+    download.onComplete?.call(error);
+  }
+
+  static bool _isRetryable(final GemError error) {
+    switch (error) {
+      case GemError.connection:
+      case GemError.networkFailed:
+      case GemError.noConnection:
+      case GemError.connectionRequired:
+      case GemError.sendFailed:
+      case GemError.recvFailed:
+      case GemError.networkTimeout:
+      case GemError.networkCouldntResolveHost:
+      case GemError.networkCouldntResolveProxy:
+      case GemError.networkCouldntResume:
+      case GemError.operationTimeout:
+      case GemError.suspended:
+      case GemError.busy:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  static ContentDownloadThreadPriority _threadPriority(
+    final ContentDownloadPriority priority,
+  ) {
+    switch (priority) {
+      case ContentDownloadPriority.high:
+        return ContentDownloadThreadPriority.highPriority;
+      case ContentDownloadPriority.normal:
+        return ContentDownloadThreadPriority.defaultPriority;
+      case ContentDownloadPriority.low:
+        return ContentDownloadThreadPriority.lowPriority;
+    }
+  }
+}
+
+class _Download {
+  _Download(this.target, this.statistics);
+
+  final ContentDownloadTarget target;
+  final ContentDownloadStatistics statistics;
+  final Stopwatch stopwatch = Stopwatch();
+  void Function(GemError error)? onComplete;
+  void Function(ContentDownloadStatistics statistics)? onStatisticsUpdated;
+  Timer? retryTimer;
+
+  /// Incremented each time the download is started or stopped, to ignore the notifications of a previous start
+  int generation = 0;
+  int lastSampleSize = 0;
+  int lastSampleTime = 0;
+}
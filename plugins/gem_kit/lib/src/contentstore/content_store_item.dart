@@ -8,8 +8,6 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
-
 import 'package:flutter/services.dart';
 import 'package:gem_kit/src/contentstore/content_store_item_status.dart';
 import 'package:gem_kit/src/contentstore/content_types.dart';
@@ -139,7 +137,7 @@ class ContentStoreItem extends GemAutoreleaseObject {
 
   @internal
   ContentStoreItem.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'ContentStoreItem');
   }
   final int _pointerId;
   int get pointerId => _pointerId;
@@ -700,14 +698,7 @@ class ContentStoreItem extends GemAutoreleaseObject {
     return Version.fromJson(resultString['result']);
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'ContentStoreItem',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('ContentStoreItem', _pointerId);
 
   /// Asynchronous start/resume the download of the content store product content.
   ///
@@ -8,8 +8,7 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
-
+import 'package:gem_kit/src/contentstore/content_delta_update.dart';
 import 'package:gem_kit/src/contentstore/content_store_item.dart';
 import 'package:gem_kit/src/contentstore/content_types.dart';
 import 'package:gem_kit/src/contentstore/content_updater_status.dart';
@@ -36,7 +35,7 @@ class ContentUpdater extends GemAutoreleaseObject {
   ContentUpdater.init(final int id, final int mapId)
       : _pointerId = id,
         _mapId = mapId {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'ContentUpdater');
   }
   final int _pointerId;
   final int _mapId;
@@ -46,6 +45,10 @@ class ContentUpdater extends GemAutoreleaseObject {
 
   /// Start / resume the update process.
   ///
+  /// The SDK update always runs, so that it records the new versions of the items.
+  /// The items updated by [updateWithDeltas] are already at the new version and are not downloaded again, unless the SDK still reports them as updatable.
+  /// Those items are removed from [ContentDeltaStatistics.savedBytesByItem], and [deltaStatistics] is reset for the next run.
+  ///
   /// **Parameters**
   ///
   /// * **IN** *allowChargeNetwork*	Allow charging network
@@ -72,6 +75,19 @@ class ContentUpdater extends GemAutoreleaseObject {
     final void Function(int progress)? onProgressUpdated,
     final void Function(GemError error)? onCompleteCallback,
   }) {
+    final ContentDeltaStatistics? deltaStatistics = _deltaStatistics;
+    _deltaStatistics = null;
+    if (deltaStatistics != null) {
+      // Items downloaded again in full saved nothing
+      final Set<int> updatable = <int>{
+        for (final ContentStoreItem item in items)
+          if (item.isUpdatable) item.id,
+      };
+      deltaStatistics.savedBytesByItem.removeWhere(
+        (final int id, final int _) => updatable.contains(id),
+      );
+    }
+
     final EventDrivenProgressListener progressListener =
         EventDrivenProgressListener();
 
@@ -121,6 +137,45 @@ class ContentUpdater extends GemAutoreleaseObject {
     return progressListener;
   }
 
+  /// Update the items with delta updates, downloading only the changed blocks of each content file.
+  ///
+  /// Must be called before [update]. The items which cannot be updated with a delta are listed in [ContentDeltaStatistics.failedItems].
+  /// Call [update] afterwards to update them and to record the new versions in the SDK.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *source* Provides the manifests and the blocks of the new versions.
+  /// * **IN** *onProgressUpdated* Called with the progress, between 0 and 100.
+  ///
+  /// **Returns**
+  ///
+  /// * The statistics of the delta update, including the bytes saved compared to a full update.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  Future<ContentDeltaStatistics> updateWithDeltas(
+    final ContentDeltaSource source, {
+    final void Function(int progress)? onProgressUpdated,
+  }) async {
+    final ContentDeltaStatistics statistics =
+        await ContentDeltaUpdater(source).updateItems(
+      items,
+      onProgressUpdated: onProgressUpdated,
+    );
+    _deltaStatistics = statistics;
+    return statistics;
+  }
+
+  /// Get the statistics of the last [updateWithDeltas] call.
+  ///
+  /// **Returns**
+  ///
+  /// * The statistics, or null if [updateWithDeltas] was not called since the last [update].
+  ContentDeltaStatistics? get deltaStatistics => _deltaStatistics;
+
+  ContentDeltaStatistics? _deltaStatistics;
+
   /// Get the content items list in update process.
   ///
   /// **Returns**
@@ -268,8 +323,5 @@ class ContentUpdater extends GemAutoreleaseObject {
     return resultString['result'];
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(
-            <String, Object>{'class': 'ContentUpdater', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('ContentUpdater', _pointerId);
 }
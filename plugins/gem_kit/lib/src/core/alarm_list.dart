@@ -8,13 +8,10 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
-
 import 'package:gem_kit/core.dart';
 import 'package:gem_kit/map.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/core/lists.dart';
-import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:meta/meta.dart';
 
 /// Geographic coordinates referenced list of item alarms.
@@ -77,7 +74,10 @@ class OverlayItemAlarmsList extends GemAutoreleaseObject
     implements AlarmsList<OverlayItemPosition> {
   @internal
   OverlayItemAlarmsList.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'OverlayItemAlarmsList',
+    );
   }
   final int _pointerId;
 
@@ -131,14 +131,7 @@ class OverlayItemAlarmsList extends GemAutoreleaseObject
     return list.toList();
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'OverlayItemAlarmsList',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('OverlayItemAlarmsList', _pointerId);
 }
 
 /// Geographic coordinates referenced list of [Landmark] alarms.
@@ -148,7 +141,10 @@ class LandmarkAlarmsList extends GemAutoreleaseObject
     implements AlarmsList<LandmarkPosition> {
   @internal
   LandmarkAlarmsList.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'LandmarkAlarmsList',
+    );
   }
   final int _pointerId;
 
@@ -202,12 +198,5 @@ class LandmarkAlarmsList extends GemAutoreleaseObject
     return list.toList();
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'LandmarkAlarmsList',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('LandmarkAlarmsList', _pointerId);
 }
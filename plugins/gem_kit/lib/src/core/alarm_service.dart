@@ -39,7 +39,7 @@ class AlarmService extends GemAutoreleaseObject {
 
   @internal
   AlarmService.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'AlarmService');
   }
   final int _pointerId;
 
@@ -629,11 +629,7 @@ class AlarmService extends GemAutoreleaseObject {
     return retVal;
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, dynamic>{'class': 'AlarmService', 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative('AlarmService', _pointerId);
 }
 
 /// Alarm monitored area consisting of a [GeographicArea] and an id.
@@ -0,0 +1,435 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:developer';
+import 'dart:isolate';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/core/debug.dart';
+import 'package:meta/meta.dart';
+
+/// Kind of native bridge call
+///
+/// {@category Core}
+enum BridgeCallKind {
+  /// Object method call
+  method,
+
+  /// Object creation
+  create,
+
+  /// Image rendering
+  image,
+}
+
+/// Statistics of the native bridge calls of one class and method.
+///
+/// Latencies are measured around the native call, excluding the JSON encoding of the arguments and the decoding of the result.
+///
+/// {@category Core}
+class BridgeCallStats {
+  BridgeCallStats({
+    required this.kind,
+    required this.className,
+    required this.method,
+    required this.count,
+    required this.totalLatency,
+    required this.maxLatency,
+    required this.p50Latency,
+    required this.p90Latency,
+    required this.p99Latency,
+    required this.requestBytes,
+    required this.responseBytes,
+    required this.p99ResponseBytes,
+    required this.mainIsolateBlockingTime,
+    required this.slowCallCount,
+  });
+
+  /// The kind of call
+  final BridgeCallKind kind;
+
+  /// The native class name
+  final String className;
+
+  /// The method name. Empty for object creation
+  final String method;
+
+  /// Number of calls
+  final int count;
+
+  /// Total latency
+  final Duration totalLatency;
+
+  /// Maximum latency
+  final Duration maxLatency;
+
+  /// Median latency, within the histogram precision
+  final Duration p50Latency;
+
+  /// 90th percentile latency, within the histogram precision
+  final Duration p90Latency;
+
+  /// 99th percentile latency, within the histogram precision
+  final Duration p99Latency;
+
+  /// Total size of the requests, in UTF-8 encoded bytes
+  final int requestBytes;
+
+  /// Total size of the responses, in UTF-8 encoded bytes, or raw bytes for image buffers
+  final int responseBytes;
+
+  /// 99th percentile response size, in bytes, within the histogram precision
+  final int p99ResponseBytes;
+
+  /// Time the calls blocked the main isolate
+  final Duration mainIsolateBlockingTime;
+
+  /// Number of calls longer than [Debug.bridgeSlowCallThreshold]
+  final int slowCallCount;
+
+  /// Average latency.
+  Duration get averageLatency => count == 0
+      ? Duration.zero
+      : Duration(microseconds: totalLatency.inMicroseconds ~/ count);
+
+  Map<String, dynamic> toJson() {
+    final Map<String, dynamic> json = <String, dynamic>{};
+    json['kind'] = kind.name;
+    json['class'] = className;
+    json['method'] = method;
+    json['count'] = count;
+    json['totalUs'] = totalLatency.inMicroseconds;
+    json['maxUs'] = maxLatency.inMicroseconds;
+    json['p50Us'] = p50Latency.inMicroseconds;
+    json['p90Us'] = p90Latency.inMicroseconds;
+    json['p99Us'] = p99Latency.inMicroseconds;
+    json['requestBytes'] = requestBytes;
+    json['responseBytes'] = responseBytes;
+    json['p99ResponseBytes'] = p99ResponseBytes;
+    json['mainIsolateBlockingUs'] = mainIsolateBlockingTime.inMicroseconds;
+    json['slowCalls'] = slowCallCount;
+    return json;
+  }
+}
+
+/// Snapshot of the native bridge statistics.
+///
+/// {@category Core}
+class BridgeProfile {
+  BridgeProfile({
+    required this.start,
+    required this.end,
+    required this.calls,
+  });
+
+  /// Start of the profiled interval
+  final DateTime start;
+
+  /// End of the profiled interval
+  final DateTime end;
+
+  /// Statistics for each class and method, by decreasing total latency
+  final List<BridgeCallStats> calls;
+
+  /// Total time the calls blocked the main isolate.
+  Duration get mainIsolateBlockingTime => Duration(
+        microseconds: calls.fold(
+          0,
+          (final int sum, final BridgeCallStats stats) =>
+              sum + stats.mainIsolateBlockingTime.inMicroseconds,
+        ),
+      );
+
+  Map<String, dynamic> toJson() {
+    final Map<String, dynamic> json = <String, dynamic>{};
+    json['start'] = start.millisecondsSinceEpoch;
+    json['end'] = end.millisecondsSinceEpoch;
+    json['calls'] =
+        calls.map((final BridgeCallStats stats) => stats.toJson()).toList();
+    return json;
+  }
+}
+
+/// Profiler of the native bridge calls.
+///
+/// Each call updates the preallocated counters and histograms of its class and method. Only the class and method names are allocated.
+/// Histograms use 8 sub-buckets per power of two, so percentiles are within 12.5%.
+@internal
+class BridgeProfiler {
+  BridgeProfiler._();
+
+  static final BridgeProfiler instance = BridgeProfiler._();
+
+  /// Whether the calls are profiled
+  bool isEnabled = true;
+
+  /// Whether a timeline event is emitted for each call, see `dart:developer`
+  bool emitTimelineEvents = false;
+
+  /// Calls longer than this are counted as slow, by default one frame at 60 Hz
+  Duration slowCallThreshold = const Duration(microseconds: 16667);
+
+  final Stopwatch _clock = Stopwatch()..start();
+  final Map<String, Map<String, BridgeCallRecord>> _records =
+      <String, Map<String, BridgeCallRecord>>{};
+  DateTime _start = DateTime.now();
+
+  static final bool _isMainIsolate = Isolate.current.debugName == 'main';
+
+  /// Get the record of an object method call.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *request* The request JSON.
+  ///
+  /// **Returns**
+  ///
+  /// * The record passed to [begin], [stop] and [end].
+  BridgeCallRecord methodRecord(final String request) {
+    // objectMethod encodes {"id":..,"class":"..","method":"..",...}
+    final int classStart = _valueStart(request, '"class":"', 0);
+    final int classEnd =
+        classStart < 0 ? -1 : request.indexOf('"', classStart);
+    final int methodStart =
+        classEnd < 0 ? -1 : _valueStart(request, '"method":"', classEnd);
+    final int methodEnd =
+        methodStart < 0 ? -1 : request.indexOf('"', methodStart);
+    return _recordOf(
+      BridgeCallKind.method,
+      classEnd < 0 ? '?' : request.substring(classStart, classEnd),
+      methodEnd < 0 ? '?' : request.substring(methodStart, methodEnd),
+    );
+  }
+
+  /// Get the record of an object creation.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *request* The request JSON.
+  ///
+  /// **Returns**
+  ///
+  /// * The record passed to [begin], [stop] and [end].
+  BridgeCallRecord createRecord(final String request) {
+    final int classStart = _valueStart(request, '"class":"', 0);
+    final int classEnd =
+        classStart < 0 ? -1 : request.indexOf('"', classStart);
+    return _recordOf(
+      BridgeCallKind.create,
+      classEnd < 0 ? '?' : request.substring(classStart, classEnd),
+      '',
+    );
+  }
+
+  /// Get the record of an image rendering.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *className* The class of the rendered object.
+  ///
+  /// **Returns**
+  ///
+  /// * The record passed to [begin], [stop] and [end].
+  BridgeCallRecord imageRecord(final String className) =>
+      _recordOf(BridgeCallKind.image, className, 'getImage');
+
+  /// Start timing a call.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *record* The call record, or null if the profiler is disabled.
+  ///
+  /// **Returns**
+  ///
+  /// * The start tick, passed to [stop].
+  int begin(final BridgeCallRecord? record) {
+    if (record == null) {
+      return 0;
+    }
+    if (emitTimelineEvents) {
+      Timeline.startSync(record.label);
+    }
+    return _clock.elapsedMicroseconds;
+  }
+
+  /// Stop timing a call. Called right after the native call returns, before decoding the result.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *record* The call record, or null if the profiler is disabled.
+  /// * **IN** *startTick* The value returned by [begin].
+  ///
+  /// **Returns**
+  ///
+  /// * The call latency in microseconds, passed to [end].
+  int stop(final BridgeCallRecord? record, final int startTick) {
+    if (record == null) {
+      return 0;
+    }
+    final int elapsed = _clock.elapsedMicroseconds - startTick;
+    if (emitTimelineEvents) {
+      Timeline.finishSync();
+    }
+    return elapsed;
+  }
+
+  /// Record the end of a call.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *record* The call record, or null if the profiler is disabled.
+  /// * **IN** *elapsed* The value returned by [stop].
+  /// * **IN** *requestLength* The request size, in encoded bytes.
+  /// * **IN** *responseLength* The response size, in encoded bytes.
+  void end(
+    final BridgeCallRecord? record,
+    final int elapsed,
+    final int requestLength,
+    final int responseLength,
+  ) {
+    if (record == null) {
+      return;
+    }
+    record.count++;
+    record.totalMicroseconds += elapsed;
+    record.maxMicroseconds = max(record.maxMicroseconds, elapsed);
+    record.latencies[_bucketOf(elapsed)]++;
+    record.requestBytes += requestLength;
+    record.responseBytes += responseLength;
+    record.responseSizes[_bucketOf(responseLength)]++;
+    if (_isMainIsolate) {
+      record.blockingMicroseconds += elapsed;
+    }
+    if (elapsed >= slowCallThreshold.inMicroseconds) {
+      record.slowCount++;
+    }
+  }
+
+  /// Get the statistics since the last reset.
+  BridgeProfile snapshot() {
+    final List<BridgeCallStats> calls = <BridgeCallStats>[];
+    _records.forEach(
+      (final String className, final Map<String, BridgeCallRecord> methods) {
+        for (final BridgeCallRecord record in methods.values) {
+          calls.add(record._toStats());
+        }
+      },
+    );
+    calls.sort(
+      (final BridgeCallStats a, final BridgeCallStats b) =>
+          b.totalLatency.compareTo(a.totalLatency),
+    );
+    return BridgeProfile(start: _start, end: DateTime.now(), calls: calls);
+  }
+
+  /// Clear the statistics.
+  void reset() {
+    _records.clear();
+    _start = DateTime.now();
+  }
+
+  BridgeCallRecord _recordOf(
+    final BridgeCallKind kind,
+    final String className,
+    final String method,
+  ) =>
+      _records
+          .putIfAbsent(className, () => <String, BridgeCallRecord>{})
+          .putIfAbsent(
+            method,
+            () => BridgeCallRecord._(kind, className, method),
+          );
+
+  static int _valueStart(
+    final String json,
+    final String key,
+    final int from,
+  ) {
+    final int index = json.indexOf(key, from);
+    return index < 0 ? -1 : index + key.length;
+  }
+
+  static const int _subBuckets = 8;
+  static const int _bucketCount = 64 * _subBuckets;
+
+  // Log-linear bucket: the power of two and the next 3 bits
+  static int _bucketOf(final int value) {
+    if (value < _subBuckets) {
+      return max(value, 0);
+    }
+    final int shift = value.bitLength - 4;
+    return (shift + 1) * _subBuckets + ((value >> shift) & (_subBuckets - 1));
+  }
+
+  static int _bucketValue(final int bucket) {
+    if (bucket < _subBuckets) {
+      return bucket;
+    }
+    final int shift = bucket ~/ _subBuckets - 1;
+    return (_subBuckets + bucket % _subBuckets) << shift;
+  }
+}
+
+/// Counters of the calls of one class and method.
+@internal
+class BridgeCallRecord {
+  BridgeCallRecord._(this.kind, this.className, this.method)
+      : label = method.isEmpty ? className : '$className.$method';
+
+  final BridgeCallKind kind;
+  final String className;
+  final String method;
+
+  /// Name of the timeline events
+  final String label;
+
+  int count = 0;
+  int totalMicroseconds = 0;
+  int maxMicroseconds = 0;
+  int blockingMicroseconds = 0;
+  int slowCount = 0;
+  int requestBytes = 0;
+  int responseBytes = 0;
+  final Int32List latencies = Int32List(BridgeProfiler._bucketCount);
+  final Int32List responseSizes = Int32List(BridgeProfiler._bucketCount);
+
+  BridgeCallStats _toStats() =>
+      BridgeCallStats(
+        kind: kind,
+        className: className,
+        method: method,
+        count: count,
+        totalLatency: Duration(microseconds: totalMicroseconds),
+        maxLatency: Duration(microseconds: maxMicroseconds),
+        p50Latency: Duration(microseconds: _percentile(latencies, 0.5)),
+        p90Latency: Duration(microseconds: _percentile(latencies, 0.9)),
+        p99Latency: Duration(
+          microseconds: min(_percentile(latencies, 0.99), maxMicroseconds),
+        ),
+        requestBytes: requestBytes,
+        responseBytes: responseBytes,
+        p99ResponseBytes: _percentile(responseSizes, 0.99),
+        mainIsolateBlockingTime: Duration(microseconds: blockingMicroseconds),
+        slowCallCount: slowCount,
+      );
+
+  int _percentile(final Int32List histogram, final double fraction) {
+    final int rank = max(1, (count * fraction).ceil());
+    int seen = 0;
+    for (int bucket = 0; bucket < histogram.length; bucket++) {
+      seen += histogram[bucket];
+      if (seen >= rank) {
+        return BridgeProfiler._bucketValue(bucket);
+      }
+    }
+    return 0;
+  }
+}
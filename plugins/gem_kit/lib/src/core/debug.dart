@@ -8,9 +8,13 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
+import 'dart:async';
 import 'dart:convert';
 
 import 'package:gem_kit/core.dart';
+import 'package:gem_kit/src/core/bridge_profiler.dart';
+import 'package:gem_kit/src/core/gem_autorelease_object.dart';
+import 'package:gem_kit/src/core/object_lifetime_tracker.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:gem_kit/src/map/markers.dart';
 import 'package:gem_kit/weather.dart';
@@ -783,6 +787,112 @@ abstract class Debug {
   /// In enabled checks if an object is alive before calling a method on it.
   static bool isObjectAliveCheckEnabled = false;
 
+  static Timer? _memorySamplingTimer;
+
+  /// Enable or disable the profiling of the native bridge calls.
+  ///
+  /// Enabled by default. Each call only updates a few counters.
+  static set isBridgeProfilingEnabled(final bool value) =>
+      BridgeProfiler.instance.isEnabled = value;
+
+  /// Whether the native bridge calls are profiled.
+  static bool get isBridgeProfilingEnabled => BridgeProfiler.instance.isEnabled;
+
+  /// Enable or disable the `dart:developer` timeline events of the native bridge calls.
+  ///
+  /// Each profiled call is shown in the timeline as a synchronous event named after its class and method.
+  static set isBridgeTimelineEnabled(final bool value) =>
+      BridgeProfiler.instance.emitTimelineEvents = value;
+
+  /// Whether the native bridge calls emit timeline events.
+  static bool get isBridgeTimelineEnabled =>
+      BridgeProfiler.instance.emitTimelineEvents;
+
+  /// Set the latency above which a native bridge call is counted as slow.
+  ///
+  /// By default one frame at 60 Hz.
+  static set bridgeSlowCallThreshold(final Duration threshold) =>
+      BridgeProfiler.instance.slowCallThreshold = threshold;
+
+  /// The latency above which a native bridge call is counted as slow.
+  static Duration get bridgeSlowCallThreshold =>
+      BridgeProfiler.instance.slowCallThreshold;
+
+  /// Get the statistics of the native bridge calls.
+  ///
+  /// **Returns**
+  ///
+  /// * The statistics since the profiling started or since the last [resetBridgeProfile], serializable with [BridgeProfile.toJson].
+  static BridgeProfile getBridgeProfile() => BridgeProfiler.instance.snapshot();
+
+  /// Clear the statistics of the native bridge calls.
+  static void resetBridgeProfile() => BridgeProfiler.instance.reset();
+
+  /// Enable or disable the lifetime tracking of the SDK objects.
+  ///
+  /// Enabled by default. Only the objects created while it is enabled are tracked.
+  static set isObjectLifetimeTrackingEnabled(final bool value) =>
+      GemAutoreleaseObject.isLifetimeTrackingEnabled = value;
+
+  /// Whether the lifetime of the SDK objects is tracked.
+  static bool get isObjectLifetimeTrackingEnabled =>
+      GemAutoreleaseObject.isLifetimeTrackingEnabled;
+
+  /// Set the creation site sampling rate of the SDK objects.
+  ///
+  /// The creation stack trace is captured for one object out of [rate] of each class, starting with the first one. Zero disables the sampling.
+  static set objectCreationSampleRate(final int rate) =>
+      ObjectLifetimeTracker.instance.creationSampleRate = rate;
+
+  /// Get the lifetime statistics of the SDK objects.
+  ///
+  /// A memory sample is taken with the statistics, using [getUsedMemory] and [getMaxUsedMemory].
+  ///
+  /// **Returns**
+  ///
+  /// * The statistics of the tracked objects, grouped by Dart class.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  static ObjectStats getObjectStats() {
+    _sampleMemory();
+    return ObjectLifetimeTracker.instance.stats();
+  }
+
+  /// Reset the lifetime statistics of the released SDK objects and the memory samples.
+  ///
+  /// The live objects are still tracked.
+  static void resetObjectStats() => ObjectLifetimeTracker.instance.reset();
+
+  /// Start sampling the memory usage periodically.
+  ///
+  /// The samples are returned by [getObjectStats]. The last 256 samples are kept.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *period* The sampling period.
+  static void startMemorySampling(final Duration period) {
+    stopMemorySampling();
+    _memorySamplingTimer = Timer.periodic(
+      period,
+      (final Timer timer) => _sampleMemory(),
+    );
+  }
+
+  /// Stop sampling the memory usage.
+  static void stopMemorySampling() {
+    _memorySamplingTimer?.cancel();
+    _memorySamplingTimer = null;
+  }
+
+  static void _sampleMemory() {
+    ObjectLifetimeTracker.instance.sampleMemory(
+      getUsedMemory(),
+      getMaxUsedMemory(),
+    );
+  }
+
   static Level _getLevel(GemLoggingLevel loggingLevel) {
     switch (loggingLevel) {
       case GemLoggingLevel.severe:
@@ -8,11 +8,8 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
-
 import 'package:gem_kit/core.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
-import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:meta/meta.dart';
 
 /// Type of an entrance location.
@@ -69,7 +66,7 @@ class EntranceLocations extends GemAutoreleaseObject {
 
   @internal
   EntranceLocations.init(final int id) : _id = id {
-    super.registerAutoReleaseObject(_id);
+    super.registerAutoReleaseObject(_id, className: 'EntranceLocations');
   }
   final int _id;
   int get id => _id;
@@ -176,7 +173,5 @@ class EntranceLocations extends GemAutoreleaseObject {
     return resultString['result'];
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, dynamic>{'class': 'EntranceLocations', 'id': _id}),
-      );
+  void dispose() => disposeNative('EntranceLocations', _id);
 }
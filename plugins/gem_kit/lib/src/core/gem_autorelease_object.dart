@@ -8,8 +8,13 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
+import 'dart:convert';
+
 import 'package:gem_kit/src/core/gem_object_interface.dart';
+import 'package:gem_kit/src/core/gem_scope.dart';
+import 'package:gem_kit/src/core/object_lifetime_tracker.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+import 'package:meta/meta.dart';
 
 /// This class will not be documented.
 ///
@@ -24,14 +29,91 @@ class GemAutoreleaseObject {
   /// Used to make sure the correct object is released
   final int _timestamp = DateTime.now().millisecondsSinceEpoch;
 
+  int? _pointerId;
+  String? _className;
+  LifetimeToken? _lifetimeToken;
+  bool _released = false;
+
+  /// Whether the lifetime of the objects is tracked, see [ObjectLifetimeTracker].
+  static bool isLifetimeTrackingEnabled = true;
+
   /// Registers an object for auto release.
   ///
   /// When the object is not used anymore, it will be released automatically from C++.
-  void registerAutoReleaseObject(final int pointerId) {
+  /// If a [GemScope] is active, the object is also released when the scope ends.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *pointerId* The native object id.
+  /// * **IN** *className* The native class name used to delete the object. Objects without it are only released automatically.
+  void registerAutoReleaseObject(
+    final int pointerId, {
+    final String? className,
+  }) {
     _gemObject = GemKitPlatform.instance.registerWeakRelease(
       this,
       pointerId,
       _timestamp,
     );
+    _pointerId = pointerId;
+    _className = className;
+    if (isLifetimeTrackingEnabled) {
+      _lifetimeToken = ObjectLifetimeTracker.instance.track(
+        this,
+        runtimeType.toString(),
+        pointerId,
+      );
+    }
+
+    if (className != null) {
+      GemScope.current?.adopt(this);
+    }
   }
+
+  /// Whether the native object was released explicitly.
+  @internal
+  bool get isReleased => _released;
+
+  /// Releases the native object now instead of waiting for the garbage collector.
+  ///
+  /// **Returns**
+  ///
+  /// * True if the object was released, false if it was already released or cannot be released explicitly.
+  @internal
+  bool releaseNative() {
+    if (_released || _className == null) {
+      return false;
+    }
+    disposeNative(_className!, _pointerId);
+    return true;
+  }
+
+  /// Deletes the native object for an explicit `dispose` call.
+  ///
+  /// Does nothing if the object was already released, by a previous call or by the [GemScope] it was created in.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *className* The native class name used to delete the object.
+  /// * **IN** *pointerId* The native object id.
+  @internal
+  void disposeNative(final String className, final dynamic pointerId) {
+    if (_released) {
+      return;
+    }
+    _released = true;
+    if (_lifetimeToken != null) {
+      ObjectLifetimeTracker.instance.released(_lifetimeToken!);
+    }
+    GemKitPlatform.instance.callDeleteObject(
+      jsonEncode(<String, dynamic>{'class': className, 'id': pointerId}),
+    );
+  }
+
+  /// Number of live objects for each class.
+  ///
+  /// Objects are counted from their registration until they are released explicitly or collected. Only the objects registered while [isLifetimeTrackingEnabled] is set are counted.
+  @internal
+  static Map<String, int> get liveObjectCounts =>
+      Map<String, int>.unmodifiable(ObjectLifetimeTracker.instance.liveCounts);
 }
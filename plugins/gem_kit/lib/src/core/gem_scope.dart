@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+
+import 'package:gem_kit/src/core/gem_autorelease_object.dart';
+import 'package:meta/meta.dart';
+
+/// Scope releasing the SDK objects created inside it.
+///
+/// SDK objects are released when the Dart garbage collector collects them, which can keep native memory in use long after the objects are last used.
+/// The objects created while a scope is active are released together when the scope ends. Objects which must outlive the scope are kept with [keep].
+///
+/// Objects released by the scope must not be used after the scope ends. Disposing them explicitly, before or after the scope ends, deletes them only once.
+/// Objects without explicit release support are still released by the garbage collector.
+/// Objects cached by their owner, such as the collections of `MapViewPreferences`, are never adopted by a scope.
+///
+/// ```dart
+/// final int count = GemScope.run(() {
+///   int count = 0;
+///   for (final RouteInstruction instruction in route.instructions) {
+///     if (instruction.hasTurnInfo) count++;
+///   }
+///   return count;
+/// });
+/// ```
+///
+/// {@category Core}
+class GemScope {
+  /// Create a scope.
+  ///
+  /// The scope only adopts objects while it is active, see [run].
+  GemScope();
+
+  static const Symbol _zoneKey = #gemScope;
+
+  final List<GemAutoreleaseObject> _objects = <GemAutoreleaseObject>[];
+  GemScope? _parent;
+  bool _closed = false;
+
+  /// The innermost active scope, or null if no scope is active.
+  static GemScope? get current => Zone.current[_zoneKey] as GemScope?;
+
+  /// Run a function inside a new scope.
+  ///
+  /// If the function returns a [Future], the scope ends when the future completes.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *body* The function.
+  ///
+  /// **Returns**
+  ///
+  /// * The result of the function.
+  static T run<T>(final T Function() body) => GemScope().use(body);
+
+  /// Run a function with this scope active.
+  ///
+  /// The scope is released when the function ends, or when the returned [Future] completes.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *body* The function.
+  ///
+  /// **Returns**
+  ///
+  /// * The result of the function.
+  T use<T>(final T Function() body) {
+    final GemScope? outer = current;
+    if (!identical(outer, this)) {
+      _parent = outer;
+    }
+    final T result;
+    try {
+      result = runZoned(body, zoneValues: <Object, Object>{_zoneKey: this});
+    } catch (_) {
+      release();
+      rethrow;
+    }
+    if (result is Future) {
+      result.whenComplete(release).ignore();
+    } else {
+      release();
+    }
+    return result;
+  }
+
+  /// Run a function with no scope active.
+  ///
+  /// Used to create the objects cached and owned by another object, which must not be released with the scope they were first requested in.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *body* The function.
+  ///
+  /// **Returns**
+  ///
+  /// * The result of the function.
+  @internal
+  static T detached<T>(final T Function() body) =>
+      runZoned(body, zoneValues: <Object?, Object?>{_zoneKey: null});
+
+  /// Number of objects the scope will release.
+  int get length => _objects.length;
+
+  /// Keep an object alive after the scope ends.
+  ///
+  /// The object is then released by the garbage collector, or by the enclosing scope if [toParent] is true.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *object* The object created in the scope.
+  /// * **IN** *toParent* Move the object to the enclosing scope instead of leaving it to the garbage collector.
+  ///
+  /// **Returns**
+  ///
+  /// * The object.
+  T keep<T extends GemAutoreleaseObject>(
+    final T object, {
+    final bool toParent = false,
+  }) {
+    _objects.remove(object);
+    if (toParent) {
+      _parent?.adopt(object);
+    }
+    return object;
+  }
+
+  /// Release all the objects of the scope.
+  ///
+  /// Called automatically when the scope ends. Objects are released in reverse creation order.
+  void release() {
+    _closed = true;
+    for (int i = _objects.length - 1; i >= 0; i--) {
+      _objects[i].releaseNative();
+    }
+    _objects.clear();
+  }
+
+  @internal
+  void adopt(final GemAutoreleaseObject object) {
+    if (_closed) {
+      // Objects created by callbacks after the scope ended
+      _parent?.adopt(object);
+      return;
+    }
+    _objects.add(object);
+  }
+}
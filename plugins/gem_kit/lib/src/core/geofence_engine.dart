@@ -0,0 +1,686 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:collection';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/core/alarm_service.dart';
+import 'package:gem_kit/src/core/coordinates.dart';
+import 'package:gem_kit/src/core/geographic_area.dart';
+import 'package:gem_kit/src/core/packed_geometry.dart';
+import 'package:gem_kit/src/core/prepared_geographic_area.dart';
+import 'package:gem_kit/src/position/gem_position.dart';
+import 'package:gem_kit/src/position/gem_position_listener_impl.dart';
+import 'package:gem_kit/src/position/position_service.dart';
+
+/// Geofence event type
+///
+/// {@category Routes & Navigation}
+enum GeofenceEventType {
+  /// The position entered the geofence
+  enter,
+
+  /// The position exited the geofence
+  exit,
+
+  /// The position stayed inside the geofence for the dwell time
+  dwell,
+}
+
+/// Geofence event.
+///
+/// {@category Routes & Navigation}
+class GeofenceEvent {
+  GeofenceEvent({
+    required this.id,
+    required this.type,
+    required this.timestamp,
+  });
+
+  /// The geofence id
+  final String id;
+
+  /// The event type
+  final GeofenceEventType type;
+
+  /// The time of the position which confirmed the event
+  final DateTime timestamp;
+}
+
+/// Result of the evaluation of a position against the geofences.
+///
+/// {@category Routes & Navigation}
+class GeofenceEvaluation {
+  GeofenceEvaluation({
+    required this.candidateCount,
+    required this.insideCount,
+    required this.events,
+    required this.deferredEventCount,
+    required this.evaluationTime,
+  });
+
+  /// Number of geofences tested against the position
+  final int candidateCount;
+
+  /// Number of geofences containing the position
+  final int insideCount;
+
+  /// Events delivered for this position
+  final List<GeofenceEvent> events;
+
+  /// Number of events held back by the event rate limit
+  final int deferredEventCount;
+
+  /// Time spent evaluating the position
+  final Duration evaluationTime;
+}
+
+/// Geofence engine for large sets of monitored areas.
+///
+/// Unlike the areas monitored by the [AlarmService], the geofences are registered in bulk from packed buffers, and each position is only tested against the geofences of its spatial index cell.
+///
+/// Transitions use hysteresis:
+/// * an enter event is reported after the position stays inside for [enterDelay]
+/// * an exit event is reported after the position stays outside for [exitDelay]
+/// * a dwell event is reported once after the position stays inside for [dwellTime]
+///
+/// Removing a geofence does not report an exit event.
+///
+/// {@category Routes & Navigation}
+class GeofenceEngine {
+  /// Create a geofence engine.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *onEvents* Called with the events delivered for each evaluated position.
+  /// * **IN** *enterDelay* Time the position must stay inside before an enter event.
+  /// * **IN** *exitDelay* Time the position must stay outside before an exit event.
+  /// * **IN** *dwellTime* Time the position must stay inside before a dwell event. Zero disables dwell events.
+  /// * **IN** *maxEventsPerSecond* Maximum number of events delivered per second. Extra events are delivered with the next positions. Zero disables the limit.
+  /// * **IN** *maxAccuracy* Positions with a horizontal accuracy worse than this value, in meters, are ignored by [evaluatePosition]. Zero disables the check.
+  /// * **IN** *cellSize* Size of the spatial index cells, in degrees.
+  GeofenceEngine({
+    this.onEvents,
+    this.enterDelay = Duration.zero,
+    this.exitDelay = const Duration(seconds: 10),
+    this.dwellTime = Duration.zero,
+    this.maxEventsPerSecond = 0,
+    this.maxAccuracy = 0,
+    this.cellSize = 0.01,
+  }) : _tokens = maxEventsPerSecond.toDouble();
+
+  /// Called with the events delivered for each evaluated position
+  void Function(List<GeofenceEvent> events)? onEvents;
+
+  /// Time the position must stay inside before an enter event
+  final Duration enterDelay;
+
+  /// Time the position must stay outside before an exit event
+  final Duration exitDelay;
+
+  /// Time the position must stay inside before a dwell event
+  final Duration dwellTime;
+
+  /// Maximum number of events delivered per second
+  final int maxEventsPerSecond;
+
+  /// Maximum horizontal accuracy of the evaluated positions, in meters
+  final double maxAccuracy;
+
+  /// Size of the spatial index cells, in degrees
+  final double cellSize;
+
+  // Geofences covering more cells are kept out of the grid and always tested
+  static const int _maxCellsPerFence = 1024;
+
+  static const int _circle = 0;
+  static const int _polygon = 1;
+
+  static const int _outside = 0;
+  static const int _pendingEnter = 1;
+  static const int _inside = 2;
+  static const int _pendingExit = 3;
+
+  final Map<String, int> _slots = <String, int>{};
+  final List<String?> _ids = <String?>[];
+  final List<int> _freeSlots = <int>[];
+
+  // Per slot geometry
+  final List<int> _kinds = <int>[];
+  final List<double> _centerLatitudes = <double>[];
+  final List<double> _centerLongitudes = <double>[];
+  final List<double> _radiuses = <double>[];
+  final List<PreparedPolygonGeographicArea?> _polygons =
+      <PreparedPolygonGeographicArea?>[];
+  final List<List<int>?> _cellKeys = <List<int>?>[];
+
+  // Per slot transition state
+  final List<int> _states = <int>[];
+  final List<int> _stateSince = <int>[];
+  final List<int> _insideSince = <int>[];
+  final List<bool> _dwellReported = <bool>[];
+
+  final Map<int, List<int>> _grid = <int, List<int>>{};
+  final Set<int> _largeFences = <int>{};
+  final Set<int> _activeFences = <int>{};
+
+  final Queue<GeofenceEvent> _pendingEvents = Queue<GeofenceEvent>();
+  double _tokens;
+  int _lastRefillTime = 0;
+
+  GeofenceEvaluation? _lastEvaluation;
+  GemPositionListener? _positionListener;
+
+  /// Number of registered geofences.
+  int get length => _slots.length;
+
+  /// Ids of the registered geofences.
+  Iterable<String> get ids => _slots.keys;
+
+  /// Ids of the geofences the position is inside, after hysteresis.
+  List<String> get insideIds => <String>[
+        for (final int slot in _activeFences)
+          if (_states[slot] == _inside || _states[slot] == _pendingExit)
+            _ids[slot]!,
+      ];
+
+  /// Result of the last evaluated position.
+  GeofenceEvaluation? get lastEvaluation => _lastEvaluation;
+
+  /// Register circular geofences.
+  ///
+  /// Geofences with an already registered id are replaced.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *ids* The geofence ids.
+  /// * **IN** *circles* For each geofence, the center latitude, the center longitude and the radius in meters.
+  void addCircles(final List<String> ids, final Float64List circles) {
+    assert(circles.length == ids.length * 3);
+    for (int i = 0; i < ids.length; i++) {
+      final int slot = _slotFor(ids[i]);
+      _kinds[slot] = _circle;
+      _centerLatitudes[slot] = circles[3 * i];
+      _centerLongitudes[slot] = circles[3 * i + 1];
+      _radiuses[slot] = circles[3 * i + 2];
+      _polygons[slot] = null;
+      _index(slot);
+    }
+  }
+
+  /// Register polygon geofences.
+  ///
+  /// Geofences with an already registered id are replaced.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *ids* The geofence ids.
+  /// * **IN** *vertexOffsets* For each geofence, the index of its first vertex, followed by the total number of vertices.
+  /// * **IN** *latLons* The vertices of all the geofences, as interleaved latitudes and longitudes.
+  void addPolygons(
+    final List<String> ids,
+    final Int32List vertexOffsets,
+    final Float64List latLons,
+  ) {
+    assert(vertexOffsets.length == ids.length + 1);
+    for (int i = 0; i < ids.length; i++) {
+      final PackedGeometry polygon = PackedGeometry(
+        Float64List.sublistView(
+          latLons,
+          2 * vertexOffsets[i],
+          2 * vertexOffsets[i + 1],
+        ),
+      );
+      _addPolygon(
+        ids[i],
+        PreparedPolygonGeographicArea.fromPackedGeometry(polygon),
+      );
+    }
+  }
+
+  /// Register a geofence from a geographic area.
+  ///
+  /// A geofence with the same id is replaced.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *id* The geofence id.
+  /// * **IN** *area* The area. Circles and polygons are used as they are, other areas are replaced by their bounding box.
+  void addArea(final String id, final GeographicArea area) {
+    if (area is CircleGeographicArea) {
+      addCircles(
+        <String>[id],
+        Float64List.fromList(<double>[
+          area.centerCoordinates.latitude,
+          area.centerCoordinates.longitude,
+          area.radius.toDouble(),
+        ]),
+      );
+    } else if (area is PreparedPolygonGeographicArea) {
+      _addPolygon(id, area);
+    } else if (area is PolygonGeographicArea) {
+      _addPolygon(id, PreparedPolygonGeographicArea(area));
+    } else {
+      final RectangleGeographicArea box = area.boundingBox;
+      _addPolygon(
+        id,
+        PreparedPolygonGeographicArea(
+          PolygonGeographicArea(
+            coordinates: <Coordinates>[
+              box.topLeft,
+              Coordinates(
+                latitude: box.topLeft.latitude,
+                longitude: box.bottomRight.longitude,
+              ),
+              box.bottomRight,
+              Coordinates(
+                latitude: box.bottomRight.latitude,
+                longitude: box.topLeft.longitude,
+              ),
+            ],
+          ),
+        ),
+      );
+    }
+  }
+
+  /// Remove geofences.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *ids* The ids of the geofences. Unknown ids are ignored.
+  void remove(final Iterable<String> ids) {
+    for (final String id in ids) {
+      final int? slot = _slots.remove(id);
+      if (slot == null) {
+        continue;
+      }
+      _unindex(slot);
+      _activeFences.remove(slot);
+      _ids[slot] = null;
+      _polygons[slot] = null;
+      _freeSlots.add(slot);
+    }
+  }
+
+  /// Remove all the geofences.
+  void clear() {
+    _slots.clear();
+    _ids.clear();
+    _freeSlots.clear();
+    _kinds.clear();
+    _centerLatitudes.clear();
+    _centerLongitudes.clear();
+    _radiuses.clear();
+    _polygons.clear();
+    _cellKeys.clear();
+    _states.clear();
+    _stateSince.clear();
+    _insideSince.clear();
+    _dwellReported.clear();
+    _grid.clear();
+    _largeFences.clear();
+    _activeFences.clear();
+  }
+
+  /// Evaluate a position.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *position* The position.
+  ///
+  /// **Returns**
+  ///
+  /// * The evaluation result, or null if the position is ignored because of its accuracy.
+  GeofenceEvaluation? evaluatePosition(final GemPosition position) {
+    if (maxAccuracy > 0 &&
+        (!position.hasHorizontalAccuracy ||
+            position.accuracyH > maxAccuracy)) {
+      return null;
+    }
+    return evaluate(
+      position.latitude,
+      position.longitude,
+      time: position.timestamp,
+    );
+  }
+
+  /// Evaluate a position given by its coordinates.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *latitude* The latitude.
+  /// * **IN** *longitude* The longitude.
+  /// * **IN** *time* The time of the position. By default the current time.
+  ///
+  /// **Returns**
+  ///
+  /// * The evaluation result.
+  GeofenceEvaluation evaluate(
+    final double latitude,
+    final double longitude, {
+    final DateTime? time,
+  }) {
+    final Stopwatch stopwatch = Stopwatch()..start();
+    final DateTime timestamp = time ?? DateTime.now();
+    final int now = timestamp.millisecondsSinceEpoch;
+
+    final Set<int> inside = <int>{};
+    int candidateCount = _largeFences.length;
+    for (final int slot in _largeFences) {
+      if (_contains(slot, latitude, longitude)) {
+        inside.add(slot);
+      }
+    }
+    final List<int>? cell =
+        _grid[_cellKey(_rowOf(latitude), _columnOf(longitude))];
+    if (cell != null) {
+      candidateCount += cell.length;
+      for (final int slot in cell) {
+        if (_contains(slot, latitude, longitude)) {
+          inside.add(slot);
+        }
+      }
+    }
+
+    final List<GeofenceEvent> events = <GeofenceEvent>[];
+    void emit(final int slot, final GeofenceEventType type) => events.add(
+          GeofenceEvent(id: _ids[slot]!, type: type, timestamp: timestamp),
+        );
+
+    for (final int slot in inside) {
+      switch (_states[slot]) {
+        case _outside:
+          _setState(slot, _pendingEnter, now);
+        case _pendingExit:
+          _setState(slot, _inside, now);
+      }
+    }
+    final List<int> settled = <int>[];
+    for (final int slot in _activeFences) {
+      final int elapsed = now - _stateSince[slot];
+      final bool isInside = inside.contains(slot);
+      switch (_states[slot]) {
+        case _pendingEnter:
+          if (!isInside) {
+            settled.add(slot);
+          } else if (elapsed >= enterDelay.inMilliseconds) {
+            _states[slot] = _inside;
+            _stateSince[slot] = now;
+            _insideSince[slot] = now;
+            _dwellReported[slot] = false;
+            emit(slot, GeofenceEventType.enter);
+          }
+        case _inside:
+          if (!isInside) {
+            _states[slot] = _pendingExit;
+            _stateSince[slot] = now;
+          }
+        case _pendingExit:
+          if (elapsed >= exitDelay.inMilliseconds) {
+            settled.add(slot);
+            emit(slot, GeofenceEventType.exit);
+          }
+      }
+      if (_states[slot] == _inside &&
+          dwellTime > Duration.zero &&
+          !_dwellReported[slot] &&
+          now - _insideSince[slot] >= dwellTime.inMilliseconds) {
+        _dwellReported[slot] = true;
+        emit(slot, GeofenceEventType.dwell);
+      }
+    }
+    for (final int slot in settled) {
+      _setState(slot, _outside, now);
+    }
+
+    final List<GeofenceEvent> delivered = _rateLimit(events, now);
+    stopwatch.stop();
+
+    final GeofenceEvaluation evaluation = GeofenceEvaluation(
+      candidateCount: candidateCount,
+      insideCount: inside.length,
+      events: delivered,
+      deferredEventCount: _pendingEvents.length,
+      evaluationTime: stopwatch.elapsed,
+    );
+    _lastEvaluation = evaluation;
+    if (delivered.isNotEmpty) {
+      onEvents?.call(delivered);
+    }
+    return evaluation;
+  }
+
+  /// Start evaluating the positions of the [PositionService].
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *onEvaluated* Called with the result of each evaluated position.
+  void startPositionUpdates({
+    final void Function(GeofenceEvaluation evaluation)? onEvaluated,
+  }) {
+    stopPositionUpdates();
+    _positionListener = PositionService.instance.addPositionListener(
+      (final GemPosition position) {
+        final GeofenceEvaluation? evaluation = evaluatePosition(position);
+        if (evaluation != null) {
+          onEvaluated?.call(evaluation);
+        }
+      },
+    );
+  }
+
+  /// Stop evaluating the positions of the [PositionService].
+  void stopPositionUpdates() {
+    if (_positionListener != null) {
+      PositionService.instance.removeListener(_positionListener!);
+      _positionListener = null;
+    }
+  }
+
+  void _addPolygon(
+    final String id,
+    final PreparedPolygonGeographicArea polygon,
+  ) {
+    final int slot = _slotFor(id);
+    _kinds[slot] = _polygon;
+    _polygons[slot] = polygon;
+    _index(slot);
+  }
+
+  int _slotFor(final String id) {
+    final int? existing = _slots[id];
+    if (existing != null) {
+      // The transition state is kept, so that moving a geofence does not
+      // report it again
+      _unindex(existing);
+      return existing;
+    }
+    final int slot;
+    if (_freeSlots.isNotEmpty) {
+      slot = _freeSlots.removeLast();
+      _ids[slot] = id;
+    } else {
+      slot = _ids.length;
+      _ids.add(id);
+      _kinds.add(_circle);
+      _centerLatitudes.add(0);
+      _centerLongitudes.add(0);
+      _radiuses.add(0);
+      _polygons.add(null);
+      _cellKeys.add(null);
+      _states.add(_outside);
+      _stateSince.add(0);
+      _insideSince.add(0);
+      _dwellReported.add(false);
+    }
+    _states[slot] = _outside;
+    _dwellReported[slot] = false;
+    _slots[id] = slot;
+    return slot;
+  }
+
+  void _index(final int slot) {
+    double minLatitude, maxLatitude, minLongitude, maxLongitude;
+    if (_kinds[slot] == _circle) {
+      final double latitude = _centerLatitudes[slot];
+      final double radiusLatitude = _radiuses[slot] / _metersPerDegree;
+      final double radiusLongitude = radiusLatitude /
+          max(cos(latitude * pi / 180), 1e-6);
+      minLatitude = latitude - radiusLatitude;
+      maxLatitude = latitude + radiusLatitude;
+      minLongitude = _centerLongitudes[slot] - radiusLongitude;
+      maxLongitude = _centerLongitudes[slot] + radiusLongitude;
+    } else {
+      final RectangleGeographicArea box = _polygons[slot]!.boundingBox;
+      minLatitude = box.bottomRight.latitude;
+      maxLatitude = box.topLeft.latitude;
+      minLongitude = box.topLeft.longitude;
+      maxLongitude = box.bottomRight.longitude;
+    }
+
+    // Column ranges, split at the antimeridian
+    final List<int> columns;
+    if (maxLongitude - minLongitude >= 360) {
+      columns = <int>[0, _columnOf(180)];
+    } else if (minLongitude < -180) {
+      columns = <int>[
+        _columnOf(minLongitude + 360),
+        _columnOf(180),
+        0,
+        _columnOf(maxLongitude),
+      ];
+    } else if (maxLongitude > 180) {
+      columns = <int>[
+        _columnOf(minLongitude),
+        _columnOf(180),
+        0,
+        _columnOf(maxLongitude - 360),
+      ];
+    } else {
+      columns = <int>[_columnOf(minLongitude), _columnOf(maxLongitude)];
+    }
+
+    final int firstRow = _rowOf(minLatitude);
+    final int lastRow = _rowOf(maxLatitude);
+    int columnCount = 0;
+    for (int i = 0; i < columns.length; i += 2) {
+      columnCount += columns[i + 1] - columns[i] + 1;
+    }
+    if ((lastRow - firstRow + 1) * columnCount > _maxCellsPerFence) {
+      _largeFences.add(slot);
+      return;
+    }
+
+    final List<int> keys = <int>[];
+    for (int row = firstRow; row <= lastRow; row++) {
+      for (int i = 0; i < columns.length; i += 2) {
+        for (int column = columns[i]; column <= columns[i + 1]; column++) {
+          final int key = _cellKey(row, column);
+          keys.add(key);
+          _grid.putIfAbsent(key, () => <int>[]).add(slot);
+        }
+      }
+    }
+    _cellKeys[slot] = keys;
+  }
+
+  void _unindex(final int slot) {
+    _largeFences.remove(slot);
+    final List<int>? keys = _cellKeys[slot];
+    if (keys == null) {
+      return;
+    }
+    for (final int key in keys) {
+      final List<int> cell = _grid[key]!;
+      cell.remove(slot);
+      if (cell.isEmpty) {
+        _grid.remove(key);
+      }
+    }
+    _cellKeys[slot] = null;
+  }
+
+  bool _contains(
+    final int slot,
+    final double latitude,
+    final double longitude,
+  ) {
+    if (_kinds[slot] == _polygon) {
+      return _polygons[slot]!.contains(latitude, longitude);
+    }
+    final double radius = _radiuses[slot];
+    final double dLatitude =
+        (latitude - _centerLatitudes[slot]) * _metersPerDegree;
+    double deltaLongitude = longitude - _centerLongitudes[slot];
+    if (deltaLongitude > 180) {
+      deltaLongitude -= 360;
+    } else if (deltaLongitude < -180) {
+      deltaLongitude += 360;
+    }
+    final double dLongitude = deltaLongitude *
+        _metersPerDegree *
+        cos(_centerLatitudes[slot] * pi / 180);
+    // Equirectangular distance, accurate for geofence sized circles
+    return dLatitude * dLatitude + dLongitude * dLongitude <= radius * radius;
+  }
+
+  void _setState(final int slot, final int state, final int now) {
+    _states[slot] = state;
+    _stateSince[slot] = now;
+    if (state == _outside) {
+      _activeFences.remove(slot);
+    } else {
+      _activeFences.add(slot);
+    }
+  }
+
+  List<GeofenceEvent> _rateLimit(
+    final List<GeofenceEvent> events,
+    final int now,
+  ) {
+    if (maxEventsPerSecond <= 0) {
+      return events;
+    }
+    if (_lastRefillTime != 0) {
+      _tokens = min(
+        maxEventsPerSecond.toDouble(),
+        _tokens + max(0, now - _lastRefillTime) * maxEventsPerSecond / 1000,
+      );
+    }
+    _lastRefillTime = now;
+
+    _pendingEvents.addAll(events);
+    final List<GeofenceEvent> delivered = <GeofenceEvent>[];
+    while (_pendingEvents.isNotEmpty && _tokens >= 1) {
+      delivered.add(_pendingEvents.removeFirst());
+      _tokens -= 1;
+    }
+    return delivered;
+  }
+
+  int _rowOf(final double latitude) =>
+      ((latitude.clamp(-90.0, 90.0) + 90) / cellSize).floor();
+
+  // Longitudes are expected in [-180, 180], 180 is in the last column
+  int _columnOf(final double longitude) =>
+      ((longitude.clamp(-180.0, 180.0) + 180) / cellSize)
+          .floor()
+          .clamp(0, _lastColumn);
+
+  int get _lastColumn => (360 / cellSize).ceil() - 1;
+
+  // Multiplication instead of shifts, as web integers are shifted on 32 bits
+  static int _cellKey(final int row, final int column) =>
+      row * 0x4000000 + column;
+
+  static const double _metersPerDegree = 111319.49;
+}
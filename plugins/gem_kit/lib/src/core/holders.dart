@@ -24,7 +24,10 @@ class StringHolder extends GemAutoreleaseObject {
   }
 
   StringHolder.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'StringHolderFlutter',
+    );
   }
 
   String get value {
@@ -44,14 +47,7 @@ class StringHolder extends GemAutoreleaseObject {
     return StringHolder.init(decodedVal['result']);
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'StringHolderFlutter',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('StringHolderFlutter', _pointerId);
 
   final int _pointerId;
   int get pointerId => _pointerId;
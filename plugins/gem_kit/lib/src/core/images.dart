@@ -768,11 +768,7 @@ class Img extends ImgBase {
   }
 
   @internal
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{'class': 'ImgFlutter', 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative('ImgFlutter', _pointerId);
 }
 
 /// Class used for customizable turn images
@@ -44,7 +44,7 @@ class Landmark extends GemAutoreleaseObject {
 
   @internal
   Landmark.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'Landmark');
   }
   final int _pointerId;
 
@@ -808,11 +808,7 @@ class Landmark extends GemAutoreleaseObject {
     return retMap;
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{'class': 'Landmark', 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative('Landmark', _pointerId);
 }
 
 /// Coordinate referenced [Landmark] object.
@@ -28,7 +28,7 @@ class LandmarkCategory extends GemAutoreleaseObject {
 
   @internal
   LandmarkCategory.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'LandmarkCategory');
   }
   final int _pointerId;
 
@@ -155,8 +155,5 @@ class LandmarkCategory extends GemAutoreleaseObject {
     return LandmarkCategory.init(decodedVal['result']);
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(
-            <String, Object>{'class': 'LandmarkCategory', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('LandmarkCategory', _pointerId);
 }
@@ -22,7 +22,7 @@ class GemList<T> extends GemAutoreleaseObject implements Iterable<T> {
   GemList(this._pointerId, this._className, this._initializer);
 
   GemList.init(this._pointerId, this._className, this._initializer) {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: _className);
   }
   final dynamic _pointerId;
   dynamic get pointerId => _pointerId;
@@ -59,11 +59,7 @@ class GemList<T> extends GemAutoreleaseObject implements Iterable<T> {
     }
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, dynamic>{'class': _className, 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative(_className, _pointerId);
 
   @override
   bool any(final bool Function(T element) test) {
@@ -434,7 +430,7 @@ class LandmarkPositionList extends GemList<LandmarkPosition> {
           'LandmarkPositionList',
           (final dynamic data) => LandmarkPosition.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static LandmarkPositionList _create() {
@@ -473,7 +469,7 @@ class OverlayItemList extends GemList<OverlayItem> {
           'OverlayItemList',
           (final dynamic data) => OverlayItem.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static OverlayItemList _create() {
@@ -522,7 +518,7 @@ class RouteList extends GemList<Route> {
   @internal
   RouteList.init(final int id)
       : super(id, 'RouteList', (final dynamic data) => Route.init(data)) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static RouteList _create() {
@@ -564,7 +560,7 @@ class RouteInstructionList extends GemList<RouteInstruction> {
           'RouteInstructionList',
           (final dynamic data) => RouteInstruction.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
   static RouteInstructionList _create() {
     final String resultString = GemKitPlatform.instance.callCreateObject(
@@ -601,7 +597,7 @@ class RouteSegmentList extends GemList<RouteSegment> {
           'RouteSegmentList',
           (final dynamic data) => RouteSegment.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static RouteSegmentList create() {
@@ -646,7 +642,7 @@ class OverlayItemPositionList extends GemList<OverlayItemPosition> {
           'OverlayItemPositionList',
           (final dynamic data) => OverlayItemPosition.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static OverlayItemPositionList _create() {
@@ -692,7 +688,7 @@ class MarkerMatchList extends GemList<MarkerMatch> {
           'MarkerMatchList',
           (final dynamic data) => MarkerMatch.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static MarkerMatchList _create() {
@@ -731,7 +727,7 @@ class MarkerList extends GemList<Marker> {
 
   MarkerList.init(final dynamic id)
       : super(id, 'MarkerList', (final dynamic data) => Marker.init(data)) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static MarkerList _create() {
@@ -778,7 +774,7 @@ class TrafficEventList extends GemList<TrafficEvent> {
           'TrafficEventList',
           (final dynamic data) => TrafficEvent.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
 
   static TrafficEventList _create() {
@@ -816,7 +812,7 @@ class RouteTrafficEventList extends GemList<RouteTrafficEvent> {
           'RouteTrafficEventList',
           (final dynamic data) => RouteTrafficEvent.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
   static RouteTrafficEventList _create() {
     final String resultString = GemKitPlatform.instance.callCreateObject(
@@ -936,7 +932,7 @@ class SignpostItemList extends GemList<SignpostItem> {
           'SignpostItemList',
           (final dynamic data) => SignpostItem.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: _className);
   }
   static SignpostItemList _create() {
     final String resultString = GemKitPlatform.instance.callCreateObject(
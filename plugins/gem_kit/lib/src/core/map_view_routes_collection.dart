@@ -8,7 +8,6 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
 import 'dart:ui' show Color;
 
 import 'package:flutter/material.dart' show Colors;
@@ -17,7 +16,6 @@ import 'package:gem_kit/map.dart';
 import 'package:gem_kit/src/core/extensions.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/core/lists.dart';
-import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:meta/meta.dart';
 
 /// Mapview Routes collection class
@@ -32,7 +30,7 @@ class MapViewRoutesCollection extends GemList<Route> {
           'MapViewRouteCollection',
           (final dynamic data) => Route.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: 'MapViewRouteCollection');
   }
 
   // ignore: unused_element
@@ -50,7 +48,7 @@ class MapViewRoutesCollection extends GemList<Route> {
           'MapViewRouteCollection',
           (final dynamic data) => Route.init(data),
         ) {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: 'MapViewRouteCollection');
     hasInit = true;
   }
   bool hasInit = false;
@@ -427,14 +425,7 @@ class MapViewRoutesCollection extends GemList<Route> {
   }
 
   @override
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, dynamic>{
-        'class': 'MapViewRouteCollection',
-        'id': pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('MapViewRouteCollection', pointerId);
 }
 
 /// Mapview route class
@@ -0,0 +1,423 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:collection';
+import 'dart:math';
+
+import 'package:meta/meta.dart';
+
+/// Upper bounds of the age histogram buckets, in seconds. The last bucket holds the older objects.
+const List<int> objectAgeBucketLimits = <int>[
+  1,
+  10,
+  60,
+  600,
+  3600,
+  21600,
+  86400,
+];
+
+/// Lifetime statistics of the SDK objects of a class.
+///
+/// {@category Core}
+class ObjectClassStats {
+  ObjectClassStats({
+    required this.className,
+    required this.liveCount,
+    required this.createdCount,
+    required this.releasedCount,
+    required this.collectedCount,
+    required this.liveAgeHistogram,
+    required this.lifetimeHistogram,
+    required this.creationSites,
+  });
+
+  /// The Dart class name
+  final String className;
+
+  /// Number of objects not yet released
+  final int liveCount;
+
+  /// Number of objects created since the tracking started
+  final int createdCount;
+
+  /// Number of objects released explicitly, by a scope or a dispose method
+  final int releasedCount;
+
+  /// Number of objects released by the garbage collector
+  final int collectedCount;
+
+  /// Number of live objects by age, using the [objectAgeBucketLimits] buckets
+  final List<int> liveAgeHistogram;
+
+  /// Number of released objects by lifetime, using the [objectAgeBucketLimits] buckets
+  final List<int> lifetimeHistogram;
+
+  /// Sampled creation sites, with the number of samples of each site
+  final Map<String, int> creationSites;
+
+  Map<String, dynamic> toJson() {
+    final Map<String, dynamic> json = <String, dynamic>{};
+    json['className'] = className;
+    json['liveCount'] = liveCount;
+    json['createdCount'] = createdCount;
+    json['releasedCount'] = releasedCount;
+    json['collectedCount'] = collectedCount;
+    json['liveAgeHistogram'] = liveAgeHistogram;
+    json['lifetimeHistogram'] = lifetimeHistogram;
+    json['creationSites'] = creationSites;
+    return json;
+  }
+}
+
+/// Memory usage sample.
+///
+/// {@category Core}
+class ObjectMemorySample {
+  ObjectMemorySample({
+    required this.time,
+    required this.usedMemory,
+    required this.maxUsedMemory,
+    required this.liveObjectCount,
+  });
+
+  /// The sample time
+  final DateTime time;
+
+  /// Memory used by the engine, in bytes
+  final int usedMemory;
+
+  /// Maximum memory used by the engine, in bytes
+  final int maxUsedMemory;
+
+  /// Total number of live SDK objects
+  final int liveObjectCount;
+
+  Map<String, dynamic> toJson() {
+    final Map<String, dynamic> json = <String, dynamic>{};
+    json['time'] = time.millisecondsSinceEpoch;
+    json['usedMemory'] = usedMemory;
+    json['maxUsedMemory'] = maxUsedMemory;
+    json['liveObjectCount'] = liveObjectCount;
+    return json;
+  }
+}
+
+/// Lifetime statistics of the SDK objects.
+///
+/// {@category Core}
+class ObjectStats {
+  ObjectStats({
+    required this.time,
+    required this.classes,
+    required this.memorySamples,
+  });
+
+  /// The time of the statistics
+  final DateTime time;
+
+  /// Statistics for each class, by decreasing number of live objects
+  final List<ObjectClassStats> classes;
+
+  /// Memory usage samples, oldest first. The last sample is taken with the statistics
+  final List<ObjectMemorySample> memorySamples;
+
+  /// Total number of live SDK objects.
+  int get liveCount => classes.fold(
+        0,
+        (final int sum, final ObjectClassStats stats) => sum + stats.liveCount,
+      );
+
+  Map<String, dynamic> toJson() {
+    final Map<String, dynamic> json = <String, dynamic>{};
+    json['time'] = time.millisecondsSinceEpoch;
+    json['ageBucketLimits'] = objectAgeBucketLimits;
+    json['classes'] =
+        classes.map((final ObjectClassStats stats) => stats.toJson()).toList();
+    json['memorySamples'] = memorySamples
+        .map((final ObjectMemorySample sample) => sample.toJson())
+        .toList();
+    return json;
+  }
+}
+
+/// Tracks the lifetime of the SDK objects.
+///
+/// Each registration costs a few map updates. Live objects are counted by creation minute, and only their native id is kept to match the explicit deletions.
+/// Creation stack traces are only captured for sampled objects, counted separately for each class.
+///
+/// Objects are counted as released when they are deleted through `GemKitPlatform.callDeleteObject`, by a scope or by a `dispose` method, and as collected when the garbage collector finalizes them.
+@internal
+class ObjectLifetimeTracker {
+  ObjectLifetimeTracker._();
+
+  static final ObjectLifetimeTracker instance = ObjectLifetimeTracker._();
+
+  /// Capture the creation site of one object out of this many, for each class. Zero disables sampling.
+  int creationSampleRate = 1000;
+
+  /// Maximum number of distinct creation sites kept for a class.
+  static const int maxCreationSites = 32;
+
+  /// Number of stack frames kept for a creation site.
+  static const int creationSiteFrames = 6;
+
+  /// Maximum number of kept memory samples.
+  static const int maxMemorySamples = 256;
+
+  final Map<String, _ClassRecord> _classes = <String, _ClassRecord>{};
+  final Queue<ObjectMemorySample> _memorySamples = Queue<ObjectMemorySample>();
+  late final Finalizer<LifetimeToken> _finalizer =
+      Finalizer<LifetimeToken>((final LifetimeToken token) {
+    _release(token, collected: true);
+  });
+  // Live tokens by native id, to record the deletions made without the object
+  final Map<int, LifetimeToken> _tokensById = <int, LifetimeToken>{};
+  static final RegExp _idPattern = RegExp(r'"id":(-?\d+)');
+
+  /// Number of live objects for each class.
+  Map<String, int> get liveCounts => <String, int>{
+        for (final MapEntry<String, _ClassRecord> entry in _classes.entries)
+          if (entry.value.liveCount > 0) entry.key: entry.value.liveCount,
+      };
+
+  /// Start tracking an object.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *object* The object.
+  /// * **IN** *className* The class of the object.
+  /// * **IN** *pointerId* The native object id.
+  ///
+  /// **Returns**
+  ///
+  /// * The token passed to [released] when the object is released explicitly.
+  LifetimeToken track(
+    final Object object,
+    final String className,
+    final int pointerId,
+  ) {
+    final _ClassRecord record =
+        _classes.putIfAbsent(className, () => _ClassRecord());
+    final int now = DateTime.now().millisecondsSinceEpoch;
+    final LifetimeToken token = LifetimeToken._(record, now, pointerId);
+
+    record.createdCount++;
+    record.liveCount++;
+    record.liveByMinute.update(
+      token._minute,
+      (final int count) => count + 1,
+      ifAbsent: () => 1,
+    );
+
+    if (creationSampleRate > 0 &&
+        record.registrations++ % creationSampleRate == 0) {
+      record.addCreationSite(_creationSite());
+    }
+
+    _tokensById[pointerId] = token;
+    _finalizer.attach(object, token, detach: token);
+    return token;
+  }
+
+  /// Record the explicit release of an object.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *token* The token returned by [track].
+  void released(final LifetimeToken token) {
+    _finalizer.detach(token);
+    _release(token, collected: false);
+  }
+
+  /// Record the deletion of a native object.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *json* The deletion request, holding the id of the object.
+  void deleted(final String json) {
+    if (_tokensById.isEmpty) {
+      return;
+    }
+    final RegExpMatch? match = _idPattern.firstMatch(json);
+    final LifetimeToken? token =
+        match == null ? null : _tokensById[int.parse(match.group(1)!)];
+    if (token != null) {
+      released(token);
+    }
+  }
+
+  /// Record a memory usage sample.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *usedMemory* Memory used by the engine, in bytes.
+  /// * **IN** *maxUsedMemory* Maximum memory used by the engine, in bytes.
+  ///
+  /// **Returns**
+  ///
+  /// * The recorded sample.
+  ObjectMemorySample sampleMemory(
+    final int usedMemory,
+    final int maxUsedMemory,
+  ) {
+    int liveCount = 0;
+    for (final _ClassRecord record in _classes.values) {
+      liveCount += record.liveCount;
+    }
+    final ObjectMemorySample sample = ObjectMemorySample(
+      time: DateTime.now(),
+      usedMemory: usedMemory,
+      maxUsedMemory: maxUsedMemory,
+      liveObjectCount: liveCount,
+    );
+    if (_memorySamples.length == maxMemorySamples) {
+      _memorySamples.removeFirst();
+    }
+    _memorySamples.add(sample);
+    return sample;
+  }
+
+  /// Get the statistics of all the tracked classes.
+  ObjectStats stats() {
+    final DateTime time = DateTime.now();
+    final int nowMinute = time.millisecondsSinceEpoch ~/ 60000;
+    final List<ObjectClassStats> classes = <ObjectClassStats>[];
+    _classes.forEach((final String className, final _ClassRecord record) {
+      final List<int> liveAges = List<int>.filled(
+        objectAgeBucketLimits.length + 1,
+        0,
+      );
+      record.liveByMinute.forEach((final int minute, final int count) {
+        liveAges[_bucketOf((nowMinute - minute) * 60)] += count;
+      });
+      classes.add(
+        ObjectClassStats(
+          className: className,
+          liveCount: record.liveCount,
+          createdCount: record.createdCount,
+          releasedCount: record.releasedCount,
+          collectedCount: record.collectedCount,
+          liveAgeHistogram: liveAges,
+          lifetimeHistogram: List<int>.of(record.lifetimes),
+          creationSites: Map<String, int>.of(record.creationSites),
+        ),
+      );
+    });
+    classes.sort(
+      (final ObjectClassStats a, final ObjectClassStats b) =>
+          b.liveCount.compareTo(a.liveCount),
+    );
+    return ObjectStats(
+      time: time,
+      classes: classes,
+      memorySamples: List<ObjectMemorySample>.of(_memorySamples),
+    );
+  }
+
+  /// Forget the statistics of the released objects and the memory samples.
+  void reset() {
+    for (final _ClassRecord record in _classes.values) {
+      record.createdCount = record.liveCount;
+      record.releasedCount = 0;
+      record.collectedCount = 0;
+      record.lifetimes.fillRange(0, record.lifetimes.length, 0);
+      record.creationSites.clear();
+    }
+    _memorySamples.clear();
+  }
+
+  void _release(final LifetimeToken token, {required final bool collected}) {
+    if (token._released) {
+      return;
+    }
+    token._released = true;
+    if (identical(_tokensById[token._pointerId], token)) {
+      _tokensById.remove(token._pointerId);
+    }
+
+    final _ClassRecord record = token._record;
+    record.liveCount--;
+    final int remaining = (record.liveByMinute[token._minute] ?? 1) - 1;
+    if (remaining > 0) {
+      record.liveByMinute[token._minute] = remaining;
+    } else {
+      record.liveByMinute.remove(token._minute);
+    }
+    if (collected) {
+      record.collectedCount++;
+    } else {
+      record.releasedCount++;
+    }
+    final int lifetime =
+        DateTime.now().millisecondsSinceEpoch - token._createdTime;
+    record.lifetimes[_bucketOf(lifetime ~/ 1000)]++;
+  }
+
+  static int _bucketOf(final int seconds) {
+    for (int i = 0; i < objectAgeBucketLimits.length; i++) {
+      if (seconds < objectAgeBucketLimits[i]) {
+        return i;
+      }
+    }
+    return objectAgeBucketLimits.length;
+  }
+
+  static String _creationSite() {
+    final List<String> frames = StackTrace.current
+        .toString()
+        .split('\n')
+        .where(
+          (final String frame) =>
+              frame.isNotEmpty &&
+              !frame.contains('object_lifetime_tracker.dart') &&
+              !frame.contains('gem_autorelease_object.dart'),
+        )
+        .toList();
+    return frames
+        .sublist(0, min(frames.length, creationSiteFrames))
+        .map((final String frame) => frame.trim())
+        .join('\n');
+  }
+}
+
+/// Lifetime record of a tracked object.
+@internal
+class LifetimeToken {
+  LifetimeToken._(this._record, this._createdTime, this._pointerId)
+      : _minute = _createdTime ~/ 60000;
+
+  final _ClassRecord _record;
+  final int _createdTime;
+  final int _pointerId;
+  final int _minute;
+  bool _released = false;
+}
+
+class _ClassRecord {
+  int liveCount = 0;
+  int createdCount = 0;
+  int releasedCount = 0;
+  int collectedCount = 0;
+  int registrations = 0;
+  final Map<int, int> liveByMinute = <int, int>{};
+  final List<int> lifetimes =
+      List<int>.filled(objectAgeBucketLimits.length + 1, 0);
+  final Map<String, int> creationSites = <String, int>{};
+
+  void addCreationSite(final String site) {
+    final int? count = creationSites[site];
+    if (count != null) {
+      creationSites[site] = count + 1;
+    } else if (creationSites.length < ObjectLifetimeTracker.maxCreationSites) {
+      creationSites[site] = 1;
+    }
+  }
+}
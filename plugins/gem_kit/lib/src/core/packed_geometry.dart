@@ -0,0 +1,384 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/core/coordinates.dart';
+import 'package:meta/meta.dart';
+
+/// Geometry stored as a packed array of interleaved values.
+///
+/// Each point is stored as `latitude, longitude[, altitude][, distance]` in [values]. The number of values per point is given by [stride].
+///
+/// {@category Core}
+class PackedGeometry {
+  /// Create a packed geometry from interleaved values.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *values* The interleaved values. The length must be a multiple of the resulting [stride].
+  /// * **IN** *hasAltitude* True if each point contains the altitude in meters.
+  /// * **IN** *hasDistance* True if each point contains the cumulative distance in meters from the first point.
+  PackedGeometry(
+    this.values, {
+    this.hasAltitude = false,
+    this.hasDistance = false,
+  }) : stride = 2 + (hasAltitude ? 1 : 0) + (hasDistance ? 1 : 0);
+
+  /// Create a packed geometry from a list of coordinates.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *coords* The coordinates list.
+  /// * **IN** *includeAltitude* Store the altitude of each point.
+  /// * **IN** *includeDistance* Store the cumulative distance of each point.
+  factory PackedGeometry.fromCoordinates(
+    final List<Coordinates> coords, {
+    final bool includeAltitude = false,
+    final bool includeDistance = false,
+  }) {
+    final _PackedGeometryBuilder builder = _PackedGeometryBuilder(
+      coords.length,
+      includeAltitude,
+      includeDistance,
+    );
+    for (final Coordinates coord in coords) {
+      builder.add(coord.latitude, coord.longitude, coord.altitude ?? 0);
+    }
+    return builder.build();
+  }
+
+  @internal
+  factory PackedGeometry.fromJson(
+    final List<dynamic> json, {
+    final bool includeAltitude = false,
+    final bool includeDistance = false,
+  }) {
+    final _PackedGeometryBuilder builder = _PackedGeometryBuilder(
+      json.length,
+      includeAltitude,
+      includeDistance,
+    );
+    for (final dynamic item in json) {
+      final num? altitude = item['altitude'];
+      builder.add(
+        (item['latitude'] as num).toDouble(),
+        (item['longitude'] as num).toDouble(),
+        altitude?.toDouble() ?? 0,
+      );
+    }
+    return builder.build();
+  }
+
+  /// Parse `latitude, longitude` text lines, as produced by `PathFileFormat.latLonTxt`, without building intermediate objects.
+  @internal
+  factory PackedGeometry.fromLatLonText(
+    final Uint8List text, {
+    final bool includeDistance = false,
+  }) {
+    final List<double> latLon = <double>[];
+    double? latitude;
+    int tokenStart = -1;
+
+    for (int i = 0; i <= text.length; i++) {
+      final int c = i < text.length ? text[i] : _newLine;
+      final bool isNumberChar = (c >= _digit0 && c <= _digit9) ||
+          c == _dot ||
+          c == _minus ||
+          c == _plus ||
+          c == _lowerE ||
+          c == _upperE;
+
+      if (isNumberChar) {
+        if (tokenStart < 0) {
+          tokenStart = i;
+        }
+        continue;
+      }
+
+      if (tokenStart >= 0) {
+        final double? value = double.tryParse(
+          String.fromCharCodes(text, tokenStart, i),
+        );
+        tokenStart = -1;
+        if (value != null) {
+          if (latitude == null) {
+            latitude = value;
+          } else if (latitude.isFinite) {
+            latLon
+              ..add(latitude)
+              ..add(value);
+            // Ignore any other value on the same line
+            latitude = double.nan;
+          }
+        }
+      }
+
+      if (c == _newLine) {
+        latitude = null;
+      }
+    }
+
+    final int count = latLon.length ~/ 2;
+    final _PackedGeometryBuilder builder = _PackedGeometryBuilder(
+      count,
+      false,
+      includeDistance,
+    );
+    for (int i = 0; i < count; i++) {
+      builder.add(latLon[2 * i], latLon[2 * i + 1], 0);
+    }
+    return builder.build();
+  }
+
+  /// Interleaved point values.
+  final Float64List values;
+
+  /// True if each point contains the altitude in meters.
+  final bool hasAltitude;
+
+  /// True if each point contains the cumulative distance in meters from the first point.
+  final bool hasDistance;
+
+  /// Number of values stored for each point.
+  final int stride;
+
+  /// Number of points.
+  int get length => values.length ~/ stride;
+
+  /// Check if the geometry has no points.
+  bool get isEmpty => values.isEmpty;
+
+  /// Get the latitude of the point at [index].
+  double latitudeAt(final int index) => values[index * stride];
+
+  /// Get the longitude of the point at [index].
+  double longitudeAt(final int index) => values[index * stride + 1];
+
+  /// Get the altitude of the point at [index]. Returns 0 if [hasAltitude] is false.
+  double altitudeAt(final int index) =>
+      hasAltitude ? values[index * stride + 2] : 0;
+
+  /// Get the cumulative distance of the point at [index]. Returns 0 if [hasDistance] is false.
+  double distanceAt(final int index) =>
+      hasDistance ? values[index * stride + stride - 1] : 0;
+
+  /// Get the point at [index] as a [Coordinates] object.
+  Coordinates coordinatesAt(final int index) => Coordinates(
+        latitude: latitudeAt(index),
+        longitude: longitudeAt(index),
+        altitude: hasAltitude ? altitudeAt(index) : null,
+      );
+
+  /// Convert the geometry to a list of [Coordinates].
+  List<Coordinates> toCoordinates() =>
+      List<Coordinates>.generate(length, coordinatesAt);
+
+  /// Simplify the geometry using the Douglas-Peucker algorithm.
+  ///
+  /// The first and last points are always kept. Cumulative distances, if present, keep their values measured along the original geometry.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *tolerance* Maximum allowed deviation in meters. Values <= 0 return the geometry unchanged.
+  ///
+  /// **Returns**
+  ///
+  /// * The simplified geometry
+  PackedGeometry simplify(final double tolerance) {
+    final int count = length;
+    if (tolerance <= 0 || count < 3) {
+      return this;
+    }
+
+    // Project to a local equirectangular plane, in meters
+    final double refLatRad = latitudeAt(0) * pi / 180;
+    final double scaleX = _earthRadius * cos(refLatRad) * pi / 180;
+    const double scaleY = _earthRadius * pi / 180;
+    final Float64List xy = Float64List(2 * count);
+    for (int i = 0; i < count; i++) {
+      xy[2 * i] = longitudeAt(i) * scaleX;
+      xy[2 * i + 1] = latitudeAt(i) * scaleY;
+    }
+
+    final Uint8List keep = Uint8List(count);
+    keep[0] = 1;
+    keep[count - 1] = 1;
+    final double toleranceSq = tolerance * tolerance;
+
+    final List<int> stack = <int>[0, count - 1];
+    while (stack.isNotEmpty) {
+      final int last = stack.removeLast();
+      final int first = stack.removeLast();
+
+      final double ax = xy[2 * first];
+      final double ay = xy[2 * first + 1];
+      final double dx = xy[2 * last] - ax;
+      final double dy = xy[2 * last + 1] - ay;
+      final double segLenSq = dx * dx + dy * dy;
+
+      double maxDistSq = 0;
+      int maxIndex = -1;
+      for (int i = first + 1; i < last; i++) {
+        double px = xy[2 * i] - ax;
+        double py = xy[2 * i + 1] - ay;
+        if (segLenSq > 0) {
+          final double t = ((px * dx + py * dy) / segLenSq).clamp(0.0, 1.0);
+          px -= t * dx;
+          py -= t * dy;
+        }
+        final double distSq = px * px + py * py;
+        if (distSq > maxDistSq) {
+          maxDistSq = distSq;
+          maxIndex = i;
+        }
+      }
+
+      if (maxIndex >= 0 && maxDistSq > toleranceSq) {
+        keep[maxIndex] = 1;
+        stack
+          ..add(first)
+          ..add(maxIndex)
+          ..add(maxIndex)
+          ..add(last);
+      }
+    }
+
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+      kept += keep[i];
+    }
+
+    final Float64List result = Float64List(kept * stride);
+    int offset = 0;
+    for (int i = 0; i < count; i++) {
+      if (keep[i] == 1) {
+        result.setRange(offset, offset + stride, values, i * stride);
+        offset += stride;
+      }
+    }
+
+    return PackedGeometry(
+      result,
+      hasAltitude: hasAltitude,
+      hasDistance: hasDistance,
+    );
+  }
+
+  /// Encode the geometry using the encoded polyline algorithm format.
+  ///
+  /// Only latitude and longitude are encoded.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *precision* Number of decimals kept for each value. Use 5 for the common format and 6 for the high precision variant.
+  ///
+  /// **Returns**
+  ///
+  /// * The encoded polyline
+  String toEncodedPolyline({final int precision = 5}) {
+    final double factor = pow(10, precision).toDouble();
+    final StringBuffer buffer = StringBuffer();
+
+    int prevLat = 0;
+    int prevLon = 0;
+    for (int i = 0; i < length; i++) {
+      final int lat = (latitudeAt(i) * factor).round();
+      final int lon = (longitudeAt(i) * factor).round();
+      _encodeSignedValue(lat - prevLat, buffer);
+      _encodeSignedValue(lon - prevLon, buffer);
+      prevLat = lat;
+      prevLon = lon;
+    }
+
+    return buffer.toString();
+  }
+
+  static void _encodeSignedValue(final int value, final StringBuffer buffer) {
+    int shifted = value < 0 ? ~(value << 1) : value << 1;
+    while (shifted >= 0x20) {
+      buffer.writeCharCode((0x20 | (shifted & 0x1f)) + 63);
+      shifted >>= 5;
+    }
+    buffer.writeCharCode(shifted + 63);
+  }
+
+  static const double _earthRadius = 6371000;
+
+  static const int _newLine = 0x0A;
+  static const int _digit0 = 0x30;
+  static const int _digit9 = 0x39;
+  static const int _dot = 0x2E;
+  static const int _minus = 0x2D;
+  static const int _plus = 0x2B;
+  static const int _lowerE = 0x65;
+  static const int _upperE = 0x45;
+}
+
+class _PackedGeometryBuilder {
+  _PackedGeometryBuilder(
+    final int capacity,
+    this.includeAltitude,
+    this.includeDistance,
+  )   : _stride = 2 + (includeAltitude ? 1 : 0) + (includeDistance ? 1 : 0),
+        _values = Float64List(
+          capacity * (2 + (includeAltitude ? 1 : 0) + (includeDistance ? 1 : 0)),
+        );
+
+  final bool includeAltitude;
+  final bool includeDistance;
+  final int _stride;
+  final Float64List _values;
+  int _offset = 0;
+  double _distance = 0;
+
+  void add(final double latitude, final double longitude, final double alt) {
+    if (includeDistance && _offset > 0) {
+      _distance += _haversine(
+        _values[_offset - _stride],
+        _values[_offset - _stride + 1],
+        latitude,
+        longitude,
+      );
+    }
+
+    _values[_offset++] = latitude;
+    _values[_offset++] = longitude;
+    if (includeAltitude) {
+      _values[_offset++] = alt;
+    }
+    if (includeDistance) {
+      _values[_offset++] = _distance;
+    }
+  }
+
+  PackedGeometry build() => PackedGeometry(
+        _offset == _values.length
+            ? _values
+            : Float64List.sublistView(_values, 0, _offset),
+        hasAltitude: includeAltitude,
+        hasDistance: includeDistance,
+      );
+
+  static double _haversine(
+    final double lat1,
+    final double lon1,
+    final double lat2,
+    final double lon2,
+  ) {
+    const double toRad = pi / 180;
+    final double dLat = (lat2 - lat1) * toRad;
+    final double dLon = (lon2 - lon1) * toRad;
+    final double a = sin(dLat / 2) * sin(dLat / 2) +
+        cos(lat1 * toRad) * cos(lat2 * toRad) * sin(dLon / 2) * sin(dLon / 2);
+    return 2 * PackedGeometry._earthRadius * atan2(sqrt(a), sqrt(1 - a));
+  }
+}
@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/core/terrain_profile.dart';
+import 'package:meta/meta.dart';
+
+/// Terrain profile sections stored as packed columns.
+///
+/// Used for the surface, road type and steep sections. The value of a section is the [SurfaceType] id, the [RoadType] id or the steep category index.
+///
+/// {@category Routes & Navigation}
+class PackedTerrainSections {
+  @internal
+  PackedTerrainSections(this.startDistances, this.values);
+
+  @internal
+  factory PackedTerrainSections.fromJson(
+    final List<dynamic> json,
+    final String valueKey,
+  ) {
+    final Int32List startDistances = Int32List(json.length);
+    final Int32List values = Int32List(json.length);
+    for (int i = 0; i < json.length; i++) {
+      final dynamic item = json[i];
+      startDistances[i] = item['startDistanceM'];
+      values[i] = item[valueKey];
+    }
+    return PackedTerrainSections(startDistances, values);
+  }
+
+  /// Distance in meters from the route start where each section starts.
+  final Int32List startDistances;
+
+  /// The value of each section.
+  final Int32List values;
+
+  /// Number of sections.
+  int get length => startDistances.length;
+
+  /// Get the sections as [SurfaceSection] objects.
+  List<SurfaceSection> toSurfaceSections() => List<SurfaceSection>.generate(
+        length,
+        (final int i) => SurfaceSection(
+          startDistanceM: startDistances[i],
+          type: SurfaceTypeExtension.fromId(values[i]),
+        ),
+      );
+
+  /// Get the sections as [RoadTypeSection] objects.
+  List<RoadTypeSection> toRoadTypeSections() =>
+      List<RoadTypeSection>.generate(
+        length,
+        (final int i) => RoadTypeSection(
+          startDistanceM: startDistances[i],
+          type: RoadTypeExtension.fromId(values[i]),
+        ),
+      );
+
+  /// Get the sections as [SteepSection] objects.
+  List<SteepSection> toSteepSections() => List<SteepSection>.generate(
+        length,
+        (final int i) =>
+            SteepSection(startDistanceM: startDistances[i], categ: values[i]),
+      );
+}
+
+/// Climb sections stored as packed records.
+///
+/// Each record is stored as `startDistance, endDistance, grade` in [records], with the [Grade] id. The slopes are stored separately in [slopes].
+///
+/// {@category Routes & Navigation}
+class PackedClimbSections {
+  @internal
+  PackedClimbSections(this.records, this.slopes);
+
+  @internal
+  factory PackedClimbSections.fromJson(final List<dynamic> json) {
+    final Int32List records = Int32List(json.length * recordSize);
+    final Float32List slopes = Float32List(json.length);
+    for (int i = 0; i < json.length; i++) {
+      final dynamic item = json[i];
+      final int offset = i * recordSize;
+      records[offset] = item['startDistanceM'];
+      records[offset + 1] = item['endDistanceM'];
+      records[offset + 2] = item['grade'];
+      slopes[i] = (item['slope'] as num).toDouble();
+    }
+    return PackedClimbSections(records, slopes);
+  }
+
+  /// Number of values of a record.
+  static const int recordSize = 3;
+
+  /// The packed records.
+  final Int32List records;
+
+  /// The slope of each section.
+  final Float32List slopes;
+
+  /// Number of sections.
+  int get length => slopes.length;
+
+  /// Get the distance in meters where the section at [index] starts.
+  int startDistanceAt(final int index) => records[index * recordSize];
+
+  /// Get the distance in meters where the section at [index] ends.
+  int endDistanceAt(final int index) => records[index * recordSize + 1];
+
+  /// Get the grade of the section at [index].
+  Grade gradeAt(final int index) =>
+      GradeExtension.fromId(records[index * recordSize + 2]);
+
+  /// Get the sections as [ClimbSection] objects.
+  List<ClimbSection> toList() => List<ClimbSection>.generate(
+        length,
+        (final int i) => ClimbSection(
+          startDistanceM: startDistanceAt(i),
+          endDistanceM: endDistanceAt(i),
+          slope: slopes[i],
+          grade: gradeAt(i),
+        ),
+      );
+}
+
+/// Route terrain profile bundle with packed elevation samples and section tables.
+///
+/// Obtained with [RouteTerrainProfile.getPackedProfile] or [RouteTerrainProfile.getPackedProfileAsync].
+///
+/// {@category Routes & Navigation}
+class PackedTerrainProfile {
+  @internal
+  PackedTerrainProfile({
+    required this.elevations,
+    required this.sampleDistance,
+    required this.startDistance,
+    required this.minElevation,
+    required this.maxElevation,
+    required this.totalUp,
+    required this.totalDown,
+    required this.climbSections,
+    required this.surfaceSections,
+    required this.roadTypeSections,
+    required this.steepSections,
+  });
+
+  /// Decode the bridge replies of the profile.
+  ///
+  /// Runs without access to the SDK, so it can be called on another isolate.
+  /// A failed call replies with a null result. Its samples and sections are then empty and its values zero.
+  @internal
+  factory PackedTerrainProfile.decode(final PackedTerrainProfileReplies r) {
+    dynamic result(final String reply) => jsonDecode(reply)['result'];
+    double number(final String reply) =>
+        (result(reply) as num?)?.toDouble() ?? 0;
+    List<dynamic> list(final String? reply) =>
+        (reply == null ? null : result(reply) as List<dynamic>?) ??
+        const <dynamic>[];
+
+    final dynamic samples = result(r.samples);
+    final List<dynamic> elevations =
+        samples?['floatlist'] ?? const <dynamic>[];
+    final Float32List packedElevations = Float32List(elevations.length);
+    for (int i = 0; i < elevations.length; i++) {
+      packedElevations[i] = (elevations[i] as num).toDouble();
+    }
+
+    return PackedTerrainProfile(
+      elevations: packedElevations,
+      sampleDistance: (samples?['sample'] as num?)?.toDouble() ?? 0,
+      startDistance: r.startDistance,
+      minElevation: number(r.minElevation),
+      maxElevation: number(r.maxElevation),
+      totalUp: number(r.totalUp),
+      totalDown: number(r.totalDown),
+      climbSections: PackedClimbSections.fromJson(list(r.climbSections)),
+      surfaceSections: PackedTerrainSections.fromJson(
+        list(r.surfaceSections),
+        'type',
+      ),
+      roadTypeSections: PackedTerrainSections.fromJson(
+        list(r.roadTypeSections),
+        'type',
+      ),
+      steepSections:
+          PackedTerrainSections.fromJson(list(r.steepSections), 'categ'),
+    );
+  }
+
+  /// Elevation samples in meters.
+  final Float32List elevations;
+
+  /// Distance in meters between two consecutive samples.
+  final double sampleDistance;
+
+  /// Distance in meters from the route start of the first sample.
+  final int startDistance;
+
+  /// Terrain minimum elevation.
+  final double minElevation;
+
+  /// Terrain maximum elevation.
+  final double maxElevation;
+
+  /// Total terrain elevation up.
+  final double totalUp;
+
+  /// Total terrain elevation down.
+  final double totalDown;
+
+  /// The climb sections. See [RouteTerrainProfile.climbSections].
+  final PackedClimbSections climbSections;
+
+  /// The surface sections. See [RouteTerrainProfile.surfaceSections].
+  final PackedTerrainSections surfaceSections;
+
+  /// The road type sections. See [RouteTerrainProfile.roadTypeSections].
+  final PackedTerrainSections roadTypeSections;
+
+  /// The steep sections. Empty if no steep categories were requested. See [RouteTerrainProfile.getSteepSections].
+  final PackedTerrainSections steepSections;
+
+  /// Number of elevation samples.
+  int get length => elevations.length;
+
+  /// Get the distance in meters from the route start of the sample at [index].
+  double distanceAt(final int index) => startDistance + index * sampleDistance;
+}
+
+/// Raw bridge replies of a packed terrain profile.
+@internal
+class PackedTerrainProfileReplies {
+  PackedTerrainProfileReplies({
+    required this.startDistance,
+    required this.samples,
+    required this.minElevation,
+    required this.maxElevation,
+    required this.totalUp,
+    required this.totalDown,
+    required this.climbSections,
+    required this.surfaceSections,
+    required this.roadTypeSections,
+    this.steepSections,
+  });
+
+  final int startDistance;
+  final String samples;
+  final String minElevation;
+  final String maxElevation;
+  final String totalUp;
+  final String totalDown;
+  final String climbSections;
+  final String surfaceSections;
+  final String roadTypeSections;
+  final String? steepSections;
+}
@@ -408,10 +408,5 @@ class SearchableParameterList extends ParameterList {
   }
 
   @override
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, dynamic>{
-          'class': 'SearchableParameterList',
-          'id': pointerId,
-        }),
-      );
+  void dispose() => disposeNative('SearchableParameterList', pointerId);
 }
@@ -18,6 +18,7 @@ import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/core/geographic_area.dart';
 import 'package:gem_kit/src/core/landmark.dart';
 import 'package:gem_kit/src/core/lists.dart';
+import 'package:gem_kit/src/core/packed_geometry.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:meta/meta.dart';
 
@@ -36,7 +37,10 @@ class MapViewPathCollection extends GemAutoreleaseObject {
   MapViewPathCollection.init(final int id, final int mapId)
       : _pointerId = id,
         _mapId = mapId {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'MapViewPathCollection',
+    );
   }
   final int _pointerId;
   final int _mapId;
@@ -318,12 +322,7 @@ class MapViewPathCollection extends GemAutoreleaseObject {
         .toList();
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'MapViewPathCollection',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('MapViewPathCollection', _pointerId);
 }
 
 /// Path import supported formats.
@@ -401,7 +400,7 @@ class Path extends GemAutoreleaseObject {
 
   @internal
   Path.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'Path');
   }
   final int _pointerId;
 
@@ -519,6 +518,80 @@ class Path extends GemAutoreleaseObject {
     return retList;
   }
 
+  /// Get the path coordinates as a packed array.
+  ///
+  /// Unlike [coordinates], no [Coordinates] object is created for each point.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *includeAltitude* Store the altitude of each point.
+  /// * **IN** *includeDistance* Store the cumulative distance in meters of each point from the path start.
+  /// * **IN** *simplifyTolerance* If greater than 0, the geometry is simplified using the Douglas-Peucker algorithm with the given tolerance in meters.
+  ///
+  /// **Returns**
+  ///
+  /// * The packed coordinates
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  PackedGeometry getPackedCoordinates({
+    final bool includeAltitude = false,
+    final bool includeDistance = false,
+    final double simplifyTolerance = 0,
+  }) {
+    PackedGeometry geometry;
+    if (includeAltitude) {
+      final OperationResult resultString = objectMethod(
+        _pointerId,
+        'Path',
+        'getCoordinates',
+      );
+      geometry = PackedGeometry.fromJson(
+        resultString['result'],
+        includeAltitude: true,
+        includeDistance: includeDistance,
+      );
+    } else {
+      // The text export carries only latitude / longitude and avoids decoding one map per point
+      final OperationResult resultString = objectMethod(
+        _pointerId,
+        'Path',
+        'exportAs',
+        args: PathFileFormat.latLonTxt.id,
+      );
+      geometry = PackedGeometry.fromLatLonText(
+        base64Decode(resultString['result']),
+        includeDistance: includeDistance,
+      );
+    }
+
+    return geometry.simplify(simplifyTolerance);
+  }
+
+  /// Export the path coordinates in the encoded polyline algorithm format.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *simplifyTolerance* If greater than 0, the geometry is simplified using the Douglas-Peucker algorithm with the given tolerance in meters.
+  /// * **IN** *precision* Number of decimals kept for each value. Use 5 for the common format and 6 for the high precision variant.
+  ///
+  /// **Returns**
+  ///
+  /// * The encoded polyline
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  String toEncodedPolyline({
+    final double simplifyTolerance = 0,
+    final int precision = 5,
+  }) {
+    return getPackedCoordinates(
+      simplifyTolerance: simplifyTolerance,
+    ).toEncodedPolyline(precision: precision);
+  }
+
   /// Get a coordinate along the path given by a fraction of the path length between 0.0 (departure point) and 1.0 (destination).
   ///
   /// **Parameters**
@@ -658,11 +731,7 @@ class Path extends GemAutoreleaseObject {
     return LandmarkList.init(resultString['result']).toList();
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, dynamic>{'class': 'Path', 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative('Path', _pointerId);
 }
 
 class PathMatch {
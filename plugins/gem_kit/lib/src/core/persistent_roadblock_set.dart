@@ -0,0 +1,730 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+import 'package:gem_kit/src/routing/routing_preferences.dart';
+import 'package:meta/meta.dart';
+
+/// Persistent roadblock types.
+///
+/// {@category Routes & Navigation}
+enum PersistentRoadblockType {
+  /// Roadblock on a point or a path. See [TrafficService.addPersistentRoadblockByCoordinates].
+  path,
+
+  /// Roadblock on an area. See [TrafficService.addPersistentRoadblockByArea].
+  area,
+
+  /// Roadblock outside an area. See [TrafficService.addAntiPersistentRoadblockByArea].
+  antiArea,
+}
+
+/// Definition of a persistent roadblock of a [PersistentRoadblockSet].
+///
+/// {@category Routes & Navigation}
+class PersistentRoadblockDefinition {
+  /// Create a roadblock on a point or a path.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *id* The roadblock id, unique in the set.
+  /// * **IN** *coords* The roadblock coordinates. See [TrafficService.addPersistentRoadblockByCoordinates].
+  /// * **IN** *startTime* The roadblock start time.
+  /// * **IN** *expireTime* The roadblock expire time.
+  /// * **IN** *transportMode* The transport mode for which the roadblock applies.
+  PersistentRoadblockDefinition.path({
+    required this.id,
+    required List<Coordinates> this.coords,
+    required this.startTime,
+    required this.expireTime,
+    this.transportMode = RouteTransportMode.car,
+  })  : type = PersistentRoadblockType.path,
+        area = null;
+
+  /// Create a roadblock on an area.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *id* The roadblock id, unique in the set.
+  /// * **IN** *area* The area affected by the roadblock.
+  /// * **IN** *startTime* The roadblock start time.
+  /// * **IN** *expireTime* The roadblock expire time.
+  /// * **IN** *transportMode* The transport mode for which the roadblock applies.
+  /// * **IN** *anti* If true, the roadblock is outside the area. See [TrafficService.addAntiPersistentRoadblockByArea].
+  PersistentRoadblockDefinition.area({
+    required this.id,
+    required GeographicArea this.area,
+    required this.startTime,
+    required this.expireTime,
+    this.transportMode = RouteTransportMode.car,
+    final bool anti = false,
+  })  : type = anti
+            ? PersistentRoadblockType.antiArea
+            : PersistentRoadblockType.area,
+        coords = null;
+
+  /// The roadblock id, unique in the set.
+  final String id;
+
+  /// The roadblock type.
+  final PersistentRoadblockType type;
+
+  /// The coordinates of a [PersistentRoadblockType.path] roadblock.
+  final List<Coordinates>? coords;
+
+  /// The area of a [PersistentRoadblockType.area] or [PersistentRoadblockType.antiArea] roadblock.
+  final GeographicArea? area;
+
+  /// The roadblock start time.
+  final DateTime startTime;
+
+  /// The roadblock expire time.
+  final DateTime expireTime;
+
+  /// The transport mode for which the roadblock applies.
+  final RouteTransportMode transportMode;
+
+  /// The add request of the roadblock, with the given SDK id.
+  @internal
+  String addRequest(final String sdkId) => jsonEncode(<String, Object>{
+        'id': 0,
+        'class': 'TrafficService',
+        'method': _addMethod,
+        'args': <String, dynamic>{
+          if (type == PersistentRoadblockType.path)
+            'coord': coords
+          else
+            'area': area,
+          'startUTC': startTime.millisecondsSinceEpoch,
+          'expireUTC': expireTime.millisecondsSinceEpoch,
+          'transportMode': transportMode.id,
+          'id': sdkId,
+        },
+      });
+
+  String get _addMethod {
+    switch (type) {
+      case PersistentRoadblockType.path:
+        return 'addPersistentRoadblockCoords';
+      case PersistentRoadblockType.area:
+        return 'addPersistentRoadblockArea';
+      case PersistentRoadblockType.antiArea:
+        return 'addPersistentAntiRoadblockArea';
+    }
+  }
+}
+
+/// Path roadblocks stored as parallel columns, to build a [PersistentRoadblockSet] with [PersistentRoadblockSet.fromColumns].
+///
+/// The path of roadblock `i` is made of the coordinates from `pathOffsets[i]` to `pathOffsets[i + 1]` (excluded) of [latitudes] and [longitudes].
+///
+/// {@category Routes & Navigation}
+class PersistentRoadblockColumns {
+  /// Create the columns.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *ids* The roadblock ids.
+  /// * **IN** *pathOffsets* The offset of the first coordinate of each roadblock, followed by the number of coordinates.
+  /// * **IN** *latitudes* The coordinate latitudes.
+  /// * **IN** *longitudes* The coordinate longitudes.
+  /// * **IN** *startTimes* The start time of each roadblock, in milliseconds since epoch (UTC).
+  /// * **IN** *expireTimes* The expire time of each roadblock, in milliseconds since epoch (UTC).
+  /// * **IN** *transportModes* The [RouteTransportMode] id of each roadblock. If not provided, the roadblocks apply to [RouteTransportMode.car].
+  ///
+  /// **Throws**
+  ///
+  /// * [ArgumentError] if the columns have inconsistent lengths.
+  PersistentRoadblockColumns({
+    required this.ids,
+    required this.pathOffsets,
+    required this.latitudes,
+    required this.longitudes,
+    required this.startTimes,
+    required this.expireTimes,
+    this.transportModes,
+  }) {
+    final int count = ids.length;
+    if (pathOffsets.length != count + 1 ||
+        startTimes.length != count ||
+        expireTimes.length != count ||
+        (transportModes != null && transportModes!.length != count) ||
+        latitudes.length != longitudes.length ||
+        pathOffsets.last != latitudes.length) {
+      throw ArgumentError('Inconsistent roadblock columns');
+    }
+  }
+
+  /// The roadblock ids.
+  final List<String> ids;
+
+  /// The offset of the first coordinate of each roadblock, followed by the number of coordinates.
+  final Int32List pathOffsets;
+
+  /// The coordinate latitudes.
+  final Float64List latitudes;
+
+  /// The coordinate longitudes.
+  final Float64List longitudes;
+
+  /// The start time of each roadblock, in milliseconds since epoch (UTC).
+  final Float64List startTimes;
+
+  /// The expire time of each roadblock, in milliseconds since epoch (UTC).
+  final Float64List expireTimes;
+
+  /// The [RouteTransportMode] id of each roadblock.
+  final Uint8List? transportModes;
+
+  /// Number of roadblocks.
+  int get length => ids.length;
+}
+
+/// Named set of persistent roadblocks, applied and replaced as a whole with [TrafficService.replacePersistentRoadblockSet].
+///
+/// The roadblocks are added to the SDK with the `<set name>/<roadblock id>` id, so several sets can be applied at the same time.
+/// The applied roadblocks of each set are stored in the SDK settings, so a set applied in a previous session is replaced like one applied in the current session.
+///
+/// {@category Routes & Navigation}
+class PersistentRoadblockSet {
+  /// Create a set.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *name* The set name.
+  /// * **IN** *roadblocks* The roadblocks.
+  ///
+  /// **Throws**
+  ///
+  /// * [ArgumentError] if two roadblocks have the same id.
+  PersistentRoadblockSet(
+    this.name,
+    final List<PersistentRoadblockDefinition> roadblocks,
+  ) : roadblocks = <String, PersistentRoadblockDefinition>{} {
+    for (final PersistentRoadblockDefinition roadblock in roadblocks) {
+      if (this.roadblocks.containsKey(roadblock.id)) {
+        throw ArgumentError('Duplicated roadblock id ${roadblock.id}');
+      }
+      this.roadblocks[roadblock.id] = roadblock;
+    }
+  }
+
+  /// Create a set of path roadblocks from packed columns.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *name* The set name.
+  /// * **IN** *columns* The roadblocks.
+  ///
+  /// **Throws**
+  ///
+  /// * [ArgumentError] if two roadblocks have the same id.
+  factory PersistentRoadblockSet.fromColumns(
+    final String name,
+    final PersistentRoadblockColumns columns,
+  ) {
+    final Uint8List? modes = columns.transportModes;
+    return PersistentRoadblockSet(
+      name,
+      List<PersistentRoadblockDefinition>.generate(
+        columns.length,
+        (final int i) => PersistentRoadblockDefinition.path(
+          id: columns.ids[i],
+          coords: <Coordinates>[
+            for (int c = columns.pathOffsets[i];
+                c < columns.pathOffsets[i + 1];
+                c++)
+              Coordinates(
+                latitude: columns.latitudes[c],
+                longitude: columns.longitudes[c],
+              ),
+          ],
+          startTime: _time(columns.startTimes[i].toInt()),
+          expireTime: _time(columns.expireTimes[i].toInt()),
+          transportMode: modes == null
+              ? RouteTransportMode.car
+              : RouteTransportModeExtension.fromId(modes[i]),
+        ),
+      ),
+    );
+  }
+
+  /// Create a set from a GeoJSON feature collection.
+  ///
+  /// Each feature is a roadblock:
+  /// * `Point` and `LineString` geometries are path roadblocks, `Polygon` geometries are area roadblocks, using the outer ring.
+  /// * The `id` property is the roadblock id.
+  /// * The `startTime` and `expireTime` properties are ISO 8601 strings or milliseconds since epoch (UTC).
+  /// * The optional `transportMode` property is a [RouteTransportMode] name.
+  /// * The optional `anti` property set to true makes a polygon an anti-area roadblock.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *name* The set name.
+  /// * **IN** *geoJson* The GeoJSON text.
+  /// * **IN** *startTime* The start time of the features without a `startTime` property.
+  /// * **IN** *expireTime* The expire time of the features without an `expireTime` property.
+  ///
+  /// **Throws**
+  ///
+  /// * [FormatException] if the GeoJSON is not valid or has unsupported geometries.
+  /// * [ArgumentError] if two roadblocks have the same id.
+  factory PersistentRoadblockSet.fromGeoJson(
+    final String name,
+    final String geoJson, {
+    final DateTime? startTime,
+    final DateTime? expireTime,
+  }) {
+    final dynamic json = jsonDecode(geoJson);
+    if (json is! Map<String, dynamic> || json['features'] is! List<dynamic>) {
+      throw const FormatException('Not a GeoJSON feature collection');
+    }
+
+    final List<PersistentRoadblockDefinition> roadblocks =
+        <PersistentRoadblockDefinition>[];
+    for (final dynamic feature in json['features'] as List<dynamic>) {
+      final Map<String, dynamic> properties =
+          feature['properties'] ?? <String, dynamic>{};
+      final dynamic geometry = feature['geometry'];
+      final Object? id = properties['id'] ?? feature['id'];
+      if (id == null || geometry == null) {
+        throw const FormatException('Roadblock feature without id or geometry');
+      }
+
+      final DateTime start = _geoJsonTime(properties['startTime']) ??
+          startTime ??
+          (throw FormatException('No start time for roadblock $id'));
+      final DateTime expire = _geoJsonTime(properties['expireTime']) ??
+          expireTime ??
+          (throw FormatException('No expire time for roadblock $id'));
+      final String? mode = properties['transportMode'];
+      final RouteTransportMode transportMode = mode == null
+          ? RouteTransportMode.car
+          : RouteTransportMode.values.byName(mode);
+
+      final List<dynamic> coordinates = geometry['coordinates'];
+      switch (geometry['type']) {
+        case 'Point':
+          roadblocks.add(
+            PersistentRoadblockDefinition.path(
+              id: id.toString(),
+              coords: <Coordinates>[_geoJsonCoordinates(coordinates)],
+              startTime: start,
+              expireTime: expire,
+              transportMode: transportMode,
+            ),
+          );
+        case 'LineString':
+          roadblocks.add(
+            PersistentRoadblockDefinition.path(
+              id: id.toString(),
+              coords: coordinates.map(_geoJsonCoordinates).toList(),
+              startTime: start,
+              expireTime: expire,
+              transportMode: transportMode,
+            ),
+          );
+        case 'Polygon':
+          final List<Coordinates> ring = (coordinates.first as List<dynamic>)
+              .map(_geoJsonCoordinates)
+              .toList();
+          // GeoJSON rings repeat the first position at the end
+          if (ring.length > 1 && ring.first == ring.last) {
+            ring.removeLast();
+          }
+          roadblocks.add(
+            PersistentRoadblockDefinition.area(
+              id: id.toString(),
+              area: PolygonGeographicArea(coordinates: ring),
+              startTime: start,
+              expireTime: expire,
+              transportMode: transportMode,
+              anti: properties['anti'] == true,
+            ),
+          );
+        default:
+          throw FormatException(
+            'Unsupported geometry ${geometry['type']} for roadblock $id',
+          );
+      }
+    }
+    return PersistentRoadblockSet(name, roadblocks);
+  }
+
+  /// The set name.
+  final String name;
+
+  /// The roadblocks by id.
+  final Map<String, PersistentRoadblockDefinition> roadblocks;
+
+  /// Get the id given to the SDK for a roadblock of the set.
+  String sdkIdOf(final String id) => '$name/$id';
+
+  static DateTime _time(final int milliseconds) =>
+      DateTime.fromMillisecondsSinceEpoch(milliseconds, isUtc: true);
+
+  static DateTime? _geoJsonTime(final dynamic value) {
+    if (value is num) {
+      return _time(value.toInt());
+    }
+    if (value is String) {
+      return DateTime.parse(value).toUtc();
+    }
+    return null;
+  }
+
+  static Coordinates _geoJsonCoordinates(final dynamic position) => Coordinates(
+        latitude: (position[1] as num).toDouble(),
+        longitude: (position[0] as num).toDouble(),
+      );
+}
+
+/// Differences between a [PersistentRoadblockSet] and the roadblocks of the set currently applied.
+///
+/// {@category Routes & Navigation}
+class PersistentRoadblockSetDiff {
+  @internal
+  PersistentRoadblockSetDiff({
+    required this.added,
+    required this.removed,
+    required this.changed,
+    required this.unchanged,
+  });
+
+  /// Ids of the roadblocks which are not applied yet.
+  final List<String> added;
+
+  /// Ids of the applied roadblocks which are not in the new set.
+  final List<String> removed;
+
+  /// Ids of the roadblocks whose definition changed. They are removed and added again.
+  final List<String> changed;
+
+  /// Ids of the roadblocks which are already applied with the same definition. They are not modified.
+  final List<String> unchanged;
+
+  /// Check if applying the set changes nothing.
+  bool get isEmpty => added.isEmpty && removed.isEmpty && changed.isEmpty;
+}
+
+/// Result of [TrafficService.replacePersistentRoadblockSet] and [TrafficService.removePersistentRoadblockSet].
+///
+/// {@category Routes & Navigation}
+class PersistentRoadblockSetResult {
+  @internal
+  PersistentRoadblockSetResult({
+    required this.diff,
+    required this.errors,
+    required this.rolledBack,
+    required this.elapsed,
+  });
+
+  /// The differences with the previously applied set.
+  final PersistentRoadblockSetDiff diff;
+
+  /// The errors by roadblock id. See [TrafficService.addPersistentRoadblockByCoordinates] for the possible error codes.
+  final Map<String, GemError> errors;
+
+  /// True if the changes were reverted because of the errors. The previously applied set is then still active.
+  ///
+  /// Changed roadblocks found in the SDK without a stored previous definition cannot be restored and stay removed.
+  final bool rolledBack;
+
+  /// The time taken by the operation.
+  final Duration elapsed;
+
+  /// Check if all the changes were applied.
+  bool get isSuccess => errors.isEmpty;
+}
+
+/// Applies the persistent roadblock sets with batches of bridge calls.
+///
+/// The add requests of the applied roadblocks are stored by set name with a [SettingsService], as the SDK cannot list the roadblocks by id.
+@internal
+abstract class PersistentRoadblockSets {
+  static const String _settingsGroup = 'PersistentRoadblockSets';
+
+  // The add requests of the applied roadblocks by id, by set name. Loaded
+  // from the settings on first use
+  static final Map<String, Map<String, String>> _applied =
+      <String, Map<String, String>>{};
+
+  static SettingsService? _settingsService;
+
+  static PersistentRoadblockSetDiff diff(final PersistentRoadblockSet set) =>
+      _diff(set, _addRequests(set), _appliedOf(set.name));
+
+  static PersistentRoadblockSetResult replace(
+    final PersistentRoadblockSet set, {
+    required final bool atomic,
+  }) {
+    final Stopwatch stopwatch = Stopwatch()..start();
+    final Map<String, String> previous = _appliedOf(set.name);
+    final Map<String, String> requests = _addRequests(set);
+    final PersistentRoadblockSetDiff diff = _diff(set, requests, previous);
+    if (diff.isEmpty) {
+      return PersistentRoadblockSetResult(
+        diff: diff,
+        errors: <String, GemError>{},
+        rolledBack: false,
+        elapsed: stopwatch.elapsed,
+      );
+    }
+
+    final List<String> toRemove = <String>[...diff.removed, ...diff.changed];
+    final List<String> toAdd = <String>[...diff.changed, ...diff.added];
+    final List<String> replies = GemKitPlatform.instance.callObjectMethodBatch(
+      <String>[
+        for (final String id in toRemove)
+          _request('removePersistentRoadblockById', set.sdkIdOf(id)),
+        for (final String id in toAdd) requests[id]!,
+      ],
+    );
+
+    final Map<String, GemError> errors = <String, GemError>{};
+    // Roadblocks removed by the batch, and roadblocks already gone, removed by
+    // the user or expired
+    final List<String> removedIds = <String>[];
+    final List<String> goneIds = <String>[];
+    for (int i = 0; i < toRemove.length; i++) {
+      final GemError error =
+          GemErrorExtension.fromCode(jsonDecode(replies[i])['result']);
+      switch (error) {
+        case GemError.success:
+          removedIds.add(toRemove[i]);
+        case GemError.notFound:
+          goneIds.add(toRemove[i]);
+        default:
+          errors[toRemove[i]] = error;
+      }
+    }
+    final List<String> addedIds = <String>[];
+    for (int i = 0; i < toAdd.length; i++) {
+      final dynamic result =
+          jsonDecode(replies[toRemove.length + i])['result'];
+      final GemError error = GemErrorExtension.fromCode(result['second']);
+      if (error == GemError.success) {
+        _release(result['first']);
+        addedIds.add(toAdd[i]);
+      } else {
+        errors[toAdd[i]] = error;
+      }
+    }
+
+    final Map<String, String> applied = Map<String, String>.of(previous);
+    for (final String id in goneIds) {
+      applied.remove(id);
+    }
+    if (errors.isNotEmpty && atomic) {
+      for (final String id in _rollBack(set, previous, removedIds, addedIds)) {
+        applied.remove(id);
+      }
+      _store(set.name, applied);
+      return PersistentRoadblockSetResult(
+        diff: diff,
+        errors: errors,
+        rolledBack: true,
+        elapsed: stopwatch.elapsed,
+      );
+    }
+
+    // Without rollback, the applied set holds what the SDK holds
+    for (final String id in removedIds) {
+      applied.remove(id);
+    }
+    for (final String id in addedIds) {
+      applied[id] = requests[id]!;
+    }
+    _store(set.name, applied);
+
+    return PersistentRoadblockSetResult(
+      diff: diff,
+      errors: errors,
+      rolledBack: false,
+      elapsed: stopwatch.elapsed,
+    );
+  }
+
+  static void clear() {
+    _applied.clear();
+    _settings
+      ..remove('*')
+      ..flush();
+  }
+
+  static PersistentRoadblockSetResult remove(final String name) {
+    final Stopwatch stopwatch = Stopwatch()..start();
+    final Map<String, String> previous = _appliedOf(name);
+    final List<String> ids = previous.keys.toList();
+    final List<String> replies = GemKitPlatform.instance.callObjectMethodBatch(
+      ids
+          .map(
+            (final String id) =>
+                _request('removePersistentRoadblockById', '$name/$id'),
+          )
+          .toList(),
+    );
+
+    // The roadblocks which could not be removed stay in the applied set, so
+    // that they are removed by the next call
+    final Map<String, String> applied = <String, String>{};
+    final Map<String, GemError> errors = <String, GemError>{};
+    for (int i = 0; i < ids.length; i++) {
+      final GemError error =
+          GemErrorExtension.fromCode(jsonDecode(replies[i])['result']);
+      if (error != GemError.success && error != GemError.notFound) {
+        errors[ids[i]] = error;
+        applied[ids[i]] = previous[ids[i]]!;
+      }
+    }
+    _store(name, applied);
+
+    return PersistentRoadblockSetResult(
+      diff: PersistentRoadblockSetDiff(
+        added: <String>[],
+        removed: ids,
+        changed: <String>[],
+        unchanged: <String>[],
+      ),
+      errors: errors,
+      rolledBack: false,
+      elapsed: stopwatch.elapsed,
+    );
+  }
+
+  static PersistentRoadblockSetDiff _diff(
+    final PersistentRoadblockSet set,
+    final Map<String, String> requests,
+    final Map<String, String> previous,
+  ) {
+    // The SDK is checked for every roadblock: some may have been removed one by
+    // one or have expired, others may be left without a stored definition
+    final List<String> ids = set.roadblocks.keys.toList();
+    final List<String> replies = GemKitPlatform.instance.callObjectMethodBatch(
+      ids
+          .map(
+            (final String id) =>
+                _request('getPersistentRoadblock', set.sdkIdOf(id)),
+          )
+          .toList(),
+    );
+
+    final List<String> added = <String>[];
+    final List<String> changed = <String>[];
+    final List<String> unchanged = <String>[];
+    for (int i = 0; i < ids.length; i++) {
+      final int eventId = jsonDecode(replies[i])['result'];
+      if (eventId == -1) {
+        added.add(ids[i]);
+        continue;
+      }
+      _release(eventId);
+
+      if (previous[ids[i]] == requests[ids[i]]) {
+        unchanged.add(ids[i]);
+      } else {
+        changed.add(ids[i]);
+      }
+    }
+
+    return PersistentRoadblockSetDiff(
+      added: added,
+      removed: previous.keys
+          .where((final String id) => !set.roadblocks.containsKey(id))
+          .toList(),
+      changed: changed,
+      unchanged: unchanged,
+    );
+  }
+
+  // Removes the added roadblocks and adds the removed ones again with their
+  // previous definition. Returns the ids which could not be restored:
+  // changed roadblocks without a previous definition, and failed additions
+  static List<String> _rollBack(
+    final PersistentRoadblockSet set,
+    final Map<String, String> previous,
+    final List<String> removed,
+    final List<String> added,
+  ) {
+    final List<String> restored =
+        removed.where(previous.containsKey).toList();
+    final List<String> replies = GemKitPlatform.instance.callObjectMethodBatch(
+      <String>[
+        for (final String id in added)
+          _request('removePersistentRoadblockById', set.sdkIdOf(id)),
+        for (final String id in restored) previous[id]!,
+      ],
+    );
+
+    final List<String> lost = removed
+        .where((final String id) => !previous.containsKey(id))
+        .toList();
+    for (int i = 0; i < restored.length; i++) {
+      final dynamic result = jsonDecode(replies[added.length + i])['result'];
+      if (GemErrorExtension.fromCode(result['second']) == GemError.success) {
+        _release(result['first']);
+      } else {
+        lost.add(restored[i]);
+      }
+    }
+    return lost;
+  }
+
+  static Map<String, String> _addRequests(final PersistentRoadblockSet set) =>
+      <String, String>{
+        for (final PersistentRoadblockDefinition roadblock
+            in set.roadblocks.values)
+          roadblock.id: roadblock.addRequest(set.sdkIdOf(roadblock.id)),
+      };
+
+  static SettingsService get _settings =>
+      _settingsService ??= (SettingsService()..beginGroup(_settingsGroup));
+
+  static Map<String, String> _appliedOf(final String name) =>
+      _applied.putIfAbsent(name, () {
+        final String stored = _settings.getString(name);
+        if (stored.isEmpty) {
+          return <String, String>{};
+        }
+        try {
+          return Map<String, String>.from(jsonDecode(stored));
+        } on FormatException {
+          return <String, String>{};
+        }
+      });
+
+  static void _store(final String name, final Map<String, String> applied) {
+    _applied[name] = applied;
+    if (applied.isEmpty) {
+      _settings.remove(name);
+    } else {
+      _settings.setString(name, jsonEncode(applied));
+    }
+    _settings.flush();
+  }
+
+  // The SDK returns a new event object, deleted right away as it is not used
+  static void _release(final int eventId) =>
+      GemKitPlatform.instance.callDeleteObject(
+        jsonEncode(<String, Object>{'class': 'TrafficEvent', 'id': eventId}),
+      );
+
+  static String _request(final String method, final String id) =>
+      jsonEncode(<String, Object>{
+        'id': 0,
+        'class': 'TrafficService',
+        'method': method,
+        'args': id,
+      });
+}
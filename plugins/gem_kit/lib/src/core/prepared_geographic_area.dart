@@ -0,0 +1,482 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/core/coordinates.dart';
+import 'package:gem_kit/src/core/geographic_area.dart';
+import 'package:gem_kit/src/core/packed_geometry.dart';
+
+/// Polygon prepared for repeated containment tests.
+///
+/// The bounding box and the center point are computed once, and the polygon is indexed with a regular grid built once:
+/// * each grid row keeps the edges crossing its latitude range, so a test only looks at the edges near the point
+/// * each grid cell not touched by an edge is known to be fully inside or fully outside the polygon, so most tests do not look at any edge
+///
+/// The results are the same as the ones of [PolygonGeographicArea.containsCoordinates].
+/// The polygon cannot be modified after it is prepared.
+///
+/// {@category Core}
+class PreparedPolygonGeographicArea implements GeographicArea {
+  /// Prepare a polygon.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *polygon* The polygon. Later changes of the polygon are not taken into account.
+  /// * **IN** *gridSize* The number of grid rows and columns. By default it depends on the number of vertices.
+  factory PreparedPolygonGeographicArea(
+    final PolygonGeographicArea polygon, {
+    final int? gridSize,
+  }) {
+    final List<Coordinates> coords = polygon.coordinates;
+    final Float64List latitudes = Float64List(coords.length);
+    final Float64List longitudes = Float64List(coords.length);
+    for (int i = 0; i < coords.length; i++) {
+      latitudes[i] = coords[i].latitude;
+      longitudes[i] = coords[i].longitude;
+    }
+    return PreparedPolygonGeographicArea._(latitudes, longitudes, gridSize);
+  }
+
+  /// Prepare a polygon given as a packed geometry.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *geometry* The vertices of the polygon.
+  /// * **IN** *gridSize* The number of grid rows and columns. By default it depends on the number of vertices.
+  factory PreparedPolygonGeographicArea.fromPackedGeometry(
+    final PackedGeometry geometry, {
+    final int? gridSize,
+  }) {
+    final Float64List latitudes = Float64List(geometry.length);
+    final Float64List longitudes = Float64List(geometry.length);
+    for (int i = 0; i < geometry.length; i++) {
+      latitudes[i] = geometry.latitudeAt(i);
+      longitudes[i] = geometry.longitudeAt(i);
+    }
+    return PreparedPolygonGeographicArea._(latitudes, longitudes, gridSize);
+  }
+
+  PreparedPolygonGeographicArea._(
+    this._latitudes,
+    this._longitudes,
+    final int? gridSize,
+  ) : _gridSize = _latitudes.length < 3
+            ? 1
+            : gridSize ?? sqrt(_latitudes.length).ceil().clamp(4, 256) {
+    _prepare();
+  }
+
+  final Float64List _latitudes;
+  final Float64List _longitudes;
+  final int _gridSize;
+
+  double _minLatitude = 0;
+  double _maxLatitude = 0;
+  double _minLongitude = 0;
+  double _maxLongitude = 0;
+  double _rowScale = 0;
+  double _columnScale = 0;
+
+  // Edges crossing each row, as ranges of _rowEdges given by _rowStarts
+  late final Int32List _rowStarts;
+  late final Int32List _rowEdges;
+
+  // State of each cell: _outside, _inside or _boundary
+  late final Uint8List _cells;
+
+  late final RectangleGeographicArea _boundingBox = RectangleGeographicArea(
+    topLeft: Coordinates(latitude: _maxLatitude, longitude: _minLongitude),
+    bottomRight: Coordinates(latitude: _minLatitude, longitude: _maxLongitude),
+  );
+
+  late final Coordinates _centerPoint =
+      _polygon(_latitudes, _longitudes).centerPoint;
+
+  /// Number of vertices.
+  int get vertexCount => _latitudes.length;
+
+  @override
+  bool containsCoordinates(final Coordinates point) =>
+      contains(point.latitude, point.longitude);
+
+  /// Checks if the specified point is contained within the polygon.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *latitude* The latitude of the point.
+  /// * **IN** *longitude* The longitude of the point.
+  ///
+  /// **Returns**
+  ///
+  /// * True if the point is within the polygon, false otherwise.
+  bool contains(final double latitude, final double longitude) {
+    if (_latitudes.length < 3 ||
+        latitude < _minLatitude ||
+        latitude > _maxLatitude ||
+        longitude < _minLongitude ||
+        longitude > _maxLongitude) {
+      return false;
+    }
+
+    final int row = _rowOf(latitude);
+    final int state = _cells[row * _gridSize + _columnOf(longitude)];
+    if (state != _boundary) {
+      return state == _inside;
+    }
+    return _crossesOdd(row, latitude, longitude);
+  }
+
+  /// Checks which of the given points are contained within the polygon.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *latLons* The points, as interleaved latitudes and longitudes.
+  /// * **OUT** *result* Receives 1 for each point within the polygon, 0 otherwise. Allocated if not provided.
+  ///
+  /// **Returns**
+  ///
+  /// * The result, one value per point.
+  Uint8List containsAll(final Float64List latLons, [final Uint8List? result]) {
+    final int count = latLons.length ~/ 2;
+    final Uint8List out = result ?? Uint8List(count);
+    for (int i = 0; i < count; i++) {
+      out[i] = contains(latLons[2 * i], latLons[2 * i + 1]) ? 1 : 0;
+    }
+    return out;
+  }
+
+  @override
+  RectangleGeographicArea get boundingBox => _boundingBox;
+
+  @override
+  Coordinates get centerPoint => _centerPoint;
+
+  @override
+  bool get isEmpty => _latitudes.isEmpty || _boundingBox.isEmpty;
+
+  @override
+  GeographicAreaType get type => GeographicAreaType.polygon;
+
+  @override
+  Map<String, dynamic> toJson() => _polygon(_latitudes, _longitudes).toJson();
+
+  void _prepare() {
+    final int n = _latitudes.length;
+    if (n > 0) {
+      _minLatitude = _maxLatitude = _latitudes[0];
+      _minLongitude = _maxLongitude = _longitudes[0];
+      for (int i = 1; i < n; i++) {
+        _minLatitude = min(_minLatitude, _latitudes[i]);
+        _maxLatitude = max(_maxLatitude, _latitudes[i]);
+        _minLongitude = min(_minLongitude, _longitudes[i]);
+        _maxLongitude = max(_maxLongitude, _longitudes[i]);
+      }
+    }
+    final double height = _maxLatitude - _minLatitude;
+    final double width = _maxLongitude - _minLongitude;
+    _rowScale = height > 0 ? _gridSize / height : 0;
+    _columnScale = width > 0 ? _gridSize / width : 0;
+
+    // Edge i goes from vertex i - 1 to vertex i, as in PolygonGeographicArea
+    final Int32List counts = Int32List(_gridSize + 1);
+    for (int i = 0; i < n; i++) {
+      final int j = i == 0 ? n - 1 : i - 1;
+      final int first = _rowOf(min(_latitudes[i], _latitudes[j]));
+      final int last = _rowOf(max(_latitudes[i], _latitudes[j]));
+      for (int row = first; row <= last; row++) {
+        counts[row + 1]++;
+      }
+    }
+    for (int row = 0; row < _gridSize; row++) {
+      counts[row + 1] += counts[row];
+    }
+    _rowStarts = counts;
+    _rowEdges = Int32List(counts[_gridSize]);
+
+    final Int32List fill = Int32List.fromList(counts);
+    final Uint8List cells = Uint8List(_gridSize * _gridSize);
+    for (int i = 0; i < n; i++) {
+      final int j = i == 0 ? n - 1 : i - 1;
+      final int firstRow = _rowOf(min(_latitudes[i], _latitudes[j]));
+      final int lastRow = _rowOf(max(_latitudes[i], _latitudes[j]));
+      final int firstColumn = _columnOf(min(_longitudes[i], _longitudes[j]));
+      final int lastColumn = _columnOf(max(_longitudes[i], _longitudes[j]));
+      for (int row = firstRow; row <= lastRow; row++) {
+        _rowEdges[fill[row]++] = i;
+        // Cells touched by the bounding box of the edge may contain the edge
+        for (int column = firstColumn; column <= lastColumn; column++) {
+          cells[row * _gridSize + column] = _boundary;
+        }
+      }
+    }
+
+    // A cell not touched by any edge is entirely inside or outside, as its
+    // center
+    for (int row = 0; row < _gridSize; row++) {
+      final double latitude = _rowScale == 0
+          ? _minLatitude
+          : _minLatitude + (row + 0.5) / _rowScale;
+      for (int column = 0; column < _gridSize; column++) {
+        final int cell = row * _gridSize + column;
+        if (cells[cell] == _boundary) {
+          continue;
+        }
+        final double longitude = _columnScale == 0
+            ? _minLongitude
+            : _minLongitude + (column + 0.5) / _columnScale;
+        cells[cell] =
+            _crossesOdd(_rowOf(latitude), latitude, longitude) ? _inside : 0;
+      }
+    }
+    _cells = cells;
+  }
+
+  bool _crossesOdd(
+    final int row,
+    final double latitude,
+    final double longitude,
+  ) {
+    final int n = _latitudes.length;
+    bool status = false;
+    for (int e = _rowStarts[row]; e < _rowStarts[row + 1]; e++) {
+      final int i = _rowEdges[e];
+      final int j = i == 0 ? n - 1 : i - 1;
+      final double latI = _latitudes[i];
+      final double latJ = _latitudes[j];
+      if ((latI > latitude) != (latJ > latitude)) {
+        final double intersectLongitude = (latitude - latI) *
+                (_longitudes[j] - _longitudes[i]) /
+                (latJ - latI) +
+            _longitudes[i];
+        if (longitude < intersectLongitude) {
+          status = !status;
+        }
+      }
+    }
+    return status;
+  }
+
+  int _rowOf(final double latitude) =>
+      ((latitude - _minLatitude) * _rowScale).floor().clamp(0, _gridSize - 1);
+
+  int _columnOf(final double longitude) =>
+      ((longitude - _minLongitude) * _columnScale)
+          .floor()
+          .clamp(0, _gridSize - 1);
+
+  static PolygonGeographicArea _polygon(
+    final Float64List latitudes,
+    final Float64List longitudes,
+  ) =>
+      PolygonGeographicArea(
+        coordinates: List<Coordinates>.generate(
+          latitudes.length,
+          (final int i) =>
+              Coordinates(latitude: latitudes[i], longitude: longitudes[i]),
+        ),
+      );
+
+  static const int _inside = 1;
+  static const int _boundary = 2;
+}
+
+/// Set of prepared polygons, indexed for testing many points against many polygons.
+///
+/// {@category Core}
+class PreparedPolygonCollection {
+  /// Create a collection.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *polygons* The polygons. The index of a polygon in this list identifies it in the results.
+  /// * **IN** *gridSize* The number of rows and columns of the grid indexing the bounding boxes of the polygons.
+  PreparedPolygonCollection(this.polygons, {final int gridSize = 64})
+      : _gridSize = gridSize {
+    _prepare();
+  }
+
+  /// The polygons.
+  final List<PreparedPolygonGeographicArea> polygons;
+
+  final int _gridSize;
+  double _minLatitude = 0;
+  double _minLongitude = 0;
+  double _rowScale = 0;
+  double _columnScale = 0;
+  late final Int32List _cellStarts;
+  late final Int32List _cellPolygons;
+
+  /// Get the polygons containing a point.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *latitude* The latitude of the point.
+  /// * **IN** *longitude* The longitude of the point.
+  ///
+  /// **Returns**
+  ///
+  /// * The indexes of the polygons containing the point, in increasing order.
+  List<int> polygonsContaining(final double latitude, final double longitude) {
+    final List<int> result = <int>[];
+    final int cell = _cellOf(latitude, longitude);
+    if (cell < 0) {
+      return result;
+    }
+    for (int k = _cellStarts[cell]; k < _cellStarts[cell + 1]; k++) {
+      final int polygon = _cellPolygons[k];
+      if (polygons[polygon].contains(latitude, longitude)) {
+        result.add(polygon);
+      }
+    }
+    return result;
+  }
+
+  /// Get, for each point, the first polygon containing it.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *latLons* The points, as interleaved latitudes and longitudes.
+  ///
+  /// **Returns**
+  ///
+  /// * For each point, the lowest index of a polygon containing it, or -1 if no polygon contains it.
+  Int32List firstContaining(final Float64List latLons) {
+    final int count = latLons.length ~/ 2;
+    final Int32List result = Int32List(count)..fillRange(0, count, -1);
+    for (int i = 0; i < count; i++) {
+      final double latitude = latLons[2 * i];
+      final double longitude = latLons[2 * i + 1];
+      final int cell = _cellOf(latitude, longitude);
+      if (cell < 0) {
+        continue;
+      }
+      for (int k = _cellStarts[cell]; k < _cellStarts[cell + 1]; k++) {
+        final int polygon = _cellPolygons[k];
+        if (polygons[polygon].contains(latitude, longitude)) {
+          result[i] = polygon;
+          break;
+        }
+      }
+    }
+    return result;
+  }
+
+  /// Get all the (point, polygon) pairs where the polygon contains the point.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *latLons* The points, as interleaved latitudes and longitudes.
+  ///
+  /// **Returns**
+  ///
+  /// * Interleaved point indexes and polygon indexes, ordered by point and then by polygon.
+  Int32List containingPairs(final Float64List latLons) {
+    final int count = latLons.length ~/ 2;
+    Int32List pairs = Int32List(max(count * 2, 16));
+    int length = 0;
+    for (int i = 0; i < count; i++) {
+      final double latitude = latLons[2 * i];
+      final double longitude = latLons[2 * i + 1];
+      final int cell = _cellOf(latitude, longitude);
+      if (cell < 0) {
+        continue;
+      }
+      for (int k = _cellStarts[cell]; k < _cellStarts[cell + 1]; k++) {
+        final int polygon = _cellPolygons[k];
+        if (!polygons[polygon].contains(latitude, longitude)) {
+          continue;
+        }
+        if (length == pairs.length) {
+          pairs = Int32List(pairs.length * 2)..setRange(0, length, pairs);
+        }
+        pairs[length++] = i;
+        pairs[length++] = polygon;
+      }
+    }
+    return Int32List.sublistView(pairs, 0, length);
+  }
+
+  void _prepare() {
+    double minLatitude = double.infinity;
+    double maxLatitude = double.negativeInfinity;
+    double minLongitude = double.infinity;
+    double maxLongitude = double.negativeInfinity;
+    for (final PreparedPolygonGeographicArea polygon in polygons) {
+      if (polygon.vertexCount < 3) {
+        continue;
+      }
+      minLatitude = min(minLatitude, polygon._minLatitude);
+      maxLatitude = max(maxLatitude, polygon._maxLatitude);
+      minLongitude = min(minLongitude, polygon._minLongitude);
+      maxLongitude = max(maxLongitude, polygon._maxLongitude);
+    }
+    if (minLatitude.isFinite) {
+      _minLatitude = minLatitude;
+      _minLongitude = minLongitude;
+      final double height = maxLatitude - minLatitude;
+      final double width = maxLongitude - minLongitude;
+      _rowScale = height > 0 ? _gridSize / height : 0;
+      _columnScale = width > 0 ? _gridSize / width : 0;
+    }
+
+    final int cellCount = _gridSize * _gridSize;
+    final Int32List counts = Int32List(cellCount + 1);
+    void forEachCell(final int polygon, final void Function(int cell) visit) {
+      final PreparedPolygonGeographicArea area = polygons[polygon];
+      if (area.vertexCount < 3) {
+        return;
+      }
+      final int firstRow = _rowOf(area._minLatitude);
+      final int lastRow = _rowOf(area._maxLatitude);
+      final int firstColumn = _columnOf(area._minLongitude);
+      final int lastColumn = _columnOf(area._maxLongitude);
+      for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+          visit(row * _gridSize + column);
+        }
+      }
+    }
+
+    for (int p = 0; p < polygons.length; p++) {
+      forEachCell(p, (final int cell) => counts[cell + 1]++);
+    }
+    for (int cell = 0; cell < cellCount; cell++) {
+      counts[cell + 1] += counts[cell];
+    }
+    _cellStarts = counts;
+    _cellPolygons = Int32List(counts[cellCount]);
+    final Int32List fill = Int32List.fromList(counts);
+    for (int p = 0; p < polygons.length; p++) {
+      forEachCell(p, (final int cell) => _cellPolygons[fill[cell]++] = p);
+    }
+  }
+
+  int _cellOf(final double latitude, final double longitude) {
+    if (_cellPolygons.isEmpty ||
+        latitude < _minLatitude ||
+        longitude < _minLongitude ||
+        (_rowScale > 0 && latitude > _minLatitude + _gridSize / _rowScale) ||
+        (_columnScale > 0 &&
+            longitude > _minLongitude + _gridSize / _columnScale)) {
+      return -1;
+    }
+    return _rowOf(latitude) * _gridSize + _columnOf(longitude);
+  }
+
+  int _rowOf(final double latitude) =>
+      ((latitude - _minLatitude) * _rowScale).floor().clamp(0, _gridSize - 1);
+
+  int _columnOf(final double longitude) =>
+      ((longitude - _minLongitude) * _columnScale)
+          .floor()
+          .clamp(0, _gridSize - 1);
+}
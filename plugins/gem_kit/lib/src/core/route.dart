@@ -291,7 +291,10 @@ class RouteInstructionBase extends GemAutoreleaseObject {
 
   @internal
   RouteInstructionBase.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'RouteInstructionBase',
+    );
   }
   final int _pointerId;
 
@@ -854,12 +857,7 @@ class RouteInstructionBase extends GemAutoreleaseObject {
     return resultString['result'];
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'RouteInstructionBase',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('RouteInstructionBase', _pointerId);
 }
 
 /// Route instruction class
@@ -965,9 +963,7 @@ class RouteSegment extends RouteSegmentBase {
     return PTRouteSegment(resultString['result']);
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{'class': 'RouteSegment', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('RouteSegment', _pointerId);
 }
 
 /// This class will not be documented.
@@ -1333,6 +1329,89 @@ abstract class RouteBase extends GemAutoreleaseObject {
     return Path.init(resultString['result']);
   }
 
+  /// Get the route geometry as a packed array.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *includeAltitude* Store the altitude of each point.
+  /// * **IN** *includeDistance* Store the cumulative distance in meters of each point from the route start.
+  /// * **IN** *simplifyTolerance* If greater than 0, the geometry is simplified using the Douglas-Peucker algorithm with the given tolerance in meters.
+  ///
+  /// **Returns**
+  ///
+  /// * The packed geometry, see [Path.getPackedCoordinates]. Null if the route path cannot be built.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  PackedGeometry? getPackedGeometry({
+    final bool includeAltitude = false,
+    final bool includeDistance = false,
+    final double simplifyTolerance = 0,
+  }) {
+    final Path? path = getPath(
+      0,
+      getTimeDistance(activePart: false).totalDistanceM,
+    );
+    if (path == null) {
+      return null;
+    }
+
+    try {
+      return path.getPackedCoordinates(
+        includeAltitude: includeAltitude,
+        includeDistance: includeDistance,
+        simplifyTolerance: simplifyTolerance,
+      );
+    } finally {
+      path.dispose();
+    }
+  }
+
+  /// Export the route geometry in the encoded polyline algorithm format.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *simplifyTolerance* If greater than 0, the geometry is simplified using the Douglas-Peucker algorithm with the given tolerance in meters.
+  /// * **IN** *precision* Number of decimals kept for each value. Use 5 for the common format and 6 for the high precision variant.
+  ///
+  /// **Returns**
+  ///
+  /// * The encoded polyline. Empty if the route path cannot be built.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  String toEncodedPolyline({
+    final double simplifyTolerance = 0,
+    final int precision = 5,
+  }) {
+    return getPackedGeometry(simplifyTolerance: simplifyTolerance)
+            ?.toEncodedPolyline(precision: precision) ??
+        '';
+  }
+
+  /// Get polygon area of the route as a packed array.
+  ///
+  /// Unlike [polygonGeographicArea], no [Coordinates] object is created for each vertex.
+  ///
+  /// **Returns**
+  ///
+  /// * The packed polygon vertices
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  PackedGeometry get packedPolygonGeographicArea {
+    final OperationResult resultString = objectMethod(
+      _pointerId,
+      'RouteBase',
+      'getPolygonGeographicArea',
+    );
+
+    return PackedGeometry.fromJson(resultString['result']);
+  }
+
   /// Get polygon area of the route.
   ///
   /// **Returns**
@@ -1524,6 +1603,102 @@ abstract class RouteBase extends GemAutoreleaseObject {
         .toList();
   }
 
+  /// Sample timestamp coordinates from a route in pages.
+  ///
+  /// Same sampling as [getTimeDistanceCoordinates], but the interval is requested in consecutive sub-ranges and each one is delivered as a packed [TimeDistanceCoordinatePage].
+  /// The stream yields to the event loop between pages so that long samplings do not block the UI.
+  ///
+  /// For [StepType.time] the pages are split on distance boundaries estimated from the route average speed, so the sampling phase restarts at the beginning of each page.
+  ///
+  /// The SDK returns distances and time stamps relative to the start of each requested sub-range. Every page is shifted by the same rule:
+  /// distances by the page start distance, so they are measured from the route start, and time stamps by the time stamp of the previous page's last record, so they are measured from [start].
+  /// Consecutive pages share their boundary record, which is kept only in the first of them.
+  /// Each page is one synchronous bridge call, only the pages are spread over the event loop.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *start* 	Start distance from route start.
+  /// * **IN** *end* 	End distance from route start.
+  /// * **IN** *step* The step on which the coordinates are created.
+  /// * **IN** *stepType* The step unit type. See [StepType]
+  /// * **IN** *pageSize* The approximate number of records in each page.
+  ///
+  /// **Returns**
+  ///
+  /// * The stream of pages. The last page has [TimeDistanceCoordinatePage.isLast] set.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  Stream<TimeDistanceCoordinatePage> getTimeDistanceCoordinatesPaged({
+    required final int start,
+    required final int end,
+    required final int step,
+    required final StepType stepType,
+    final int pageSize = 1000,
+  }) async* {
+    if (step <= 0 || end <= start) {
+      yield TimeDistanceCoordinatePage(Float64List(0), isLast: true);
+      return;
+    }
+
+    int pageLength;
+    if (stepType == StepType.distance) {
+      pageLength = step * pageSize;
+    } else {
+      final TimeDistance total = getTimeDistance(activePart: false);
+      final double speed =
+          total.totalTimeS > 0 ? total.totalDistanceM / total.totalTimeS : 1;
+      pageLength = (step * pageSize * speed).ceil();
+    }
+    if (pageLength <= 0) {
+      pageLength = end - start;
+    }
+
+    int pageStart = start;
+    int lastDistance = -1;
+    int lastStamp = 0;
+    while (pageStart < end) {
+      final int pageEnd =
+          pageStart + pageLength < end ? pageStart + pageLength : end;
+      final bool isLast = pageEnd >= end;
+
+      final OperationResult resultString = objectMethod(
+        _pointerId,
+        'RouteBase',
+        'getTimeDistanceCoordinates',
+        args: <String, Object>{
+          'start': pageStart,
+          'end': pageEnd,
+          'step': step,
+          'stepType': stepType == StepType.distance,
+        },
+      );
+
+      // Distances and stamps are relative to the requested sub-range, whose
+      // first record is the last record of the previous page
+      final TimeDistanceCoordinatePage page =
+          TimeDistanceCoordinatePage.fromJson(
+        resultString['result'],
+        isLast: isLast,
+        distanceOffset: pageStart,
+        stampOffset: lastStamp,
+        skipUntilDistance: lastDistance,
+      );
+      if (page.length > 0) {
+        lastDistance = page.distanceAt(page.length - 1);
+        lastStamp = page.stampAt(page.length - 1);
+      }
+
+      yield page;
+
+      pageStart = pageEnd;
+      if (!isLast) {
+        await Future<void>.delayed(Duration.zero);
+      }
+    }
+  }
+
   /// Get a time-distance coordinate on route closest to the given reference coordinate.
   ///
   /// **Parameters**
@@ -1572,6 +1747,26 @@ abstract class RouteBase extends GemAutoreleaseObject {
     return RouteTrafficEventList.init(resultString['result']).toList();
   }
 
+  /// Get the traffic events affecting the route as packed columns.
+  ///
+  /// The values of all the events are read with a single batch of calls. See [TrafficEventSnapshot].
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *filter* The filter of the events. All the events are kept if null.
+  ///
+  /// **Returns**
+  ///
+  /// * The snapshot of the traffic events
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  TrafficEventSnapshot getTrafficEventSnapshot({
+    final TrafficEventFilter? filter,
+  }) =>
+      TrafficEventSnapshot.fromRoute(this, filter: filter);
+
   /// Get list of route waypoints.
   ///
   /// The waypoints are ordered like: departure, first waypoint, ..., destination.
@@ -1938,9 +2133,7 @@ class Route extends RouteBase {
     return PTRoute.init(resultString['result']);
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, dynamic>{'class': 'Route', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('Route', _pointerId);
 }
 
 /// Electric vehicle route instruction class
@@ -2094,9 +2287,7 @@ class EVRoute extends RouteBase {
     return resultString['result'];
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, dynamic>{'class': 'EVRoute', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('EVRoute', _pointerId);
 }
 
 /// Public transport route class
@@ -2850,10 +3041,7 @@ class EVRouteSegment extends RouteSegmentBase {
     return resultString['result'];
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(
-            <String, Object>{'class': 'EVRouteSegment', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('EVRouteSegment', _pointerId);
 }
 
 /// Public transport buy ticket information class.
@@ -2861,7 +3049,7 @@ class EVRouteSegment extends RouteSegmentBase {
 /// {@category Routes & Navigation}
 class PTBuyTicketInformation extends GemAutoreleaseObject {
   PTBuyTicketInformation(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: 'PTBuyTicketInformation');
   }
   final int _pointerId;
   int get pointerId => _pointerId;
@@ -2904,12 +3092,7 @@ class PTBuyTicketInformation extends GemAutoreleaseObject {
     return List<int>.from(resultString['result']);
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'PTBuyTicketInformation',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('PTBuyTicketInformation', _pointerId);
 }
 
 /// Public transport route instruction class.
@@ -28,7 +28,7 @@ class RouteBookmarks extends GemAutoreleaseObject {
 
   @internal
   RouteBookmarks.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(pointerId);
+    super.registerAutoReleaseObject(pointerId, className: 'RouteBookmarks');
   }
   final int _pointerId;
 
@@ -416,10 +416,7 @@ class RouteBookmarks extends GemAutoreleaseObject {
     return RouteBookmarks.init(decodedVal['result']);
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(
-            <String, Object>{'class': 'RouteBookmarks', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('RouteBookmarks', _pointerId);
 }
 
 /// Enumeration used to specify the sort order of the routes
@@ -31,7 +31,7 @@ class SignpostDetails extends GemAutoreleaseObject {
 
   @internal
   SignpostDetails.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'SignpostDetails');
   }
   final int _pointerId;
 
@@ -222,14 +222,7 @@ class SignpostDetails extends GemAutoreleaseObject {
     return SignpostItemList.init(resultString['result']).toList();
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'SignpostDetails',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('SignpostDetails', _pointerId);
 }
 
 /// SignpostItem object.
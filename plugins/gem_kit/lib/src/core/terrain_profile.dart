@@ -10,8 +10,10 @@
 
 import 'dart:convert';
 
+import 'package:flutter/foundation.dart' show compute;
 import 'package:gem_kit/core.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
+import 'package:gem_kit/src/core/packed_terrain_profile.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:meta/meta.dart';
 
@@ -27,7 +29,10 @@ class RouteTerrainProfile extends GemAutoreleaseObject {
 
   @internal
   RouteTerrainProfile.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'RouteTerrainProfile',
+    );
   }
   final int _pointerId;
 
@@ -158,6 +163,131 @@ class RouteTerrainProfile extends GemAutoreleaseObject {
     return (listFloat, sample);
   }
 
+  /// Get the whole terrain profile as packed data.
+  ///
+  /// The elevation samples are stored in a [Float32List] and the sections in packed tables, without creating an object for each value.
+  /// Use [getPackedProfileAsync] for long routes, to decode the profile off the UI isolate.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *countSamples* Number of elevation samples.
+  /// * **IN** *distBegin* Begin distance on route for sample interval. If not provided, the whole route is sampled.
+  /// * **IN** *distEnd* End distance on route for sample interval. Must be provided with [distBegin].
+  /// * **IN** *steepCategories* The steep categories, see [getSteepSections]. If not provided, the steep sections are not computed.
+  ///
+  /// **Returns**
+  ///
+  /// * The packed terrain profile. The elevation samples are empty for invalid parameters.
+  ///
+  /// The SDK errors are not thrown, the error of the last SDK call is available from [ApiErrorService.apiError].
+  ///
+  /// **Throws**
+  ///
+  /// * [GemKitUninitializedException] if the SDK is not initialized.
+  PackedTerrainProfile getPackedProfile(
+    final int countSamples, {
+    final int? distBegin,
+    final int? distEnd,
+    final List<double>? steepCategories,
+  }) =>
+      PackedTerrainProfile.decode(
+        _packedProfileReplies(
+          countSamples,
+          distBegin,
+          distEnd,
+          steepCategories,
+        ),
+      );
+
+  /// Get the whole terrain profile as packed data, decoded off the UI isolate.
+  ///
+  /// Same as [getPackedProfile], but only the SDK calls run on the calling isolate. The replies are decoded on a background isolate, except on web.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *countSamples* Number of elevation samples.
+  /// * **IN** *distBegin* Begin distance on route for sample interval. If not provided, the whole route is sampled.
+  /// * **IN** *distEnd* End distance on route for sample interval. Must be provided with [distBegin].
+  /// * **IN** *steepCategories* The steep categories, see [getSteepSections]. If not provided, the steep sections are not computed.
+  ///
+  /// **Returns**
+  ///
+  /// * The packed terrain profile. The elevation samples are empty for invalid parameters.
+  ///
+  /// The SDK errors are not thrown, the error of the last SDK call is available from [ApiErrorService.apiError].
+  ///
+  /// **Throws**
+  ///
+  /// * [GemKitUninitializedException] if the SDK is not initialized.
+  Future<PackedTerrainProfile> getPackedProfileAsync(
+    final int countSamples, {
+    final int? distBegin,
+    final int? distEnd,
+    final List<double>? steepCategories,
+  }) =>
+      compute(
+        PackedTerrainProfile.decode,
+        _packedProfileReplies(
+          countSamples,
+          distBegin,
+          distEnd,
+          steepCategories,
+        ),
+      );
+
+  PackedTerrainProfileReplies _packedProfileReplies(
+    final int countSamples,
+    final int? distBegin,
+    final int? distEnd,
+    final List<double>? steepCategories,
+  ) {
+    // Undecoded replies, so that decoding can be moved to another isolate
+    final List<String> replies =
+        GemKitPlatform.instance.callObjectMethodBatch(<String>[
+      if (distBegin != null && distEnd != null)
+        _request(
+          'getElevationSamplesBE',
+          args: <String, int>{
+            'countSamples': countSamples,
+            'distBegin': distBegin,
+            'distEnd': distEnd,
+          },
+        )
+      else
+        _request('getElevationSamples', args: countSamples),
+      _request('getMinElevation'),
+      _request('getMaxElevation'),
+      _request('getTotalUp'),
+      _request('getTotalDown'),
+      _request('getClimbSections'),
+      _request('getSurfaceSections'),
+      _request('getRoadTypeSections'),
+      if (steepCategories != null)
+        _request('getSteepSections', args: steepCategories),
+    ]);
+
+    return PackedTerrainProfileReplies(
+      startDistance: distBegin != null && distEnd != null ? distBegin : 0,
+      samples: replies[0],
+      minElevation: replies[1],
+      maxElevation: replies[2],
+      totalUp: replies[3],
+      totalDown: replies[4],
+      climbSections: replies[5],
+      surfaceSections: replies[6],
+      roadTypeSections: replies[7],
+      steepSections: steepCategories != null ? replies[8] : null,
+    );
+  }
+
+  String _request(final String method, {final Object? args}) =>
+      jsonEncode(<String, Object>{
+        'id': _pointerId,
+        'class': 'RouteTerrainProfile',
+        'method': method,
+        'args': args ?? <String, dynamic>{},
+      });
+
   /// Get terrain maximum elevation.
   ///
   /// **Returns**
@@ -435,12 +565,7 @@ class RouteTerrainProfile extends GemAutoreleaseObject {
     return result;
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'RouteTerrainProfile',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('RouteTerrainProfile', _pointerId);
 }
 
 /// Climb grade - UCI based, see https://bicycles.stackexchange.com/questions/1210/how-are-the-categories-for-climbs-decided
@@ -8,7 +8,10 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
+import 'dart:typed_data';
+
 import 'package:gem_kit/src/core/coordinates.dart';
+import 'package:meta/meta.dart';
 
 /// Timestamp & distance & coordinates structure
 ///
@@ -68,3 +71,78 @@ class TimeDistanceCoordinate {
     return coords.hashCode ^ distance.hashCode ^ stamp.hashCode;
   }
 }
+
+/// Page of time-distance coordinates stored as packed records.
+///
+/// Each record is stored as `distance, stamp, latitude, longitude` in [records]. The distances are measured from the route start and the time stamps from the start of the sampling.
+///
+/// {@category Core}
+class TimeDistanceCoordinatePage {
+  @internal
+  TimeDistanceCoordinatePage(this.records, {required this.isLast});
+
+  @internal
+  factory TimeDistanceCoordinatePage.fromJson(
+    final List<dynamic> json, {
+    required final bool isLast,
+    final int distanceOffset = 0,
+    final int stampOffset = 0,
+    final int skipUntilDistance = -1,
+  }) {
+    final Float64List records = Float64List(json.length * recordSize);
+    int offset = 0;
+    for (final dynamic item in json) {
+      final int distance = item['distance'] + distanceOffset;
+      if (distance <= skipUntilDistance) {
+        continue;
+      }
+      final dynamic coords = item['coords'];
+      records[offset++] = distance.toDouble();
+      records[offset++] = (item['stamp'] as num).toDouble() + stampOffset;
+      records[offset++] = (coords['latitude'] as num).toDouble();
+      records[offset++] = (coords['longitude'] as num).toDouble();
+    }
+
+    return TimeDistanceCoordinatePage(
+      offset == records.length
+          ? records
+          : Float64List.sublistView(records, 0, offset),
+      isLast: isLast,
+    );
+  }
+
+  /// Number of values stored for each record.
+  static const int recordSize = 4;
+
+  /// Packed records.
+  final Float64List records;
+
+  /// True if this is the last page of the sampling.
+  final bool isLast;
+
+  /// Number of records in the page.
+  int get length => records.length ~/ recordSize;
+
+  /// Distance in meters from the route start of the record at [index].
+  int distanceAt(final int index) => records[index * recordSize].toInt();
+
+  /// Time stamp in milliseconds from the start of the sampling of the record at [index].
+  int stampAt(final int index) => records[index * recordSize + 1].toInt();
+
+  /// Latitude of the record at [index].
+  double latitudeAt(final int index) => records[index * recordSize + 2];
+
+  /// Longitude of the record at [index].
+  double longitudeAt(final int index) => records[index * recordSize + 3];
+
+  /// Get the record at [index] as a [TimeDistanceCoordinate] object.
+  TimeDistanceCoordinate operator [](final int index) =>
+      TimeDistanceCoordinate(
+        coords: Coordinates(
+          latitude: latitudeAt(index),
+          longitude: longitudeAt(index),
+        ),
+        distance: distanceAt(index),
+        stamp: stampAt(index),
+      );
+}
@@ -79,7 +79,7 @@ class TimezoneResult extends GemAutoreleaseObject {
 
   @internal
   TimezoneResult.init(this.pointerId) {
-    super.registerAutoReleaseObject(pointerId);
+    super.registerAutoReleaseObject(pointerId, className: 'TimezoneResult');
   }
 
   @internal
@@ -169,11 +169,7 @@ class TimezoneResult extends GemAutoreleaseObject {
     return retVal;
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{'class': 'TimezoneResult', 'id': pointerId}),
-    );
-  }
+  void dispose() => disposeNative('TimezoneResult', pointerId);
 }
 
 /// Timezone Service class
@@ -8,7 +8,6 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
 import 'dart:typed_data';
 import 'dart:ui';
 
@@ -16,6 +15,7 @@ import 'package:gem_kit/core.dart';
 import 'package:gem_kit/src/core/event_driven_progress_listener.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/core/lists.dart';
+import 'package:gem_kit/src/core/persistent_roadblock_set.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:gem_kit/src/routing/routing_preferences.dart';
 import 'package:meta/meta.dart';
@@ -604,12 +604,7 @@ class RouteTrafficEvent extends TrafficEvent {
     objectMethod(_pointerId, 'RouteTrafficEvent', 'cancelUpdate');
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'RouteTrafficEvent',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('RouteTrafficEvent', _pointerId);
 }
 
 /// Affected transport modes for traffic events
@@ -1541,6 +1536,68 @@ abstract class TrafficService {
     return GemErrorExtension.fromCode(resultString['result']);
   }
 
+  /// Apply a named set of persistent roadblocks, replacing the set previously applied with the same name
+  ///
+  /// Only the differences with the previous set are applied: the removed and changed roadblocks are removed, the added and changed roadblocks are added.
+  /// All the changes are sent to the SDK in a single batch of calls.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *set* The roadblock set
+  /// * **IN** *atomic* If true, all the changes are reverted when one of them fails, and the previous set stays active
+  ///
+  /// **Returns**
+  ///
+  /// * The applied differences, the errors by roadblock id and the time taken
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails
+  static PersistentRoadblockSetResult replacePersistentRoadblockSet(
+    PersistentRoadblockSet set, {
+    bool atomic = true,
+  }) {
+    return PersistentRoadblockSets.replace(set, atomic: atomic);
+  }
+
+  /// Get the differences between a set of persistent roadblocks and the set currently applied with the same name
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *set* The roadblock set
+  ///
+  /// **Returns**
+  ///
+  /// * The differences which [replacePersistentRoadblockSet] would apply
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails
+  static PersistentRoadblockSetDiff diffPersistentRoadblockSet(
+    PersistentRoadblockSet set,
+  ) {
+    return PersistentRoadblockSets.diff(set);
+  }
+
+  /// Remove all the roadblocks of a named set applied with [replacePersistentRoadblockSet]
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *name* The set name
+  ///
+  /// **Returns**
+  ///
+  /// * The removed roadblocks, the errors by roadblock id and the time taken
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails
+  static PersistentRoadblockSetResult removePersistentRoadblockSet(
+    String name,
+  ) {
+    return PersistentRoadblockSets.remove(name);
+  }
+
   /// Remove all user persistent roadblock
   ///
   /// **Throws**
@@ -1551,6 +1608,7 @@ abstract class TrafficService {
       'TrafficService',
       'removeAllPersistentRoadblocks',
     );
+    PersistentRoadblockSets.clear();
   }
 
   /// Get an user persistent roadblock identified by id
@@ -0,0 +1,521 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+import 'package:meta/meta.dart';
+
+/// Filter of the events of a [TrafficEventSnapshot].
+///
+/// An event is kept if it matches all the given criteria.
+///
+/// {@category Routes & Navigation}
+class TrafficEventFilter {
+  /// Create a filter.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *area* Keep the events whose bounding box intersects the area. All the events are kept if null.
+  /// * **IN** *severities* Keep the events with one of these severities. All the events are kept if null.
+  /// * **IN** *classes* Keep the events with one of these classes. All the events are kept if null.
+  const TrafficEventFilter({this.area, this.severities, this.classes});
+
+  /// The area the events must intersect.
+  final RectangleGeographicArea? area;
+
+  /// The accepted severities.
+  final Set<TrafficEventSeverity>? severities;
+
+  /// The accepted classes.
+  final Set<TrafficEventClass>? classes;
+}
+
+/// Traffic events stored as packed columns.
+///
+/// All the values of the events are read from the SDK at creation, with a single batch of calls, so reading the snapshot does not call the SDK.
+/// The event at index `i` has its values at index `i` of each column. The bounding boxes and the end points are stored as records of [recordSize] values.
+///
+/// Obtained with [TrafficEventSnapshot.fromRoute], [RouteBase.getTrafficEventSnapshot] or [TrafficEventSnapshot.fromEvents].
+///
+/// {@category Routes & Navigation}
+class TrafficEventSnapshot {
+  @internal
+  TrafficEventSnapshot({
+    required this.events,
+    required this.descriptions,
+    required this.delays,
+    required this.lengths,
+    required this.severities,
+    required this.classes,
+    required this.boundingBoxes,
+    required this.endPoints,
+    required this.distancesToDestination,
+  });
+
+  /// Create a snapshot of the traffic events affecting a route.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *route* The route.
+  /// * **IN** *filter* The filter of the events. All the events are kept if null.
+  ///
+  /// **Returns**
+  ///
+  /// * The snapshot
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  factory TrafficEventSnapshot.fromRoute(
+    final RouteBase route, {
+    final TrafficEventFilter? filter,
+  }) =>
+      TrafficEventSnapshot.fromEvents(route.trafficEvents, filter: filter);
+
+  /// Create a snapshot of traffic events.
+  ///
+  /// Used for the events obtained from [TrafficService.persistentRoadblocks] or [GemView.cursorSelectionTrafficEvents].
+  /// The end points and the distance to destination are only available for [RouteTrafficEvent] objects.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *events* The events.
+  /// * **IN** *filter* The filter of the events. All the events are kept if null.
+  ///
+  /// **Returns**
+  ///
+  /// * The snapshot
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  factory TrafficEventSnapshot.fromEvents(
+    final List<TrafficEvent> events, {
+    final TrafficEventFilter? filter,
+  }) {
+    final List<String> requests = <String>[];
+    for (final TrafficEvent event in events) {
+      final int id = event.pointerId;
+      requests
+        ..add(_request(id, 'TrafficEvent', 'getEventClass'))
+        ..add(_request(id, 'TrafficEvent', 'getEventSeverity'))
+        ..add(_request(id, 'TrafficEvent', 'getBoundingBox'))
+        ..add(_request(id, 'TrafficEvent', 'getDelay'))
+        ..add(_request(id, 'TrafficEvent', 'getLength'))
+        ..add(_request(id, 'TrafficEvent', 'getDescription'));
+      if (event is RouteTrafficEvent) {
+        requests
+          ..add(_request(id, 'RouteTrafficEvent', 'getFrom'))
+          ..add(_request(id, 'RouteTrafficEvent', 'getTo'))
+          ..add(
+            _request(id, 'RouteTrafficEvent', 'getDistanceToDestination'),
+          );
+      }
+    }
+    final List<String> replies =
+        GemKitPlatform.instance.callObjectMethodBatch(requests);
+
+    final _SnapshotBuilder builder = _SnapshotBuilder(events.length);
+    int reply = 0;
+    dynamic next() => jsonDecode(replies[reply++])['result'];
+
+    for (final TrafficEvent event in events) {
+      final int eventClass = next();
+      final int severity = next();
+      final dynamic box = next();
+      final bool isRouteEvent = event is RouteTrafficEvent;
+      final int replyCount = isRouteEvent ? 6 : 3;
+
+      if (!_matches(filter, eventClass, severity, box)) {
+        reply += replyCount;
+        continue;
+      }
+
+      builder.add(
+        event: event,
+        eventClass: eventClass,
+        severity: severity,
+        box: box,
+        delay: next(),
+        length: next(),
+        description: next(),
+        from: isRouteEvent ? next() : null,
+        to: isRouteEvent ? next() : null,
+        distanceToDestination: isRouteEvent ? next() : -1,
+      );
+    }
+    return builder.build();
+  }
+
+  /// Number of values of a bounding box or end points record.
+  static const int recordSize = 4;
+
+  /// The events, for the operations not covered by the snapshot.
+  final List<TrafficEvent> events;
+
+  /// The description of each event.
+  final List<String> descriptions;
+
+  /// The delay in seconds of each event. -1 if unknown.
+  final Int32List delays;
+
+  /// The length in meters of each event. -1 if unknown.
+  final Int32List lengths;
+
+  /// The [TrafficEventSeverity] id of each event.
+  final Uint8List severities;
+
+  /// The [TrafficEventClass] id of each event.
+  final Int32List classes;
+
+  /// The bounding box of each event as `top latitude, left longitude, bottom latitude, right longitude`.
+  final Float64List boundingBoxes;
+
+  /// The end points of each event as `from latitude, from longitude, to latitude, to longitude`. (0,0) for the events which are not [RouteTrafficEvent].
+  final Float64List endPoints;
+
+  /// The distance in meters to the route destination of each event. -1 for the events which are not [RouteTrafficEvent].
+  final Int32List distancesToDestination;
+
+  /// Number of events.
+  int get length => descriptions.length;
+
+  /// Check if the snapshot has no events.
+  bool get isEmpty => length == 0;
+
+  /// Get the severity of the event at [index].
+  TrafficEventSeverity severityAt(final int index) =>
+      TrafficEventSeverityExtension.fromId(severities[index]);
+
+  /// Get the class of the event at [index].
+  TrafficEventClass classAt(final int index) =>
+      TrafficEventClassExtension.fromId(classes[index]);
+
+  /// Get the bounding box of the event at [index].
+  RectangleGeographicArea boundingBoxAt(final int index) {
+    final int offset = index * recordSize;
+    return RectangleGeographicArea(
+      topLeft: Coordinates(
+        latitude: boundingBoxes[offset],
+        longitude: boundingBoxes[offset + 1],
+      ),
+      bottomRight: Coordinates(
+        latitude: boundingBoxes[offset + 2],
+        longitude: boundingBoxes[offset + 3],
+      ),
+    );
+  }
+
+  /// Get the start point of the event at [index].
+  Coordinates fromAt(final int index) => Coordinates(
+        latitude: endPoints[index * recordSize],
+        longitude: endPoints[index * recordSize + 1],
+      );
+
+  /// Get the end point of the event at [index].
+  Coordinates toAt(final int index) => Coordinates(
+        latitude: endPoints[index * recordSize + 2],
+        longitude: endPoints[index * recordSize + 3],
+      );
+
+  /// Get the total delay in seconds of the events with a known delay.
+  int get totalDelay {
+    int total = 0;
+    for (final int delay in delays) {
+      if (delay > 0) {
+        total += delay;
+      }
+    }
+    return total;
+  }
+
+  /// Compare with a previous snapshot.
+  ///
+  /// Events are matched by class, description and bounding box, as the SDK objects are recreated when the traffic is refreshed.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *previous* The previous snapshot. All the events are reported as added if null.
+  ///
+  /// **Returns**
+  ///
+  /// * The differences
+  TrafficEventSnapshotDiff diff(final TrafficEventSnapshot? previous) {
+    if (previous == null) {
+      return TrafficEventSnapshotDiff._(
+        previous: null,
+        current: this,
+        added: List<int>.generate(length, (final int i) => i),
+        removed: const <int>[],
+        changed: const <int>[],
+      );
+    }
+
+    final Map<String, List<int>> previousByKey = <String, List<int>>{};
+    for (int i = 0; i < previous.length; i++) {
+      previousByKey.putIfAbsent(previous._keyAt(i), () => <int>[]).add(i);
+    }
+
+    final List<int> added = <int>[];
+    final List<int> changed = <int>[];
+    for (int i = 0; i < length; i++) {
+      final List<int>? candidates = previousByKey[_keyAt(i)];
+      if (candidates == null || candidates.isEmpty) {
+        added.add(i);
+        continue;
+      }
+      final int match = candidates.removeLast();
+      if (delays[i] != previous.delays[match] ||
+          lengths[i] != previous.lengths[match] ||
+          severities[i] != previous.severities[match]) {
+        changed.add(i);
+      }
+    }
+
+    final List<int> removed = <int>[
+      for (final List<int> unmatched in previousByKey.values) ...unmatched,
+    ]..sort();
+
+    return TrafficEventSnapshotDiff._(
+      previous: previous,
+      current: this,
+      added: added,
+      removed: removed,
+      changed: changed,
+    );
+  }
+
+  // Coordinates are rounded to about 1 meter, the SDK may recompute them
+  String _keyAt(final int index) {
+    final int offset = index * recordSize;
+    final StringBuffer key = StringBuffer()
+      ..write(classes[index])
+      ..write('|')
+      ..write(descriptions[index]);
+    for (int i = 0; i < recordSize; i++) {
+      key
+        ..write('|')
+        ..write((boundingBoxes[offset + i] * 1e5).round());
+    }
+    return key.toString();
+  }
+
+  static bool _matches(
+    final TrafficEventFilter? filter,
+    final int eventClass,
+    final int severity,
+    final dynamic box,
+  ) {
+    if (filter == null) {
+      return true;
+    }
+    final Set<TrafficEventClass>? classes = filter.classes;
+    if (classes != null &&
+        !classes.contains(TrafficEventClassExtension.fromId(eventClass))) {
+      return false;
+    }
+    final Set<TrafficEventSeverity>? severities = filter.severities;
+    if (severities != null &&
+        !severities.contains(TrafficEventSeverityExtension.fromId(severity))) {
+      return false;
+    }
+    final RectangleGeographicArea? area = filter.area;
+    if (area != null &&
+        !area.intersects(RectangleGeographicArea.fromJson(box))) {
+      return false;
+    }
+    return true;
+  }
+
+  static String _request(
+    final int id,
+    final String className,
+    final String method,
+  ) =>
+      jsonEncode(<String, Object>{
+        'id': id,
+        'class': className,
+        'method': method,
+        'args': <String, dynamic>{},
+      });
+}
+
+/// Differences between two [TrafficEventSnapshot] objects.
+///
+/// {@category Routes & Navigation}
+class TrafficEventSnapshotDiff {
+  TrafficEventSnapshotDiff._({
+    required this.previous,
+    required this.current,
+    required this.added,
+    required this.removed,
+    required this.changed,
+  });
+
+  /// The previous snapshot. Null if there was no previous snapshot.
+  final TrafficEventSnapshot? previous;
+
+  /// The current snapshot.
+  final TrafficEventSnapshot current;
+
+  /// Indexes in [current] of the new events.
+  final List<int> added;
+
+  /// Indexes in [previous] of the events which are no longer present.
+  final List<int> removed;
+
+  /// Indexes in [current] of the events whose delay, length or severity changed.
+  final List<int> changed;
+
+  /// Check if the snapshots have the same events.
+  bool get isEmpty => added.isEmpty && removed.isEmpty && changed.isEmpty;
+}
+
+/// Tracks the traffic events of a route and reports the differences when the traffic is refreshed.
+///
+/// Call [updateFromRoute] with the updated route, for instance from the `onRouteUpdated` callback of [NavigationService.startNavigation].
+///
+/// {@category Routes & Navigation}
+class TrafficEventTracker {
+  /// Create a tracker.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *filter* The filter of the events. All the events are kept if null.
+  /// * **IN** *onDiff* Called with the differences when an update changes the events.
+  TrafficEventTracker({this.filter, this.onDiff});
+
+  /// The filter of the events.
+  final TrafficEventFilter? filter;
+
+  /// Called with the differences when an update changes the events.
+  final void Function(TrafficEventSnapshotDiff diff)? onDiff;
+
+  TrafficEventSnapshot? _snapshot;
+
+  /// The last snapshot. Null before the first update.
+  TrafficEventSnapshot? get snapshot => _snapshot;
+
+  /// Update with the traffic events of a route.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *route* The route.
+  ///
+  /// **Returns**
+  ///
+  /// * The differences with the previous snapshot
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  TrafficEventSnapshotDiff updateFromRoute(final RouteBase route) =>
+      update(TrafficEventSnapshot.fromRoute(route, filter: filter));
+
+  /// Update with a new snapshot.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *snapshot* The new snapshot.
+  ///
+  /// **Returns**
+  ///
+  /// * The differences with the previous snapshot
+  TrafficEventSnapshotDiff update(final TrafficEventSnapshot snapshot) {
+    final TrafficEventSnapshotDiff diff = snapshot.diff(_snapshot);
+    _snapshot = snapshot;
+    if (!diff.isEmpty) {
+      onDiff?.call(diff);
+    }
+    return diff;
+  }
+
+  /// Forget the last snapshot. The next update reports all the events as added.
+  void reset() => _snapshot = null;
+}
+
+class _SnapshotBuilder {
+  _SnapshotBuilder(final int capacity)
+      : _delays = Int32List(capacity),
+        _lengths = Int32List(capacity),
+        _severities = Uint8List(capacity),
+        _classes = Int32List(capacity),
+        _boxes = Float64List(capacity * TrafficEventSnapshot.recordSize),
+        _endPoints = Float64List(capacity * TrafficEventSnapshot.recordSize),
+        _distances = Int32List(capacity);
+
+  final List<TrafficEvent> _events = <TrafficEvent>[];
+  final List<String> _descriptions = <String>[];
+  final Int32List _delays;
+  final Int32List _lengths;
+  final Uint8List _severities;
+  final Int32List _classes;
+  final Float64List _boxes;
+  final Float64List _endPoints;
+  final Int32List _distances;
+
+  void add({
+    required final TrafficEvent event,
+    required final int eventClass,
+    required final int severity,
+    required final dynamic box,
+    required final int delay,
+    required final int length,
+    required final String description,
+    required final dynamic from,
+    required final dynamic to,
+    required final int distanceToDestination,
+  }) {
+    final int index = _events.length;
+    final int offset = index * TrafficEventSnapshot.recordSize;
+    _events.add(event);
+    _descriptions.add(description);
+    _delays[index] = delay;
+    _lengths[index] = length;
+    _severities[index] = severity;
+    _classes[index] = eventClass;
+    _boxes[offset] = (box['topleft']['latitude'] as num).toDouble();
+    _boxes[offset + 1] = (box['topleft']['longitude'] as num).toDouble();
+    _boxes[offset + 2] = (box['bottomright']['latitude'] as num).toDouble();
+    _boxes[offset + 3] = (box['bottomright']['longitude'] as num).toDouble();
+    if (from != null && to != null) {
+      _endPoints[offset] = (from['latitude'] as num).toDouble();
+      _endPoints[offset + 1] = (from['longitude'] as num).toDouble();
+      _endPoints[offset + 2] = (to['latitude'] as num).toDouble();
+      _endPoints[offset + 3] = (to['longitude'] as num).toDouble();
+    }
+    _distances[index] = distanceToDestination;
+  }
+
+  TrafficEventSnapshot build() {
+    final int count = _events.length;
+    const int stride = TrafficEventSnapshot.recordSize;
+    return TrafficEventSnapshot(
+      events: _events,
+      descriptions: _descriptions,
+      delays: Int32List.fromList(Int32List.sublistView(_delays, 0, count)),
+      lengths: Int32List.fromList(Int32List.sublistView(_lengths, 0, count)),
+      severities:
+          Uint8List.fromList(Uint8List.sublistView(_severities, 0, count)),
+      classes: Int32List.fromList(Int32List.sublistView(_classes, 0, count)),
+      boundingBoxes: Float64List.fromList(
+        Float64List.sublistView(_boxes, 0, count * stride),
+      ),
+      endPoints: Float64List.fromList(
+        Float64List.sublistView(_endPoints, 0, count * stride),
+      ),
+      distancesToDestination:
+          Int32List.fromList(Int32List.sublistView(_distances, 0, count)),
+    );
+  }
+}
@@ -120,7 +120,10 @@ class MappedDrivingEvent extends GemAutoreleaseObject {
 
   @internal
   MappedDrivingEvent.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'MappedDrivingEvent',
+    );
   }
 
   final int _pointerId;
@@ -203,12 +206,7 @@ class MappedDrivingEvent extends GemAutoreleaseObject {
     return DrivingEventExtension.fromId(resultString['result']);
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'MappedDrivingEvent',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('MappedDrivingEvent', _pointerId);
 }
 
 /// Driving scores.
@@ -224,7 +222,7 @@ class DrivingScores extends GemAutoreleaseObject {
 
   @internal
   DrivingScores.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'DrivingScores');
   }
 
   final int _pointerId;
@@ -462,10 +460,7 @@ class DrivingScores extends GemAutoreleaseObject {
     return resultString['result'];
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(
-            <String, Object>{'class': 'DrivingScores', 'id': _pointerId}),
-      );
+  void dispose() => disposeNative('DrivingScores', _pointerId);
 }
 
 /// A driver behaviour analysis.
@@ -481,7 +476,10 @@ class DriverBehaviourAnalysis extends GemAutoreleaseObject {
 
   @internal
   DriverBehaviourAnalysis.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'DriverBehaviourAnalysis',
+    );
   }
 
   final int _pointerId;
@@ -848,12 +846,7 @@ class DriverBehaviourAnalysis extends GemAutoreleaseObject {
     return retList;
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'DriverBehaviourAnalysis',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('DriverBehaviourAnalysis', _pointerId);
 }
 
 /// The driver behaviour class.
@@ -879,7 +872,7 @@ class DriverBehaviour extends GemAutoreleaseObject {
 
   @internal
   DriverBehaviour.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'DriverBehaviour');
   }
   final int _pointerId;
 
@@ -1090,12 +1083,5 @@ class DriverBehaviour extends GemAutoreleaseObject {
     return DriverBehaviour.init(decodedVal['result']);
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'DriverBehaviour',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('DriverBehaviour', _pointerId);
 }
@@ -22,6 +22,7 @@ import 'package:flutter/services.dart';
 import 'package:gem_kit/core.dart';
 import 'package:gem_kit/map.dart';
 import 'package:gem_kit/src/_ffi/generated_binding.dart' as native_bindings;
+import 'package:gem_kit/src/core/bridge_profiler.dart';
 import 'package:gem_kit/src/core/gem_object_interface.dart';
 import 'package:gem_kit/src/core/gem_object_other.dart';
 import 'package:gem_kit/src/gem_kit_native_utils.dart';
@@ -263,8 +264,7 @@ class GemSdkNative {
   }
 
   void assertObjectAlive(final String jsonStr) {
-    final dynamic json = jsonDecode(jsonStr);
-    final dynamic id = json['id'];
+    final dynamic id = _objectIdOf(jsonStr);
 
     if (id == 0 || id == null) {
       return;
@@ -276,6 +276,25 @@ class GemSdkNative {
     }
   }
 
+  static const String _idPrefix = '{"id":';
+
+  // objectMethod encodes the id first, so it is read without decoding the call
+  static dynamic _objectIdOf(final String jsonStr) {
+    if (!jsonStr.startsWith(_idPrefix)) {
+      return jsonDecode(jsonStr)['id'];
+    }
+    int end = _idPrefix.length;
+    while (end < jsonStr.length) {
+      final int c = jsonStr.codeUnitAt(end);
+      if (c != 0x2D && (c < 0x30 || c > 0x39)) {
+        break;
+      }
+      end++;
+    }
+    return int.tryParse(jsonStr.substring(_idPrefix.length, end)) ??
+        jsonDecode(jsonStr)['id'];
+  }
+
   Future<dynamic> addList({
     required final MapViewMarkerCollections object,
     required final List<MarkerWithRenderSettings> list,
@@ -425,8 +444,13 @@ class GemSdkNative {
       throw GemKitUninitializedException();
     }
     arg ??= '';
+    final BridgeProfiler profiler = BridgeProfiler.instance;
+    final BridgeCallRecord? record =
+        profiler.isEnabled ? profiler.imageRecord(className) : null;
     final Pointer<Utf8> clsName = className.toNativeUtf8();
     final Pointer<Utf8> pArg = arg.toNativeUtf8();
+    final int requestLength = pArg.length;
+    final int startTick = profiler.begin(record);
     final Pointer<Utf8> buffer = _callGetImageBuffer(
       objectId,
       clsName,
@@ -434,24 +458,34 @@ class GemSdkNative {
       height,
       imageType,
       pArg,
-      pArg.length,
+      requestLength,
       clsName.length,
     );
+    final int elapsed = profiler.stop(record, startTick);
+    malloc.free(clsName);
+    malloc.free(pArg);
     if (buffer == nullptr) {
-      malloc.free(clsName);
-      malloc.free(pArg);
+      profiler.end(record, elapsed, requestLength, 0);
       return null;
     }
     final Pointer<Uint8> imgBuffer = _callGetBytes(buffer);
     final int imgBufferSize = _callGetSizeOfBytes(buffer);
     final Uint8List retVal = imgBuffer.asTypedList(imgBufferSize);
-    malloc.free(clsName);
-    malloc.free(pArg);
     _callDeletePointer(buffer);
+    profiler.end(record, elapsed, requestLength, imgBufferSize);
     return retVal;
   }
 
-  String callObjectMethod(final String json) {
+  String callObjectMethod(final String json) =>
+      _callObjectMethod(json) ??
+      (throw Exception('Failed to call object method: $json'));
+
+  // The native library has no batch entry point, calls are direct anyway. A
+  // failed call gets a null reply, like on web, instead of ending the batch
+  List<String?> callObjectMethodBatch(final List<String> jsons) =>
+      <String?>[for (final String json in jsons) _callObjectMethod(json)];
+
+  String? _callObjectMethod(final String json) {
     if (!initHasBeenDone) {
       throw GemKitUninitializedException();
     }
@@ -461,17 +495,28 @@ class GemSdkNative {
     if (Debug.isObjectAliveCheckEnabled) {
       assertObjectAlive(json);
     }
+    final BridgeProfiler profiler = BridgeProfiler.instance;
+    final BridgeCallRecord? record =
+        profiler.isEnabled ? profiler.methodRecord(json) : null;
     final Pointer<Utf8> dataNative = json.toNativeUtf8();
+    final int requestLength = dataNative.length;
+    final int startTick = profiler.begin(record);
     final Pointer<Char> result = gemWebRTCNative!.native_call(
       dataNative.cast<Char>(),
-      dataNative.length,
+      requestLength,
     );
+    final int elapsed = profiler.stop(record, startTick);
     malloc.free(dataNative);
     if (result == nullptr) {
-      throw Exception('Failed to call object method: $json');
+      profiler.end(record, elapsed, requestLength, 0);
+      return null;
     }
 
-    final String response = result.cast<Utf8>().toDartString();
+    // Sizes are the UTF-8 bytes crossing the bridge
+    final Pointer<Utf8> responseNative = result.cast<Utf8>();
+    final int responseLength = responseNative.length;
+    final String response = responseNative.toDartString(length: responseLength);
+    profiler.end(record, elapsed, requestLength, responseLength);
     if (Debug.logCallObjectMethod) {
       gemSdkLogger.finest('[SdkDebug][CallObject] Result: $response');
     }
@@ -488,17 +533,27 @@ class GemSdkNative {
       gemSdkLogger.finest('[SdkDebug][CreateObject] Request: $json');
     }
 
+    final BridgeProfiler profiler = BridgeProfiler.instance;
+    final BridgeCallRecord? record =
+        profiler.isEnabled ? profiler.createRecord(json) : null;
     final Pointer<Utf8> dataNative = json.toNativeUtf8();
+    final int requestLength = dataNative.length;
+    final int startTick = profiler.begin(record);
     final Pointer<Char> result = gemWebRTCNative!.native_call_createObject(
       dataNative.cast<Char>(),
-      dataNative.length,
+      requestLength,
     );
+    final int elapsed = profiler.stop(record, startTick);
     malloc.free(dataNative);
     if (result == nullptr) {
+      profiler.end(record, elapsed, requestLength, 0);
       throw Exception('Failed to create object: $json');
     }
 
-    final String response = result.cast<Utf8>().toDartString();
+    final Pointer<Utf8> responseNative = result.cast<Utf8>();
+    final int responseLength = responseNative.length;
+    final String response = responseNative.toDartString(length: responseLength);
+    profiler.end(record, elapsed, requestLength, responseLength);
     if (Debug.logCreateObject) {
       gemSdkLogger.finest('[SdkDebug][CreateObject] Result: $json');
     }
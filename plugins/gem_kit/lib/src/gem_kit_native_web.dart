@@ -28,6 +28,7 @@ import 'package:gem_kit/src/core/gem_object_interface.dart';
 import 'package:gem_kit/src/core/gem_object_web.dart';
 import 'package:gem_kit/src/gem_kit_native_utils.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+import 'package:gem_kit/src/gem_kit_web_transport.dart';
 import 'package:gem_kit/src/loggers/app_logger.dart';
 import 'package:logging/logging.dart';
 
@@ -61,6 +62,8 @@ class GemSdkNative {
   Timer? _batchTimer;
   Future<void> get initializationDone => initializationCompleter.future;
   dynamic _pointerFunc;
+  WebHeapTransport? _transport;
+  bool _transportChecked = false;
   int getAndroidVersion() {
     return androidVersion;
   }
@@ -96,7 +99,28 @@ class GemSdkNative {
 
   static void onNotifyEvent() {}
 
+  // Null before the module is loaded, with an older gemkitloader.js, or while
+  // a batch is running
+  WebHeapTransport? get _availableTransport {
+    if (!_transportChecked && initHasBeenDone) {
+      _transportChecked = true;
+      _transport = WebHeapTransport.create();
+    }
+    final WebHeapTransport? transport = _transport;
+    return transport == null || transport.isBusy ? null : transport;
+  }
+
   dynamic callObjectMethod(final String json) {
+    final WebHeapTransport? transport = _availableTransport;
+    if (transport != null) {
+      try {
+        return transport.call(json);
+      } catch (e) {
+        gemSdkLogger.log(Level.SEVERE, e.toString());
+        return null;
+      }
+    }
+
     final JsObject pWebRTCModule = context['Module'];
     final dynamic argumentsNative = pWebRTCModule.callMethod(
       'allocateUTF8',
@@ -124,6 +148,21 @@ class GemSdkNative {
     return null;
   }
 
+  List<String?> callObjectMethodBatch(final List<String> jsons) {
+    final WebHeapTransport? transport = _availableTransport;
+    if (transport != null) {
+      try {
+        return transport.callBatch(jsons);
+      } catch (e) {
+        gemSdkLogger.log(Level.SEVERE, e.toString());
+        return List<String?>.filled(jsons.length, null);
+      }
+    }
+    return jsons
+        .map((final String json) => callObjectMethod(json) as String?)
+        .toList();
+  }
+
   dynamic callCreateObject(final String json) {
     final JsObject pWebRTCModule = context['Module'];
     final dynamic argumentsNative = pWebRTCModule.callMethod(
@@ -279,6 +318,21 @@ class GemSdkNative {
   }
 
   dynamic createGemImage(final Uint8List buffer, final int imgType) {
+    final WebHeapTransport? transport = _availableTransport;
+    if (transport != null) {
+      final int pointer = transport.writeBytes(buffer);
+      if (pointer == 0) {
+        return null;
+      }
+      final JsObject pWebRTCModule = context['Module'];
+      final dynamic result = pWebRTCModule.callMethod(
+        '_createGemImage',
+        <int>[pointer, buffer.length, imgType],
+      );
+      pWebRTCModule.callMethod('_gemFree', <int>[pointer]);
+      return result;
+    }
+
     final JsObject jsTypedArray = JsObject.jsify(buffer);
 
     // Call the JavaScript function to send data to WebAssembly
@@ -296,6 +350,9 @@ class GemSdkNative {
 
   void release() {
     stopBatchTimer();
+    _transport?.release();
+    _transport = null;
+    _transportChecked = false;
     final JsObject pWebRTCModule = context['Module'];
     // ignore: inference_failure_on_collection_literal
     pWebRTCModule.callMethod('_releaseNative', <dynamic>[]);
@@ -307,14 +364,18 @@ class GemSdkNative {
     return false;
   }
 
-  dynamic toNativePointer(final Uint8List data) {
-    //return passBinaryDataToC(data);]
-    final JsObject jsArray = JsObject.jsify(data);
-    final dynamic toSend = context.callMethod(
-      'passBinaryDataToWasm',
-      <JsObject>[jsArray],
-    );
-    return NativeObject(toSend, data.length);
+  dynamic toNativePointer(final Uint8List data) =>
+      NativeObject(_passBinaryData(data), data.length);
+
+  // Copy bytes to a new buffer of the WASM heap, released with _gemFree
+  dynamic _passBinaryData(final Uint8List data) {
+    final WebHeapTransport? transport = _availableTransport;
+    if (transport != null) {
+      return transport.writeBytes(data);
+    }
+    return context.callMethod('passBinaryDataToWasm', <JsObject>[
+      JsObject.jsify(data),
+    ]);
   }
 
   void freeNativePointer(final dynamic pointer) {
@@ -383,6 +444,15 @@ class GemSdkNative {
       <dynamic>[bufferPtr],
     );
 
+    final WebHeapTransport? transport = _availableTransport;
+    if (transport != null) {
+      final Uint8List retVal = transport.readBytes(imgBufferPtr, imgBufferSize);
+      pWebRTCModule.callMethod('_gemFree', <dynamic>[clsNamePtr]);
+      pWebRTCModule.callMethod('_gemFree', <dynamic>[argPtr]);
+      pWebRTCModule.callMethod('_deletePointer', <dynamic>[bufferPtr]);
+      return retVal;
+    }
+
     // Convert to Uint8List
     //final retVal = Uint8List.fromList(pWebRTCModule.callMethod("_getImageBuffer", [imgBufferPtr, imgBufferSize]));
     allowInterop(
@@ -448,11 +518,7 @@ class GemSdkNative {
       }
     }
     final Uint8List pList = serializeListOfMarkers(list);
-    final JsObject jsArray = JsObject.jsify(pList);
-    final dynamic toSend = context.callMethod(
-      'passBinaryDataToWasm',
-      <JsObject>[jsArray],
-    );
+    final dynamic toSend = _passBinaryData(pList);
     //print("Binary value for list is ${pList.length}");
     final dynamic retVal = callObjectMethod(
       jsonEncode(<String, Object>{
@@ -471,7 +537,9 @@ class GemSdkNative {
     );
     for (final MapEntry<int, NativeObject> imagePointer
         in markersImagePointers.entries) {
-      pWebRTCModule.callMethod('_gemFree', <dynamic>[imagePointer.value]);
+      pWebRTCModule.callMethod('_gemFree', <dynamic>[
+        imagePointer.value.address,
+      ]);
     }
     pWebRTCModule.callMethod('_gemFree', <dynamic>[toSend]);
     return retVal;
@@ -513,11 +581,7 @@ class GemSdkNative {
       final Uint8List binaryData = _convertToBinary(_touchEventBatch);
       _touchEventBatch.clear();
       final JsObject pWebRTCModule = context['Module'];
-      final JsObject jsArray = JsObject.jsify(binaryData);
-      final JsObject toSend = context.callMethod(
-        'passBinaryDataToWasm',
-        <dynamic>[jsArray],
-      );
+      final dynamic toSend = _passBinaryData(binaryData);
       pWebRTCModule.callMethod('_sendBatchedEvents', <dynamic>[
         toSend,
         binaryData.length,
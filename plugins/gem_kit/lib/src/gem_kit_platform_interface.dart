@@ -22,6 +22,7 @@ import 'package:gem_kit/core.dart';
 import 'package:gem_kit/map.dart';
 import 'package:gem_kit/src/core/event_handler.dart';
 import 'package:gem_kit/src/core/gem_object_interface.dart';
+import 'package:gem_kit/src/core/object_lifetime_tracker.dart';
 import 'package:gem_kit/src/gem_kit_native.dart'
     if (dart.library.html) 'package:gem_kit/src/gem_kit_native_web.dart';
 import 'package:gem_kit/src/loggers/app_logger.dart';
@@ -267,6 +268,31 @@ class GemKitPlatform extends PlatformInterface {
     return result;
   }
 
+  // Runs the calls in order, with a single interop call on web. The API error
+  // is the one of the last call
+  List<String> callObjectMethodBatch(final List<String> jsonCommands) {
+    // Failed calls get an error reply, so that the replies stay aligned with
+    // the requests
+    final List<String?> replies = gemKit.callObjectMethodBatch(jsonCommands);
+    final List<String> results = <String>[
+      for (final String? reply in replies) reply ?? _failedCallReply,
+    ];
+
+    try {
+      final dynamic json = results.isEmpty ? null : jsonDecode(results.last);
+      final int? error = json?['gemApiError'];
+
+      ApiErrorServiceImpl.apiErrorAsInt = error is int ? error : 0;
+    } catch (e) {
+      ApiErrorServiceImpl.apiErrorAsInt = 0;
+    }
+
+    return results;
+  }
+
+  static final String _failedCallReply =
+      '{"result":null,"gemApiError":${GemError.general.code}}';
+
   int callBitmapConstructor(final int width, final int height) {
     return gemKit.callCreateBitmap(width, height);
   }
@@ -284,6 +310,7 @@ class GemKitPlatform extends PlatformInterface {
   }
 
   void callDeleteObject(final String json) {
+    ObjectLifetimeTracker.instance.deleted(json);
     gemKit.callDeleteObject(json);
   }
 
@@ -0,0 +1,269 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+// ignore_for_file: deprecated_member_use
+
+/// @nodoc
+library;
+
+import 'dart:convert';
+import 'dart:js';
+import 'dart:typed_data';
+
+/// Calls to the WASM module through its linear memory.
+///
+/// Requests are written as UTF-8 directly in a buffer of the WASM heap, the same format as the native `native_call`, and responses are decoded from the heap.
+/// A single call is executed by `gemNativeCall` of gemkitloader.js, which returns the decoded response.
+/// A batch of calls is described in a table of the heap and executed by `gemNativeCallBatch` of gemkitloader.js in a single interop call.
+///
+/// Each table record holds `request pointer, request length, response pointer, response length` as 32 bits integers.
+/// Responses are freed by the same entry point as soon as they are decoded.
+class WebHeapTransport {
+  WebHeapTransport._(this._module, this._call, this._callBatch);
+
+  /// Create the transport.
+  ///
+  /// **Returns**
+  ///
+  /// * The transport, or null if the loaded gemkitloader.js does not provide the call entry points.
+  static WebHeapTransport? create() {
+    final dynamic module = context['Module'];
+    final dynamic call = context['gemNativeCall'];
+    final dynamic callBatch = context['gemNativeCallBatch'];
+    if (module is! JsObject ||
+        call is! JsFunction ||
+        callBatch is! JsFunction) {
+      return null;
+    }
+    return WebHeapTransport._(module, call, callBatch);
+  }
+
+  static const int _recordSize = 4;
+
+  final JsObject _module;
+  final JsFunction _call;
+  final JsFunction _callBatch;
+
+  Uint8List _heapU8 = Uint8List(0);
+  Int32List _heap32 = Int32List(0);
+
+  int _arena = 0;
+  int _arenaSize = 0;
+  int _table = 0;
+  int _tableCapacity = 0;
+  bool _isBusy = false;
+
+  /// Check if a batch is running. Calls made by the native side during a batch, from event handlers, must not use the transport.
+  bool get isBusy => _isBusy;
+
+  /// Run a method call.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *json* The request.
+  ///
+  /// **Returns**
+  ///
+  /// * The response, or null if the call failed.
+  String? call(final String json) {
+    // UTF-8 takes at most 3 bytes per UTF-16 code unit
+    _reserve(json.length * 3 + 1, 1);
+
+    final Uint8List heap = _heap();
+    final int length = _writeUtf8(heap, _arena, json);
+    heap[_arena + length] = 0;
+
+    _isBusy = true;
+    try {
+      return _call.apply(<int>[_arena, length]) as String?;
+    } finally {
+      _isBusy = false;
+    }
+  }
+
+  /// Run several method calls in order, with a single interop call.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *jsons* The requests.
+  ///
+  /// **Returns**
+  ///
+  /// * The responses, null for the failed calls.
+  List<String?> callBatch(final List<String> jsons) {
+    final int count = jsons.length;
+    if (count == 0) {
+      return <String?>[];
+    }
+
+    // UTF-8 takes at most 3 bytes per UTF-16 code unit
+    int maxSize = 0;
+    for (final String json in jsons) {
+      maxSize += json.length * 3 + 1;
+    }
+    _reserve(maxSize, count);
+
+    Uint8List heap = _heap();
+    Int32List heap32 = _heap32;
+    int offset = _arena;
+    for (int i = 0; i < count; i++) {
+      final int length = _writeUtf8(heap, offset, jsons[i]);
+      heap[offset + length] = 0;
+      final int record = (_table >> 2) + i * _recordSize;
+      heap32[record] = offset;
+      heap32[record + 1] = length;
+      offset += length + 1;
+    }
+
+    _isBusy = true;
+    try {
+      _callBatch.apply(<int>[_table, count, 0]);
+    } finally {
+      _isBusy = false;
+    }
+
+    final List<String?> responses = List<String?>.filled(count, null);
+    try {
+      heap = _heap();
+      heap32 = _heap32;
+      for (int i = 0; i < count; i++) {
+        final int record = (_table >> 2) + i * _recordSize;
+        final int pointer = heap32[record + 2];
+        if (pointer != 0) {
+          responses[i] = utf8.decode(
+            Uint8List.sublistView(heap, pointer, pointer + heap32[record + 3]),
+          );
+        }
+      }
+    } finally {
+      _callBatch.apply(<int>[_table, 0, count]);
+    }
+    return responses;
+  }
+
+  /// Copy bytes to a new buffer of the WASM heap.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *data* The bytes.
+  ///
+  /// **Returns**
+  ///
+  /// * The buffer address, to be released with `_gemFree`. 0 if the allocation failed.
+  int writeBytes(final Uint8List data) {
+    final int pointer =
+        _module.callMethod('_gemAlloc', <int>[data.isEmpty ? 1 : data.length]);
+    if (pointer != 0) {
+      _heap().setRange(pointer, pointer + data.length, data);
+    }
+    return pointer;
+  }
+
+  /// Copy bytes from the WASM heap.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *pointer* The address of the bytes.
+  /// * **IN** *length* The number of bytes.
+  ///
+  /// **Returns**
+  ///
+  /// * The copied bytes.
+  Uint8List readBytes(final int pointer, final int length) =>
+      Uint8List.fromList(
+        Uint8List.sublistView(_heap(), pointer, pointer + length),
+      );
+
+  /// Free the buffers of the transport.
+  void release() {
+    if (_arena != 0) {
+      _module.callMethod('_gemFree', <int>[_arena]);
+    }
+    if (_table != 0) {
+      _module.callMethod('_gemFree', <int>[_table]);
+    }
+    _arena = 0;
+    _arenaSize = 0;
+    _table = 0;
+    _tableCapacity = 0;
+  }
+
+  // The module replaces its heap views when the WASM memory grows
+  Uint8List _heap() {
+    final Uint8List heap = _module['HEAPU8'];
+    if (!identical(heap, _heapU8) ||
+        heap.lengthInBytes != _heapU8.lengthInBytes) {
+      _heapU8 = heap;
+      _heap32 = _module['HEAP32'];
+    }
+    return _heapU8;
+  }
+
+  void _reserve(final int arenaSize, final int count) {
+    if (count > _tableCapacity) {
+      if (_table != 0) {
+        _module.callMethod('_gemFree', <int>[_table]);
+      }
+      _tableCapacity = count < 16 ? 16 : count;
+      _table = _module.callMethod('_gemAlloc', <int>[
+        _tableCapacity * _recordSize * 4,
+      ]);
+    }
+    if (arenaSize > _arenaSize) {
+      if (_arena != 0) {
+        _module.callMethod('_gemFree', <int>[_arena]);
+      }
+      _arenaSize = arenaSize < 4096 ? 4096 : arenaSize * 2;
+      _arena = _module.callMethod('_gemAlloc', <int>[_arenaSize]);
+    }
+    if (_table == 0 || _arena == 0) {
+      throw StateError('Failed to allocate memory in WebAssembly');
+    }
+  }
+
+  static int _writeUtf8(
+    final Uint8List heap,
+    final int offset,
+    final String s,
+  ) {
+    int out = offset;
+    final int length = s.length;
+    for (int i = 0; i < length; i++) {
+      int c = s.codeUnitAt(i);
+      if (c < 0x80) {
+        heap[out++] = c;
+      } else if (c < 0x800) {
+        heap[out++] = 0xc0 | (c >> 6);
+        heap[out++] = 0x80 | (c & 0x3f);
+      } else {
+        if (c >= 0xd800 && c < 0xdc00 && i + 1 < length) {
+          final int next = s.codeUnitAt(i + 1);
+          if (next >= 0xdc00 && next < 0xe000) {
+            c = 0x10000 + ((c - 0xd800) << 10) + (next - 0xdc00);
+            i++;
+            heap[out++] = 0xf0 | (c >> 18);
+            heap[out++] = 0x80 | ((c >> 12) & 0x3f);
+            heap[out++] = 0x80 | ((c >> 6) & 0x3f);
+            heap[out++] = 0x80 | (c & 0x3f);
+            continue;
+          }
+        }
+        if (c >= 0xd800 && c < 0xe000) {
+          // Unpaired surrogate
+          c = 0xfffd;
+        }
+        heap[out++] = 0xe0 | (c >> 12);
+        heap[out++] = 0x80 | ((c >> 6) & 0x3f);
+        heap[out++] = 0x80 | (c & 0x3f);
+      }
+    }
+    return out - offset;
+  }
+}
@@ -8,10 +8,14 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
+import 'dart:math';
+
 import 'package:gem_kit/core.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/core/lists.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+import 'package:gem_kit/src/landmarkstore/landmark_record_page.dart';
+import 'package:meta/meta.dart';
 
 /// Landmark Browse Session
 ///
@@ -105,6 +109,93 @@ class LandmarkBrowseSession extends GemAutoreleaseObject {
     return LandmarkList.init(resultString['result']).toList();
   }
 
+  /// Get the landmarks after the given cursor as a page of compact records.
+  ///
+  /// The page is read with a single [getLandmarks] call and holds no native objects, so reading it later does not call the SDK.
+  /// Use [LandmarkBrowsePager] to have the next page prepared in advance.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *after* The cursor returned by the previous page, possibly obtained from another session with the same settings. If null, the first page is returned.
+  /// * **IN** *count* The maximum number of landmarks in the page.
+  ///
+  /// **Returns**
+  ///
+  /// * The page. It is empty if there are no more landmarks.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails
+  LandmarkRecordPage getLandmarkRecords({
+    final LandmarkPageCursor? after,
+    final int count = 200,
+  }) {
+    final LandmarkBrowseSessionSettings settings = this.settings;
+    final int start = resolveCursor(after, settings: settings);
+    return (recordPageBuilder(start, count, settings)..step(count)).build();
+  }
+
+  /// Get the position following the given cursor.
+  ///
+  /// If the landmark of the cursor is no longer in the session, the position is found by binary search on the sort key.
+  /// Landmarks with the same sort key as the cursor may then be returned again, but none is skipped.
+  @internal
+  int resolveCursor(
+    final LandmarkPageCursor? cursor, {
+    required final LandmarkBrowseSessionSettings settings,
+  }) {
+    if (cursor == null) {
+      return 0;
+    }
+
+    final int position = getLandmarkPosition(cursor.landmarkId);
+    if (position >= 0) {
+      return position + 1;
+    }
+
+    int low = 0;
+    int high = landmarkCount;
+    while (low < high) {
+      final int mid = (low + high) >> 1;
+      final Landmark landmark = getLandmarks(mid, mid + 1).first;
+      final Comparable<dynamic> key = LandmarkRecordPageBuilder.sortKeyOf(
+        settings,
+        settings.orderBy == LandmarkOrder.name ? landmark.name : '',
+        settings.orderBy == LandmarkOrder.date
+            ? landmark.timeStamp.millisecondsSinceEpoch
+            : 0,
+        settings.orderBy == LandmarkOrder.distance
+            ? landmark.coordinates
+            : settings.coordinates,
+      );
+      final int order = key.compareTo(cursor.sortKey);
+      final bool isBefore = settings.descendingOrder ? order > 0 : order < 0;
+      if (isBefore) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  /// Fetch the landmarks of a page, to be read with the returned builder.
+  @internal
+  LandmarkRecordPageBuilder recordPageBuilder(
+    final int start,
+    final int count,
+    final LandmarkBrowseSessionSettings settings,
+  ) {
+    final int total = landmarkCount;
+    final int end = start < total ? min(start + count, total) : start;
+    return LandmarkRecordPageBuilder(
+      settings,
+      start,
+      total,
+      start < end ? getLandmarks(start, end) : <Landmark>[],
+    );
+  }
+
   /// Get the position of the landmark with the specified [Landmark.id]
   ///
   /// The position is 0 based
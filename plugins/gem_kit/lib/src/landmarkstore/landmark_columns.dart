@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/landmarkstore/landmark_store.dart';
+import 'package:meta/meta.dart';
+
+/// Landmarks stored as parallel columns, to be added to a store in bulk with [LandmarkStore.addLandmarkColumns].
+///
+/// Row `i` is made of `names[i]`, `latitudes[i]`, `longitudes[i]` and, if provided, `descriptions[i]` and `categoryIds[i]`.
+///
+/// {@category Places}
+class LandmarkColumns {
+  /// Create the columns.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *names* The landmark names.
+  /// * **IN** *latitudes* The landmark latitudes.
+  /// * **IN** *longitudes* The landmark longitudes.
+  /// * **IN** *descriptions* The landmark descriptions. Optional.
+  /// * **IN** *categoryIds* The category of each landmark. The categories must exist in the store. If not provided, the landmarks are uncategorized.
+  ///
+  /// **Throws**
+  ///
+  /// * [ArgumentError] if the columns have different lengths.
+  LandmarkColumns({
+    required this.names,
+    required this.latitudes,
+    required this.longitudes,
+    this.descriptions,
+    this.categoryIds,
+  }) {
+    final int count = names.length;
+    if (latitudes.length != count ||
+        longitudes.length != count ||
+        (descriptions != null && descriptions!.length != count) ||
+        (categoryIds != null && categoryIds!.length != count)) {
+      throw ArgumentError('All the columns must have the same length');
+    }
+  }
+
+  /// The landmark names.
+  final List<String> names;
+
+  /// The landmark latitudes.
+  final Float64List latitudes;
+
+  /// The landmark longitudes.
+  final Float64List longitudes;
+
+  /// The landmark descriptions.
+  final List<String>? descriptions;
+
+  /// The category of each landmark.
+  final Int32List? categoryIds;
+
+  /// Number of rows.
+  int get length => names.length;
+
+  /// Row indexes grouped by category id, in insertion order.
+  @internal
+  Map<int, List<int>> rowsByCategory() {
+    final Int32List? categories = categoryIds;
+    if (categories == null) {
+      return <int, List<int>>{
+        LandmarkStore.uncategorizedLandmarkCategId:
+            List<int>.generate(length, (final int i) => i),
+      };
+    }
+
+    final Map<int, List<int>> groups = <int, List<int>>{};
+    for (int i = 0; i < length; i++) {
+      groups.putIfAbsent(categories[i], () => <int>[]).add(i);
+    }
+    return groups;
+  }
+
+  /// Encode the given rows as a GeoJSON feature collection.
+  @internal
+  Uint8List encodeGeoJson(final List<int> rows) {
+    final StringBuffer buffer = StringBuffer(
+      '{"type":"FeatureCollection","features":[',
+    );
+
+    for (int r = 0; r < rows.length; r++) {
+      final int i = rows[r];
+      if (r > 0) {
+        buffer.write(',');
+      }
+      buffer
+        ..write('{"type":"Feature","geometry":{"type":"Point","coordinates":[')
+        ..write(longitudes[i])
+        ..write(',')
+        ..write(latitudes[i])
+        ..write(']},"properties":{"name":')
+        ..write(jsonEncode(names[i]));
+      final List<String>? desc = descriptions;
+      if (desc != null && desc[i].isNotEmpty) {
+        buffer
+          ..write(',"description":')
+          ..write(jsonEncode(desc[i]));
+      }
+      buffer.write('}}');
+    }
+
+    buffer.write(']}');
+    return utf8.encode(buffer.toString());
+  }
+}
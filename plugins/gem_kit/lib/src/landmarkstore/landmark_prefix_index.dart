@@ -0,0 +1,786 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:convert';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/src/landmarkstore/landmark_store_observer.dart';
+import 'package:meta/meta.dart';
+
+/// Match returned by [LandmarkPrefixIndex.search].
+///
+/// {@category Places}
+class LandmarkPrefixMatch {
+  /// Create a match.
+  LandmarkPrefixMatch({
+    required this.landmarkId,
+    required this.name,
+    required this.latitude,
+    required this.longitude,
+    required this.edits,
+    required this.distance,
+  });
+
+  /// The id of the landmark in the indexed store.
+  final int landmarkId;
+
+  /// The landmark name.
+  final String name;
+
+  /// The landmark latitude.
+  final double latitude;
+
+  /// The landmark longitude.
+  final double longitude;
+
+  /// Number of typing errors needed to match the query. 0 for an exact prefix match.
+  final int edits;
+
+  /// Distance in meters to the position given to [LandmarkPrefixIndex.search]. 0 if no position was given.
+  final double distance;
+
+  /// The landmark coordinates.
+  Coordinates get coordinates =>
+      Coordinates(latitude: latitude, longitude: longitude);
+}
+
+/// Offline prefix index over the landmark names of a [LandmarkStore].
+///
+/// The index keeps the id, name and coordinates of each landmark in memory, so queries do not cross the native bridge.
+/// Names are normalized before being indexed: Latin letters are lowercased and stripped of diacritics, Arabic diacritics and tatweel are removed
+/// and the alef, yeh, teh marbuta and hamza carrier variants are unified. Words starting with the Arabic article are also indexed without it.
+///
+/// Landmarks added, updated or removed through the [LandmarkStore] methods are reflected in the index as they happen.
+/// Use [toBytes] and [LandmarkPrefixIndex.fromBytes] to persist the index between application runs.
+///
+/// Use [lookup] as a `TypeAheadSearch` result source to merge the indexed landmarks with the `SearchService` results.
+///
+/// {@category Places}
+class LandmarkPrefixIndex implements LandmarkStoreObserver {
+  LandmarkPrefixIndex._(this._store, this._storeId);
+
+  /// Build an index of landmark names which is not attached to a store.
+  ///
+  /// [lookup] finds no landmark in such an index, use [search].
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *names* The landmark names, by landmark id.
+  @visibleForTesting
+  LandmarkPrefixIndex.detached(final Map<int, String> names)
+      : _store = null,
+        _storeId = -1 {
+    final List<String> tokens = <String>[];
+    final List<int> tokenSlots = <int>[];
+    for (final MapEntry<int, String> entry in names.entries) {
+      _addRecord(entry.key, entry.value, 0, 0, tokens, tokenSlots);
+    }
+    _mergeTokens(tokens, tokenSlots);
+  }
+
+  /// Build the index from the landmarks of a store.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *store* The landmark store to be indexed.
+  ///
+  /// **Returns**
+  ///
+  /// * The index, following the changes of the store until [dispose] is called.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  static LandmarkPrefixIndex build(final LandmarkStore store) {
+    final LandmarkPrefixIndex index = LandmarkPrefixIndex._(store, store.id)
+      .._addAll(store.getLandmarks());
+    LandmarkStoreObservers.add(index._storeId, index);
+    return index;
+  }
+
+  /// Load an index saved with [toBytes].
+  ///
+  /// The index is rebuilt from the store if the saved data is invalid or if its landmark count does not match the store.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *store* The indexed landmark store.
+  /// * **IN** *bytes* The saved index.
+  ///
+  /// **Returns**
+  ///
+  /// * The index, following the changes of the store until [dispose] is called.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  static LandmarkPrefixIndex fromBytes(
+    final LandmarkStore store,
+    final Uint8List bytes,
+  ) {
+    final int storeId = store.id;
+    final LandmarkPrefixIndex index = LandmarkPrefixIndex._(store, storeId);
+
+    final bool isLoaded = index._load(bytes);
+    if (!isLoaded || index.length != store.getLandmarkCount()) {
+      return build(store);
+    }
+
+    LandmarkStoreObservers.add(storeId, index);
+    return index;
+  }
+
+  // Null for a detached index
+  final LandmarkStore? _store;
+  final int _storeId;
+
+  // Landmark records, by slot
+  final List<int> _ids = <int>[];
+  final List<String> _names = <String>[];
+  final List<double> _latitudes = <double>[];
+  final List<double> _longitudes = <double>[];
+  final List<bool> _isAlive = <bool>[];
+  final Map<int, int> _slotById = <int, int>{};
+  int _deadCount = 0;
+
+  // Normalized tokens sorted for prefix range lookups, with the slot owning each token
+  final List<String> _tokens = <String>[];
+  final List<int> _tokenSlots = <int>[];
+
+  /// Number of indexed landmarks.
+  int get length => _slotById.length;
+
+  /// The id of the indexed landmark store.
+  int get storeId => _storeId;
+
+  /// Search the indexed landmarks.
+  ///
+  /// A landmark matches if each word of the query is a prefix of one of the words of its name, allowing up to [maxEdits] typing errors per word.
+  /// Words shorter than 3 characters must match exactly.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *query* The text to search for.
+  /// * **IN** *position* The reference position. If provided, matches with the same number of errors are sorted by distance to it.
+  /// * **IN** *limit* Maximum number of matches returned.
+  /// * **IN** *maxEdits* Maximum number of typing errors allowed per query word.
+  ///
+  /// **Returns**
+  ///
+  /// * The matches, best first
+  List<LandmarkPrefixMatch> search(
+    final String query, {
+    final Coordinates? position,
+    final int limit = 10,
+    final int maxEdits = 1,
+  }) {
+    final List<String> words = _tokenize(query, withoutArticle: false);
+    if (words.isEmpty || limit <= 0) {
+      return <LandmarkPrefixMatch>[];
+    }
+
+    // Best edit count for each slot matching all the words so far
+    Map<int, int>? candidates;
+    for (final String word in words) {
+      final Map<int, int> matches = _matchWord(
+        word,
+        word.length < 3 ? 0 : maxEdits,
+        candidates,
+      );
+      if (candidates == null) {
+        candidates = matches;
+      } else {
+        candidates = <int, int>{
+          for (final MapEntry<int, int> entry in matches.entries)
+            entry.key: entry.value + candidates[entry.key]!,
+        };
+      }
+      if (candidates.isEmpty) {
+        return <LandmarkPrefixMatch>[];
+      }
+    }
+
+    final double refLat = position?.latitude ?? 0;
+    final double refLon = position?.longitude ?? 0;
+    final double cosRef = cos(refLat * pi / 180);
+
+    final List<LandmarkPrefixMatch> results = <LandmarkPrefixMatch>[
+      for (final MapEntry<int, int> entry in candidates!.entries)
+        LandmarkPrefixMatch(
+          landmarkId: _ids[entry.key],
+          name: _names[entry.key],
+          latitude: _latitudes[entry.key],
+          longitude: _longitudes[entry.key],
+          edits: entry.value,
+          distance: position == null
+              ? 0
+              : _distance(
+                  refLat,
+                  refLon,
+                  cosRef,
+                  _latitudes[entry.key],
+                  _longitudes[entry.key],
+                ),
+        ),
+    ];
+
+    results.sort((final LandmarkPrefixMatch a, final LandmarkPrefixMatch b) {
+      if (a.edits != b.edits) {
+        return a.edits - b.edits;
+      }
+      if (a.distance != b.distance) {
+        return a.distance.compareTo(b.distance);
+      }
+      return a.name.compareTo(b.name);
+    });
+
+    return results.length > limit ? results.sublist(0, limit) : results;
+  }
+
+  /// Search the indexed landmarks and get the matching landmarks from the store.
+  ///
+  /// Has the signature of a `TypeAheadSearch` result source.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *query* The text to search for.
+  /// * **IN** *referenceCoordinates* The reference position.
+  ///
+  /// **Returns**
+  ///
+  /// * The matching landmarks, best first
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  Future<List<Landmark>> lookup(
+    final String query,
+    final Coordinates referenceCoordinates,
+  ) async {
+    final List<Landmark> landmarks = <Landmark>[];
+    for (final LandmarkPrefixMatch match
+        in search(query, position: referenceCoordinates)) {
+      final Landmark? landmark = _store?.getLandmark(match.landmarkId);
+      if (landmark != null) {
+        landmarks.add(landmark);
+      }
+    }
+    return landmarks;
+  }
+
+  /// Save the index.
+  ///
+  /// **Returns**
+  ///
+  /// * The saved index, to be loaded with [LandmarkPrefixIndex.fromBytes].
+  Uint8List toBytes() {
+    final BytesBuilder builder = BytesBuilder(copy: false);
+    final ByteData header = ByteData(12)
+      ..setUint32(0, _magic)
+      ..setUint32(4, _version)
+      ..setUint32(8, length);
+    builder.add(header.buffer.asUint8List());
+
+    final ByteData record = ByteData(_recordHeaderSize);
+    for (int slot = 0; slot < _ids.length; slot++) {
+      if (!_isAlive[slot]) {
+        continue;
+      }
+      final Uint8List name = utf8.encode(_names[slot]);
+      record
+        ..setInt64(0, _ids[slot])
+        ..setFloat64(8, _latitudes[slot])
+        ..setFloat64(16, _longitudes[slot])
+        ..setUint32(24, name.length);
+      builder
+        ..add(Uint8List.fromList(record.buffer.asUint8List()))
+        ..add(name);
+    }
+
+    return builder.takeBytes();
+  }
+
+  /// Stop following the changes of the store.
+  void dispose() => LandmarkStoreObservers.remove(_storeId, this);
+
+  @override
+  void onLandmarkAdded(final Landmark landmark, final int categoryId) {
+    final int id = landmark.id;
+    if (_slotById.containsKey(id)) {
+      return;
+    }
+    final Coordinates coords = landmark.coordinates;
+    _add(id, landmark.name, coords.latitude, coords.longitude);
+  }
+
+  @override
+  void onLandmarkUpdated(final Landmark landmark) {
+    final int id = landmark.id;
+    final Coordinates coords = landmark.coordinates;
+    _remove(id);
+    _add(id, landmark.name, coords.latitude, coords.longitude);
+  }
+
+  @override
+  void onLandmarkRemoved(final int landmarkId) => _remove(landmarkId);
+
+  @override
+  void onAllLandmarksRemoved() {
+    _ids.clear();
+    _names.clear();
+    _latitudes.clear();
+    _longitudes.clear();
+    _isAlive.clear();
+    _slotById.clear();
+    _tokens.clear();
+    _tokenSlots.clear();
+    _deadCount = 0;
+  }
+
+  @override
+  void onLandmarksAdded(
+    final List<Landmark> landmarks,
+    final int categoryId,
+  ) =>
+      _addAll(landmarks);
+
+  void _addAll(final List<Landmark> landmarks) {
+    final List<String> tokens = <String>[];
+    final List<int> tokenSlots = <int>[];
+    for (final Landmark landmark in landmarks) {
+      if (_slotById.containsKey(landmark.id)) {
+        continue;
+      }
+      final Coordinates coords = landmark.coordinates;
+      _addRecord(
+        landmark.id,
+        landmark.name,
+        coords.latitude,
+        coords.longitude,
+        tokens,
+        tokenSlots,
+      );
+    }
+    _mergeTokens(tokens, tokenSlots);
+  }
+
+  void _add(
+    final int id,
+    final String name,
+    final double latitude,
+    final double longitude,
+  ) {
+    final List<String> tokens = <String>[];
+    final List<int> tokenSlots = <int>[];
+    _addRecord(id, name, latitude, longitude, tokens, tokenSlots);
+
+    // A single landmark only has a few tokens, inserted in place
+    for (int i = 0; i < tokens.length; i++) {
+      final int pos = _lowerBound(tokens[i]);
+      _tokens.insert(pos, tokens[i]);
+      _tokenSlots.insert(pos, tokenSlots[i]);
+    }
+  }
+
+  // Add the landmark record and collect its tokens, which are not yet indexed
+  void _addRecord(
+    final int id,
+    final String name,
+    final double latitude,
+    final double longitude,
+    final List<String> tokens,
+    final List<int> tokenSlots,
+  ) {
+    if (id < 0) {
+      return;
+    }
+
+    final int slot = _ids.length;
+    _ids.add(id);
+    _names.add(name);
+    _latitudes.add(latitude);
+    _longitudes.add(longitude);
+    _isAlive.add(true);
+    _slotById[id] = slot;
+
+    for (final String token in _tokenize(name, withoutArticle: true)) {
+      tokens.add(token);
+      tokenSlots.add(slot);
+    }
+  }
+
+  // Sort the collected tokens once and merge them with the indexed tokens
+  void _mergeTokens(final List<String> tokens, final List<int> tokenSlots) {
+    if (tokens.isEmpty) {
+      return;
+    }
+
+    final List<int> order =
+        List<int>.generate(tokens.length, (final int i) => i)
+          ..sort(
+            (final int a, final int b) => tokens[a].compareTo(tokens[b]),
+          );
+
+    final List<String> mergedTokens = <String>[];
+    final List<int> mergedSlots = <int>[];
+    int i = 0;
+    int j = 0;
+    while (i < _tokens.length || j < order.length) {
+      final bool takeIndexed = j == order.length ||
+          (i < _tokens.length &&
+              _tokens[i].compareTo(tokens[order[j]]) <= 0);
+      if (takeIndexed) {
+        mergedTokens.add(_tokens[i]);
+        mergedSlots.add(_tokenSlots[i]);
+        i++;
+      } else {
+        mergedTokens.add(tokens[order[j]]);
+        mergedSlots.add(tokenSlots[order[j]]);
+        j++;
+      }
+    }
+
+    _tokens
+      ..clear()
+      ..addAll(mergedTokens);
+    _tokenSlots
+      ..clear()
+      ..addAll(mergedSlots);
+  }
+
+  void _remove(final int id) {
+    final int? slot = _slotById.remove(id);
+    if (slot == null) {
+      return;
+    }
+    _isAlive[slot] = false;
+    _deadCount++;
+
+    // Compact once most of the tokens belong to removed landmarks
+    if (_deadCount > 64 && _deadCount > _slotById.length) {
+      _compact();
+    }
+  }
+
+  void _compact() {
+    final List<int> ids = List<int>.of(_ids);
+    final List<String> names = List<String>.of(_names);
+    final List<double> latitudes = List<double>.of(_latitudes);
+    final List<double> longitudes = List<double>.of(_longitudes);
+    final List<bool> isAlive = List<bool>.of(_isAlive);
+
+    onAllLandmarksRemoved();
+    final List<String> tokens = <String>[];
+    final List<int> tokenSlots = <int>[];
+    for (int slot = 0; slot < ids.length; slot++) {
+      if (isAlive[slot]) {
+        _addRecord(
+          ids[slot],
+          names[slot],
+          latitudes[slot],
+          longitudes[slot],
+          tokens,
+          tokenSlots,
+        );
+      }
+    }
+    _mergeTokens(tokens, tokenSlots);
+  }
+
+  bool _load(final Uint8List bytes) {
+    if (bytes.length < 12) {
+      return false;
+    }
+    final ByteData data = ByteData.sublistView(bytes);
+    if (data.getUint32(0) != _magic || data.getUint32(4) != _version) {
+      return false;
+    }
+
+    final int count = data.getUint32(8);
+    final List<String> tokens = <String>[];
+    final List<int> tokenSlots = <int>[];
+    int offset = 12;
+    for (int i = 0; i < count; i++) {
+      if (offset + _recordHeaderSize > bytes.length) {
+        onAllLandmarksRemoved();
+        return false;
+      }
+      final int id = data.getInt64(offset);
+      final double latitude = data.getFloat64(offset + 8);
+      final double longitude = data.getFloat64(offset + 16);
+      final int nameLength = data.getUint32(offset + 24);
+      offset += _recordHeaderSize;
+      if (offset + nameLength > bytes.length) {
+        onAllLandmarksRemoved();
+        return false;
+      }
+      final String name = utf8.decode(
+        Uint8List.sublistView(bytes, offset, offset + nameLength),
+      );
+      offset += nameLength;
+      _addRecord(id, name, latitude, longitude, tokens, tokenSlots);
+    }
+    _mergeTokens(tokens, tokenSlots);
+
+    return true;
+  }
+
+  Map<int, int> _matchWord(
+    final String word,
+    final int maxEdits,
+    final Map<int, int>? restrictTo,
+  ) {
+    final Map<int, int> matches = <int, int>{};
+
+    void addMatch(final int slot, final int edits) {
+      if (!_isAlive[slot] ||
+          (restrictTo != null && !restrictTo.containsKey(slot))) {
+        return;
+      }
+      final int? previous = matches[slot];
+      if (previous == null || edits < previous) {
+        matches[slot] = edits;
+      }
+    }
+
+    // Exact prefix matches form a contiguous range of the sorted tokens
+    int i = _lowerBound(word);
+    while (i < _tokens.length && _tokens[i].startsWith(word)) {
+      addMatch(_tokenSlots[i], 0);
+      i++;
+    }
+
+    if (maxEdits > 0) {
+      _matchFuzzy(word, maxEdits, addMatch);
+    }
+
+    return matches;
+  }
+
+  // Walk the sorted tokens as a trie. Tokens sharing a prefix share the edit
+  // distance columns computed for it, and the tokens below a prefix that is
+  // already too far from the word are skipped with a single range lookup
+  void _matchFuzzy(
+    final String word,
+    final int maxEdits,
+    final void Function(int slot, int edits) addMatch,
+  ) {
+    final int n = word.length;
+    final int maxDepth = n + maxEdits;
+
+    // columns[d][i] is the edit distance between the first i characters of
+    // the word and the first d characters of the current token
+    final List<Int32List> columns = <Int32List>[
+      Int32List.fromList(List<int>.generate(n + 1, (final int i) => i)),
+    ];
+    // best[d] is the edit distance between the word and the closest prefix of
+    // the first d characters of the current token
+    final Int32List best = Int32List(maxDepth + 1)..[0] = n;
+
+    String path = '';
+    int pathDepth = 0;
+    int t = 0;
+    while (t < _tokens.length) {
+      final String token = _tokens[t];
+      final int length = min(token.length, maxDepth);
+
+      int depth = 0;
+      while (depth < pathDepth &&
+          depth < length &&
+          path.codeUnitAt(depth) == token.codeUnitAt(depth)) {
+        depth++;
+      }
+
+      bool isPruned = false;
+      while (depth < length) {
+        depth++;
+        if (columns.length <= depth) {
+          columns.add(Int32List(n + 1));
+        }
+        final Int32List prev = columns[depth - 1];
+        final Int32List cur = columns[depth];
+        final int tc = token.codeUnitAt(depth - 1);
+        cur[0] = depth;
+        int columnMin = depth;
+        for (int i = 1; i <= n; i++) {
+          final int cost = word.codeUnitAt(i - 1) == tc ? 0 : 1;
+          final int value =
+              min(min(prev[i] + 1, cur[i - 1] + 1), prev[i - 1] + cost);
+          cur[i] = value;
+          if (value < columnMin) {
+            columnMin = value;
+          }
+        }
+        best[depth] = min(best[depth - 1], cur[n]);
+        if (columnMin > maxEdits) {
+          isPruned = true;
+          break;
+        }
+      }
+      path = token;
+      pathDepth = depth;
+
+      final int edits = best[depth];
+      if (!isPruned) {
+        if (edits <= maxEdits) {
+          addMatch(_tokenSlots[t], edits);
+        }
+        t++;
+        continue;
+      }
+
+      // Longer prefixes cannot get closer, so all the tokens below this one
+      // share its result
+      final int end = _prefixEnd(token.substring(0, depth), t);
+      if (edits <= maxEdits) {
+        for (int k = t; k < end; k++) {
+          addMatch(_tokenSlots[k], edits);
+        }
+      }
+      t = end;
+    }
+  }
+
+  // Index of the first token after the tokens starting with prefix
+  int _prefixEnd(final String prefix, final int from) {
+    int low = from;
+    int high = _tokens.length;
+    while (low < high) {
+      final int mid = (low + high) >> 1;
+      final String token = _tokens[mid];
+      if (token.startsWith(prefix) || token.compareTo(prefix) < 0) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  int _lowerBound(final String token) {
+    int low = 0;
+    int high = _tokens.length;
+    while (low < high) {
+      final int mid = (low + high) >> 1;
+      if (_tokens[mid].compareTo(token) < 0) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+    return low;
+  }
+
+  static double _distance(
+    final double lat1,
+    final double lon1,
+    final double cosLat1,
+    final double lat2,
+    final double lon2,
+  ) {
+    const double metersPerDegree = 111195;
+    final double dx = (lon2 - lon1) * cosLat1;
+    final double dy = lat2 - lat1;
+    return sqrt(dx * dx + dy * dy) * metersPerDegree;
+  }
+
+  static List<String> _tokenize(
+    final String text, {
+    required final bool withoutArticle,
+  }) {
+    final List<String> tokens = <String>[];
+    for (final String token in _normalize(text).split(' ')) {
+      if (token.isEmpty) {
+        continue;
+      }
+      tokens.add(token);
+      if (withoutArticle &&
+          token.length > 3 &&
+          token.codeUnitAt(0) == _arabicAlef &&
+          token.codeUnitAt(1) == _arabicLam) {
+        tokens.add(token.substring(2));
+      }
+    }
+    return tokens;
+  }
+
+  /// Normalize a text as the indexed names and the queries are.
+  ///
+  /// The text is lower cased, Arabic letter variants and digits are folded to their base form, Latin letters lose their diacritics, Arabic vowel marks and tatweel are removed, and any other character becomes a space.
+  @visibleForTesting
+  static String normalize(final String text) => _normalize(text);
+
+  static String _normalize(final String text) {
+    final StringBuffer buffer = StringBuffer();
+    for (final int rune in text.toLowerCase().runes) {
+      final int? mapped = _characterMap[rune];
+      if (mapped != null) {
+        if (mapped >= 0) {
+          buffer.writeCharCode(mapped);
+        }
+        continue;
+      }
+      final bool isDiacritic = (rune >= 0x064B && rune <= 0x065F) ||
+          rune == 0x0670 ||
+          rune == 0x0640 ||
+          (rune >= 0x0300 && rune <= 0x036F);
+      if (isDiacritic) {
+        continue;
+      }
+      final bool isWordChar = (rune >= 0x30 && rune <= 0x39) ||
+          (rune >= 0x61 && rune <= 0x7A) ||
+          (rune >= 0x0621 && rune <= 0x064A) ||
+          rune >= 0x00C0;
+      buffer.writeCharCode(isWordChar ? rune : 0x20);
+    }
+    return buffer.toString();
+  }
+
+  // Characters replaced during normalization. -1 removes the character.
+  static final Map<int, int> _characterMap = <int, int>{
+    // Alef variants
+    0x0622: _arabicAlef,
+    0x0623: _arabicAlef,
+    0x0625: _arabicAlef,
+    0x0671: _arabicAlef,
+    // Alef maksura and yeh with hamza
+    0x0649: 0x064A,
+    0x0626: 0x064A,
+    // Teh marbuta
+    0x0629: 0x0647,
+    // Waw with hamza
+    0x0624: 0x0648,
+    // Isolated hamza
+    0x0621: -1,
+    // Arabic-Indic and extended Arabic-Indic digits
+    for (int d = 0; d < 10; d++) 0x0660 + d: 0x30 + d,
+    for (int d = 0; d < 10; d++) 0x06F0 + d: 0x30 + d,
+    // Latin letters with diacritics
+    for (final int c in 'àáâãäåā'.runes) c: 0x61,
+    for (final int c in 'çćč'.runes) c: 0x63,
+    for (final int c in 'èéêëēę'.runes) c: 0x65,
+    for (final int c in 'ìíîïī'.runes) c: 0x69,
+    for (final int c in 'ñń'.runes) c: 0x6E,
+    for (final int c in 'òóôõöøō'.runes) c: 0x6F,
+    for (final int c in 'ùúûüū'.runes) c: 0x75,
+    for (final int c in 'ýÿ'.runes) c: 0x79,
+    for (final int c in 'śš'.runes) c: 0x73,
+    for (final int c in 'źżž'.runes) c: 0x7A,
+  };
+
+  static const int _arabicAlef = 0x0627;
+  static const int _arabicLam = 0x0644;
+
+  static const int _magic = 0x4C504958;
+  static const int _version = 1;
+  static const int _recordHeaderSize = 28;
+}
@@ -0,0 +1,414 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/src/landmarkstore/landmark_browse_session.dart';
+import 'package:meta/meta.dart';
+
+/// Position in the order of a [LandmarkBrowseSession], right after a given landmark.
+///
+/// The cursor is made of the sort key of the landmark, not only of its position, so it stays valid when landmarks are added or removed and when it is used with a new session having the same settings.
+///
+/// {@category Places}
+class LandmarkPageCursor {
+  /// Create a cursor.
+  ///
+  /// Cursors are usually obtained from [LandmarkRecordPage.nextCursor].
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *landmarkId* The id of the last landmark already browsed.
+  /// * **IN** *position* The position of the landmark in the session. Used as a hint.
+  /// * **IN** *sortKey* The sort key of the landmark: the name for [LandmarkOrder.name], the timestamp in milliseconds for [LandmarkOrder.date], the distance in meters for [LandmarkOrder.distance].
+  const LandmarkPageCursor({
+    required this.landmarkId,
+    required this.position,
+    required this.sortKey,
+  });
+
+  /// The id of the last landmark already browsed.
+  final int landmarkId;
+
+  /// The position of the landmark in the session it was obtained from.
+  final int position;
+
+  /// The sort key of the landmark.
+  final Comparable<dynamic> sortKey;
+
+  @override
+  bool operator ==(covariant LandmarkPageCursor other) =>
+      other.landmarkId == landmarkId &&
+      other.position == position &&
+      other.sortKey == sortKey;
+
+  @override
+  int get hashCode =>
+      landmarkId.hashCode ^ position.hashCode ^ sortKey.hashCode;
+}
+
+/// Page of landmarks of a [LandmarkBrowseSession], stored as compact records in a single buffer.
+///
+/// A page holds no native objects and reading its fields does not call the SDK.
+/// Use [LandmarkBrowseSession.getLandmarkRecords] or [LandmarkBrowsePager] to obtain pages.
+///
+/// {@category Places}
+class LandmarkRecordPage {
+  @internal
+  LandmarkRecordPage.init({
+    required this.buffer,
+    required this.length,
+    required this.startPosition,
+    required this.totalCount,
+    required this.nextCursor,
+  }) : _data = ByteData.sublistView(buffer);
+
+  /// The records followed by the UTF-8 encoded names.
+  ///
+  /// Each record has [recordSize] bytes: id (int32), category id (int32), latitude (float64), longitude (float64), timestamp in milliseconds (int64), name offset (uint32) and name length in bytes (uint32).
+  /// All values are in host byte order.
+  final Uint8List buffer;
+
+  /// Number of landmarks in the page.
+  final int length;
+
+  /// The position of the first landmark of the page in the session.
+  final int startPosition;
+
+  /// Number of landmarks in the session.
+  final int totalCount;
+
+  /// Cursor to the landmarks after this page. Null if this is the last page.
+  final LandmarkPageCursor? nextCursor;
+
+  final ByteData _data;
+
+  /// Size of a record in bytes.
+  static const int recordSize = 40;
+
+  /// Check if the page is empty.
+  bool get isEmpty => length == 0;
+
+  /// Get the landmark id of the record at the given index.
+  int idAt(final int index) =>
+      _data.getInt32(_offset(index), Endian.host);
+
+  /// Get the category id of the record at the given index.
+  int categoryIdAt(final int index) =>
+      _data.getInt32(_offset(index) + 4, Endian.host);
+
+  /// Get the latitude of the record at the given index.
+  double latitudeAt(final int index) =>
+      _data.getFloat64(_offset(index) + 8, Endian.host);
+
+  /// Get the longitude of the record at the given index.
+  double longitudeAt(final int index) =>
+      _data.getFloat64(_offset(index) + 16, Endian.host);
+
+  /// Get the timestamp of the record at the given index.
+  DateTime timeStampAt(final int index) => DateTime.fromMillisecondsSinceEpoch(
+        _data.getInt64(_offset(index) + 24, Endian.host),
+        isUtc: true,
+      );
+
+  /// Get the coordinates of the record at the given index.
+  Coordinates coordinatesAt(final int index) =>
+      Coordinates(latitude: latitudeAt(index), longitude: longitudeAt(index));
+
+  /// Get the name of the record at the given index.
+  ///
+  /// The name is decoded on each call.
+  String nameAt(final int index) {
+    final int offset = _offset(index);
+    final int start = _data.getUint32(offset + 32, Endian.host);
+    final int end = start + _data.getUint32(offset + 36, Endian.host);
+    return utf8.decode(Uint8List.sublistView(buffer, start, end));
+  }
+
+  int _offset(final int index) {
+    RangeError.checkValidIndex(index, this, 'index', length);
+    return index * recordSize;
+  }
+}
+
+/// Builds a [LandmarkRecordPage] from the landmarks of a session, a few landmarks at a time.
+@internal
+class LandmarkRecordPageBuilder {
+  LandmarkRecordPageBuilder(
+    this.settings,
+    this.startPosition,
+    this.totalCount,
+    this._landmarks,
+  )   : _records = ByteData(_landmarks.length * LandmarkRecordPage.recordSize),
+        _names = List<Uint8List>.filled(_landmarks.length, Uint8List(0));
+
+  final LandmarkBrowseSessionSettings settings;
+  final int startPosition;
+  final int totalCount;
+  final List<Landmark> _landmarks;
+  final ByteData _records;
+  final List<Uint8List> _names;
+  int _done = 0;
+  Comparable<dynamic>? _lastKey;
+
+  /// Check if all the landmarks were read.
+  bool get isDone => _done == _landmarks.length;
+
+  /// Read the fields of at most [count] more landmarks.
+  void step(final int count) {
+    final int end = (_done + count).clamp(0, _landmarks.length);
+    for (; _done < end; _done++) {
+      final Landmark landmark = _landmarks[_done];
+      final Coordinates coords = landmark.coordinates;
+      final int timestamp = landmark.timeStamp.millisecondsSinceEpoch;
+      final String name = landmark.name;
+      final int offset = _done * LandmarkRecordPage.recordSize;
+
+      _records
+        ..setInt32(offset, landmark.id, Endian.host)
+        ..setInt32(offset + 4, _categoryOf(landmark), Endian.host)
+        ..setFloat64(offset + 8, coords.latitude, Endian.host)
+        ..setFloat64(offset + 16, coords.longitude, Endian.host)
+        ..setInt64(offset + 24, timestamp, Endian.host);
+      _names[_done] = utf8.encode(name);
+
+      if (_done == _landmarks.length - 1) {
+        _lastKey = sortKeyOf(settings, name, timestamp, coords);
+      }
+    }
+  }
+
+  /// Assemble the page. All the landmarks must have been read.
+  LandmarkRecordPage build() {
+    final int recordsSize = _records.lengthInBytes;
+    int namesSize = 0;
+    for (final Uint8List name in _names) {
+      namesSize += name.length;
+    }
+
+    final Uint8List buffer = Uint8List(recordsSize + namesSize)
+      ..setRange(0, recordsSize, _records.buffer.asUint8List());
+    final ByteData data = ByteData.sublistView(buffer);
+    int nameOffset = recordsSize;
+    for (int i = 0; i < _names.length; i++) {
+      final Uint8List name = _names[i];
+      buffer.setRange(nameOffset, nameOffset + name.length, name);
+      final int offset = i * LandmarkRecordPage.recordSize;
+      data
+        ..setUint32(offset + 32, nameOffset, Endian.host)
+        ..setUint32(offset + 36, name.length, Endian.host);
+      nameOffset += name.length;
+    }
+
+    final int endPosition = startPosition + _landmarks.length;
+    return LandmarkRecordPage.init(
+      buffer: buffer,
+      length: _landmarks.length,
+      startPosition: startPosition,
+      totalCount: totalCount,
+      nextCursor: _landmarks.isEmpty || endPosition >= totalCount
+          ? null
+          : LandmarkPageCursor(
+              landmarkId: data.getInt32(
+                recordsSize - LandmarkRecordPage.recordSize,
+                Endian.host,
+              ),
+              position: endPosition - 1,
+              sortKey: _lastKey!,
+            ),
+    );
+  }
+
+  int _categoryOf(final Landmark landmark) {
+    if (settings.categoryIdFilter != LandmarkStore.invalidLandmarkCategId) {
+      return settings.categoryIdFilter;
+    }
+    final List<LandmarkCategory> categories = landmark.categories;
+    return categories.isEmpty
+        ? LandmarkStore.uncategorizedLandmarkCategId
+        : categories.first.id;
+  }
+
+  /// Get the sort key of a landmark for the order given by the settings.
+  static Comparable<dynamic> sortKeyOf(
+    final LandmarkBrowseSessionSettings settings,
+    final String name,
+    final int timestamp,
+    final Coordinates coordinates,
+  ) {
+    switch (settings.orderBy) {
+      case LandmarkOrder.name:
+        return name.toLowerCase();
+      case LandmarkOrder.date:
+        return timestamp;
+      case LandmarkOrder.distance:
+        return coordinates.distance(settings.coordinates);
+    }
+  }
+}
+
+/// Browses the landmarks of a [LandmarkBrowseSession] page by page, preparing the next page in advance.
+///
+/// While the application shows a page, the next one is read in small slices between event loop turns, so the UI thread is never blocked for a whole page.
+/// Pages already read are kept in a small cache so scrolling back does not read them again.
+///
+/// {@category Places}
+class LandmarkBrowsePager {
+  /// Create a pager over a session.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *session* The browse session.
+  /// * **IN** *pageSize* The number of landmarks in a page.
+  /// * **IN** *prefetch* Prepare the next page as soon as a page is returned.
+  /// * **IN** *cachedPages* The number of pages kept in memory.
+  /// * **IN** *sliceSize* The number of landmarks read between two event loop turns while prefetching.
+  LandmarkBrowsePager(
+    this.session, {
+    this.pageSize = 200,
+    this.prefetch = true,
+    this.cachedPages = 8,
+    this.sliceSize = 25,
+  }) : _settings = session.settings;
+
+  /// The browse session.
+  final LandmarkBrowseSession session;
+
+  /// The number of landmarks in a page.
+  final int pageSize;
+
+  /// Prepare the next page as soon as a page is returned.
+  final bool prefetch;
+
+  /// The number of pages kept in memory.
+  final int cachedPages;
+
+  /// The number of landmarks read between two event loop turns while prefetching.
+  final int sliceSize;
+
+  final LandmarkBrowseSessionSettings _settings;
+  final Map<int, LandmarkRecordPage> _pages = <int, LandmarkRecordPage>{};
+  final Map<int, Future<LandmarkRecordPage>> _pending =
+      <int, Future<LandmarkRecordPage>>{};
+  bool _isDisposed = false;
+
+  /// Get the page after the given cursor.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *after* The cursor returned by the previous page. If null, the first page is returned.
+  ///
+  /// **Returns**
+  ///
+  /// * The page. It is empty if there are no more landmarks.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  Future<LandmarkRecordPage> next({final LandmarkPageCursor? after}) {
+    final int start = session.resolveCursor(after, settings: _settings);
+    return pageAt(start);
+  }
+
+  /// Get the page starting at the given position.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *start* The position of the first landmark of the page.
+  ///
+  /// **Returns**
+  ///
+  /// * The page. It is empty if there are no more landmarks.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  Future<LandmarkRecordPage> pageAt(final int start) async {
+    final LandmarkRecordPage? cached = _pages.remove(start);
+    final LandmarkRecordPage page;
+    if (cached != null) {
+      page = cached;
+    } else {
+      final Future<LandmarkRecordPage>? pending = _pending[start];
+      page = pending != null
+          ? await pending
+          : (session.recordPageBuilder(start, pageSize, _settings)
+                ..step(pageSize))
+              .build();
+    }
+    _keep(start, page);
+
+    final int nextStart = start + page.length;
+    if (prefetch &&
+        !_isDisposed &&
+        page.nextCursor != null &&
+        !_pages.containsKey(nextStart) &&
+        !_pending.containsKey(nextStart)) {
+      _pending[nextStart] = _prefetch(nextStart);
+    }
+    return page;
+  }
+
+  /// Get the page containing the given position, if it is cached.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *position* The position of a landmark in the session.
+  ///
+  /// **Returns**
+  ///
+  /// * The cached page containing the position, or null.
+  LandmarkRecordPage? cachedPageFor(final int position) {
+    for (final LandmarkRecordPage page in _pages.values) {
+      if (position >= page.startPosition &&
+          position < page.startPosition + page.length) {
+        return page;
+      }
+    }
+    return null;
+  }
+
+  /// Drop the cached pages and stop prefetching.
+  void dispose() {
+    _isDisposed = true;
+    _pages.clear();
+    _pending.clear();
+  }
+
+  Future<LandmarkRecordPage> _prefetch(final int start) async {
+    try {
+      await Future<void>.delayed(Duration.zero);
+      final LandmarkRecordPageBuilder builder =
+          session.recordPageBuilder(start, pageSize, _settings);
+      while (!builder.isDone) {
+        builder.step(sliceSize);
+        await Future<void>.delayed(Duration.zero);
+      }
+      final LandmarkRecordPage page = builder.build();
+      if (!_isDisposed) {
+        _keep(start, page);
+      }
+      return page;
+    } finally {
+      _pending.remove(start);
+    }
+  }
+
+  void _keep(final int start, final LandmarkRecordPage page) {
+    _pages.remove(start);
+    _pages[start] = page;
+    while (_pages.length > cachedPages) {
+      _pages.remove(_pages.keys.first);
+    }
+  }
+}
@@ -0,0 +1,740 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/src/landmarkstore/landmark_store_observer.dart';
+import 'package:meta/meta.dart';
+
+/// Compact results of a [LandmarkSpatialIndex] query.
+///
+/// Result `i` is made of `ids[i]`, `coordinates[2 * i]` (latitude), `coordinates[2 * i + 1]` (longitude) and `distances[i]`.
+///
+/// {@category Places}
+class LandmarkSpatialResults {
+  /// Create the results.
+  LandmarkSpatialResults({
+    required this.ids,
+    required this.coordinates,
+    required this.distances,
+    required this.totalCount,
+  });
+
+  /// The landmark ids.
+  final Int32List ids;
+
+  /// The landmark coordinates, as interleaved latitude and longitude values.
+  final Float64List coordinates;
+
+  /// The distance in meters from the query position. 0 for area queries.
+  final Float64List distances;
+
+  /// Number of landmarks matching the query, of which only a page is returned.
+  final int totalCount;
+
+  /// Number of results in this page.
+  int get length => ids.length;
+
+  /// Get the latitude of the result at [index].
+  double latitudeAt(final int index) => coordinates[2 * index];
+
+  /// Get the longitude of the result at [index].
+  double longitudeAt(final int index) => coordinates[2 * index + 1];
+}
+
+/// Spatial index over the landmarks of a [LandmarkStore].
+///
+/// Landmark coordinates are bucketed in a regular latitude/longitude grid kept in memory, so queries do not cross the native bridge and do not create [Landmark] objects.
+/// Landmarks added, updated or removed through the [LandmarkStore] methods are reflected in the index as they happen.
+/// Use [toBytes] and [LandmarkSpatialIndex.fromBytes] to persist the index between application runs.
+///
+/// Distances are computed with the equirectangular approximation, accurate for the distances at which nearby landmarks are looked up.
+///
+/// {@category Places}
+class LandmarkSpatialIndex implements LandmarkStoreObserver {
+  LandmarkSpatialIndex._(this._store, this._storeId, this.cellSize);
+
+  /// Build an index of landmark positions which is not attached to a store.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *positions* The landmark positions, by landmark id.
+  /// * **IN** *cellSize* Size of the grid cells in degrees.
+  /// * **IN** *categoryId* The category of the landmarks.
+  @visibleForTesting
+  LandmarkSpatialIndex.detached(
+    final Map<int, Coordinates> positions, {
+    this.cellSize = 0.01,
+    final int categoryId = LandmarkStore.uncategorizedLandmarkCategId,
+  })  : _store = null,
+        _storeId = -1 {
+    for (final MapEntry<int, Coordinates> entry in positions.entries) {
+      _add(
+        entry.key,
+        entry.value.latitude,
+        entry.value.longitude,
+        categoryId,
+      );
+    }
+  }
+
+  /// Build the index from the landmarks of a store.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *store* The landmark store to be indexed.
+  /// * **IN** *cellSize* Size of the grid cells in degrees. Cells should hold a few tens of landmarks for the best performance.
+  ///
+  /// **Returns**
+  ///
+  /// * The index, following the changes of the store until [dispose] is called.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  static LandmarkSpatialIndex build(
+    final LandmarkStore store, {
+    final double cellSize = 0.01,
+  }) {
+    final LandmarkSpatialIndex index =
+        LandmarkSpatialIndex._(store, store.id, cellSize).._addAll();
+    LandmarkStoreObservers.add(index._storeId, index);
+    return index;
+  }
+
+  /// Load an index saved with [toBytes].
+  ///
+  /// The index is rebuilt from the store if the saved data is invalid or if its landmark count does not match the store.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *store* The indexed landmark store.
+  /// * **IN** *bytes* The saved index.
+  ///
+  /// **Returns**
+  ///
+  /// * The index, following the changes of the store until [dispose] is called.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  static LandmarkSpatialIndex fromBytes(
+    final LandmarkStore store,
+    final Uint8List bytes,
+  ) {
+    final LandmarkSpatialIndex? loaded = _load(store, bytes);
+    if (loaded == null || loaded.length != store.getLandmarkCount()) {
+      return build(store, cellSize: loaded?.cellSize ?? 0.01);
+    }
+
+    LandmarkStoreObservers.add(loaded._storeId, loaded);
+    return loaded;
+  }
+
+  // Null for a detached index
+  final LandmarkStore? _store;
+  final int _storeId;
+
+  /// Size of the grid cells in degrees.
+  final double cellSize;
+
+  // Landmark records, by slot
+  final List<int> _ids = <int>[];
+  final List<double> _latitudes = <double>[];
+  final List<double> _longitudes = <double>[];
+  final List<int> _categories = <int>[];
+  final Map<int, int> _slotById = <int, int>{};
+  // Slots of the removed landmarks, reused by the next additions
+  final List<int> _freeSlots = <int>[];
+
+  // Slots by grid cell
+  final Map<int, List<int>> _cells = <int, List<int>>{};
+
+  /// Number of indexed landmarks.
+  int get length => _slotById.length;
+
+  /// Get the landmarks closest to a position.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *position* The reference position.
+  /// * **IN** *count* Maximum number of landmarks returned.
+  /// * **IN** *maxDistance* Landmarks further than this distance in meters are ignored.
+  /// * **IN** *categoryId* Only landmarks in this category are considered. Use [LandmarkStore.invalidLandmarkCategId] for all categories.
+  ///
+  /// **Returns**
+  ///
+  /// * The landmarks sorted by distance. [LandmarkSpatialResults.totalCount] is the number of returned landmarks.
+  LandmarkSpatialResults nearest(
+    final Coordinates position,
+    final int count, {
+    final double maxDistance = double.infinity,
+    final int categoryId = LandmarkStore.invalidLandmarkCategId,
+  }) {
+    final _Query query = _Query(position, categoryId);
+    if (count <= 0 || _slotById.isEmpty) {
+      return _toResults(query, <int>[], 0, 0, 0);
+    }
+
+    final int centerRow = _row(position.latitude);
+    final int centerCol = _col(position.longitude);
+    // Minimal distance covered by one ring of cells around the center cell
+    final double ringDistance =
+        cellSize * _metersPerDegree * max(query.cosLat, 0.01);
+    final int maxRing = maxDistance.isFinite
+        ? (maxDistance / ringDistance).ceil() + 1
+        : _maxRows;
+
+    final List<int> found = <int>[];
+    // Rings wider than the grid wrap around to cells already visited
+    final Set<int> visited = <int>{};
+    for (int ring = 0; ring <= maxRing; ring++) {
+      // Fall back to a full scan when the rings cover more cells than the non empty ones
+      if (8 * ring > _cells.length) {
+        found
+          ..clear()
+          ..addAll(_scan(query, maxDistance));
+        break;
+      }
+
+      _visitRing(centerRow, centerCol, ring, visited, (final List<int> slots) {
+        for (final int slot in slots) {
+          if (query.accepts(this, slot) &&
+              query.distanceTo(this, slot) <= maxDistance) {
+            found.add(slot);
+          }
+        }
+      });
+
+      if (found.length >= count) {
+        _sortByDistance(query, found);
+        final double kth = query.distanceTo(this, found[count - 1]);
+        // Landmarks in the next rings are at least ring * ringDistance away
+        if (kth <= ring * ringDistance) {
+          break;
+        }
+      }
+    }
+
+    _sortByDistance(query, found);
+    final int length = min(count, found.length);
+    return _toResults(query, found, 0, length, length);
+  }
+
+  /// Get the landmarks within a distance from a position.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *center* The reference position.
+  /// * **IN** *radius* The distance in meters.
+  /// * **IN** *offset* Number of landmarks to skip, for paging.
+  /// * **IN** *limit* Maximum number of landmarks returned.
+  /// * **IN** *categoryId* Only landmarks in this category are considered. Use [LandmarkStore.invalidLandmarkCategId] for all categories.
+  ///
+  /// **Returns**
+  ///
+  /// * The requested page of landmarks, sorted by distance.
+  LandmarkSpatialResults withinRadius(
+    final Coordinates center,
+    final double radius, {
+    final int offset = 0,
+    final int limit = 100,
+    final int categoryId = LandmarkStore.invalidLandmarkCategId,
+  }) {
+    final _Query query = _Query(center, categoryId);
+    final List<int> found = _collectRadius(query, radius);
+    _sortByDistance(query, found);
+    return _page(query, found, offset, limit);
+  }
+
+  /// Count the landmarks within a distance from a position.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *center* The reference position.
+  /// * **IN** *radius* The distance in meters.
+  /// * **IN** *categoryId* Only landmarks in this category are considered. Use [LandmarkStore.invalidLandmarkCategId] for all categories.
+  ///
+  /// **Returns**
+  ///
+  /// * The number of landmarks
+  int countWithinRadius(
+    final Coordinates center,
+    final double radius, {
+    final int categoryId = LandmarkStore.invalidLandmarkCategId,
+  }) =>
+      _collectRadius(_Query(center, categoryId), radius).length;
+
+  /// Get the landmarks inside a rectangle, such as the visible map area.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *area* The rectangle.
+  /// * **IN** *offset* Number of landmarks to skip, for paging.
+  /// * **IN** *limit* Maximum number of landmarks returned.
+  /// * **IN** *categoryId* Only landmarks in this category are considered. Use [LandmarkStore.invalidLandmarkCategId] for all categories.
+  ///
+  /// **Returns**
+  ///
+  /// * The requested page of landmarks, in grid order.
+  LandmarkSpatialResults inArea(
+    final RectangleGeographicArea area, {
+    final int offset = 0,
+    final int limit = 100,
+    final int categoryId = LandmarkStore.invalidLandmarkCategId,
+  }) {
+    final _Query query = _Query.area(categoryId);
+    return _page(query, _collectArea(query, area), offset, limit);
+  }
+
+  /// Count the landmarks inside a rectangle.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *area* The rectangle.
+  /// * **IN** *categoryId* Only landmarks in this category are considered. Use [LandmarkStore.invalidLandmarkCategId] for all categories.
+  ///
+  /// **Returns**
+  ///
+  /// * The number of landmarks
+  int countInArea(
+    final RectangleGeographicArea area, {
+    final int categoryId = LandmarkStore.invalidLandmarkCategId,
+  }) =>
+      _collectArea(_Query.area(categoryId), area).length;
+
+  /// Save the index.
+  ///
+  /// **Returns**
+  ///
+  /// * The saved index, to be loaded with [LandmarkSpatialIndex.fromBytes].
+  Uint8List toBytes() {
+    final ByteData data = ByteData(_headerSize + length * _recordSize)
+      ..setUint32(0, _magic)
+      ..setUint32(4, _version)
+      ..setFloat64(8, cellSize)
+      ..setUint32(16, length);
+
+    int offset = _headerSize;
+    for (final int slot in _slotById.values) {
+      data
+        ..setInt32(offset, _ids[slot])
+        ..setInt32(offset + 4, _categories[slot])
+        ..setFloat64(offset + 8, _latitudes[slot])
+        ..setFloat64(offset + 16, _longitudes[slot]);
+      offset += _recordSize;
+    }
+
+    return data.buffer.asUint8List();
+  }
+
+  /// Stop following the changes of the store.
+  void dispose() => LandmarkStoreObservers.remove(_storeId, this);
+
+  @override
+  void onLandmarkAdded(final Landmark landmark, final int categoryId) {
+    final int id = landmark.id;
+    final int? slot = _slotById[id];
+    if (slot != null) {
+      _categories[slot] = categoryId;
+      return;
+    }
+    final Coordinates coords = landmark.coordinates;
+    _add(id, coords.latitude, coords.longitude, categoryId);
+  }
+
+  @override
+  void onLandmarkUpdated(final Landmark landmark) {
+    final int id = landmark.id;
+    final int? slot = _slotById[id];
+    final int categoryId = slot != null
+        ? _categories[slot]
+        : LandmarkStore.uncategorizedLandmarkCategId;
+    final Coordinates coords = landmark.coordinates;
+    _remove(id);
+    _add(id, coords.latitude, coords.longitude, categoryId);
+  }
+
+  @override
+  void onLandmarkRemoved(final int landmarkId) => _remove(landmarkId);
+
+  @override
+  void onAllLandmarksRemoved() {
+    _ids.clear();
+    _latitudes.clear();
+    _longitudes.clear();
+    _categories.clear();
+    _slotById.clear();
+    _freeSlots.clear();
+    _cells.clear();
+  }
+
+  @override
+  void onLandmarksAdded(
+    final List<Landmark> landmarks,
+    final int categoryId,
+  ) {
+    for (final Landmark landmark in landmarks) {
+      final Coordinates coords = landmark.coordinates;
+      _add(landmark.id, coords.latitude, coords.longitude, categoryId);
+    }
+  }
+
+  void _addAll() {
+    final LandmarkStore store = _store!;
+    final List<int> categoryIds = <int>[
+      LandmarkStore.uncategorizedLandmarkCategId,
+      ...store.categories.map((final LandmarkCategory c) => c.id),
+    ];
+    for (final int categoryId in categoryIds) {
+      for (final Landmark landmark
+          in store.getLandmarks(categoryId: categoryId)) {
+        final Coordinates coords = landmark.coordinates;
+        _add(landmark.id, coords.latitude, coords.longitude, categoryId);
+      }
+    }
+  }
+
+  void _add(
+    final int id,
+    final double latitude,
+    final double longitude,
+    final int categoryId,
+  ) {
+    if (id < 0 || _slotById.containsKey(id)) {
+      return;
+    }
+
+    final int slot;
+    if (_freeSlots.isNotEmpty) {
+      slot = _freeSlots.removeLast();
+      _ids[slot] = id;
+      _latitudes[slot] = latitude;
+      _longitudes[slot] = longitude;
+      _categories[slot] = categoryId;
+    } else {
+      slot = _ids.length;
+      _ids.add(id);
+      _latitudes.add(latitude);
+      _longitudes.add(longitude);
+      _categories.add(categoryId);
+    }
+    _slotById[id] = slot;
+    _cells
+        .putIfAbsent(_cellKey(_row(latitude), _col(longitude)), () => <int>[])
+        .add(slot);
+  }
+
+  void _remove(final int id) {
+    final int? slot = _slotById.remove(id);
+    if (slot == null) {
+      return;
+    }
+
+    try {
+      final int key =
+          _cellKey(_row(_latitudes[slot]), _col(_longitudes[slot]));
+      final List<int>? cell = _cells[key];
+      if (cell != null) {
+        cell.remove(slot);
+        if (cell.isEmpty) {
+          _cells.remove(key);
+        }
+      }
+    } finally {
+      _freeSlots.add(slot);
+    }
+  }
+
+  static LandmarkSpatialIndex? _load(
+    final LandmarkStore store,
+    final Uint8List bytes,
+  ) {
+    if (bytes.length < _headerSize) {
+      return null;
+    }
+    final ByteData data = ByteData.sublistView(bytes);
+    if (data.getUint32(0) != _magic || data.getUint32(4) != _version) {
+      return null;
+    }
+    final double cellSize = data.getFloat64(8);
+    final int count = data.getUint32(16);
+    if (cellSize <= 0 || bytes.length < _headerSize + count * _recordSize) {
+      return null;
+    }
+
+    final LandmarkSpatialIndex index =
+        LandmarkSpatialIndex._(store, store.id, cellSize);
+    int offset = _headerSize;
+    for (int i = 0; i < count; i++) {
+      index._add(
+        data.getInt32(offset),
+        data.getFloat64(offset + 8),
+        data.getFloat64(offset + 16),
+        data.getInt32(offset + 4),
+      );
+      offset += _recordSize;
+    }
+    return index;
+  }
+
+  List<int> _collectRadius(final _Query query, final double radius) {
+    final double latSpan = radius / _metersPerDegree;
+    final double lonSpan =
+        radius / (_metersPerDegree * max(query.cosLat, 0.01));
+    final double south = query.latitude - latSpan;
+    final double north = query.latitude + latSpan;
+    final int rowFrom = _row(south);
+    final int rowTo = _row(north);
+
+    final List<int> found = <int>[];
+    void visitSlots(final List<int> slots) {
+      for (final int slot in slots) {
+        if (query.accepts(this, slot) &&
+            query.distanceTo(this, slot) <= radius) {
+          found.add(slot);
+        }
+      }
+    }
+
+    final double west = query.longitude - lonSpan;
+    final double east = query.longitude + lonSpan;
+    if (south < -90 || north > 90 || east - west >= 360) {
+      // Circles around a pole or wider than the globe cover all longitudes
+      _visitCells(rowFrom, rowTo, 0, _maxCols - 1, visitSlots);
+    } else if (west < -180) {
+      // Split at the antimeridian
+      _visitCells(rowFrom, rowTo, _col(west + 360), _maxCols - 1, visitSlots);
+      _visitCells(rowFrom, rowTo, 0, _col(east), visitSlots);
+    } else if (east > 180) {
+      _visitCells(rowFrom, rowTo, _col(west), _maxCols - 1, visitSlots);
+      _visitCells(rowFrom, rowTo, 0, _col(east - 360), visitSlots);
+    } else {
+      _visitCells(rowFrom, rowTo, _col(west), _col(east), visitSlots);
+    }
+    return found;
+  }
+
+  List<int> _collectArea(
+    final _Query query,
+    final RectangleGeographicArea area,
+  ) {
+    final double north = max(area.topLeft.latitude, area.bottomRight.latitude);
+    final double south = min(area.topLeft.latitude, area.bottomRight.latitude);
+    final double west = area.topLeft.longitude;
+    final double east = area.bottomRight.longitude;
+    // Areas crossing the antimeridian have west > east
+    final bool wraps = west > east;
+
+    final List<int> found = <int>[];
+    void visitSlots(final List<int> slots) {
+      for (final int slot in slots) {
+        final double lat = _latitudes[slot];
+        final double lon = _longitudes[slot];
+        final bool isInsideLon =
+            wraps ? (lon >= west || lon <= east) : (lon >= west && lon <= east);
+        final bool isInside = lat >= south && lat <= north && isInsideLon;
+        if (isInside && query.accepts(this, slot)) {
+          found.add(slot);
+        }
+      }
+    }
+
+    if (wraps) {
+      final int rowFrom = _row(south);
+      final int rowTo = _row(north);
+      _visitCells(rowFrom, rowTo, _col(west), _col(180), visitSlots);
+      _visitCells(rowFrom, rowTo, _col(-180), _col(east), visitSlots);
+    } else {
+      _visitCells(_row(south), _row(north), _col(west), _col(east), visitSlots);
+    }
+    return found;
+  }
+
+  void _visitCells(
+    final int rowFrom,
+    final int rowTo,
+    final int colFrom,
+    final int colTo,
+    final void Function(List<int> slots) visitor,
+  ) {
+    final int cellCount = (rowTo - rowFrom + 1) * (colTo - colFrom + 1);
+    // Iterate the non empty cells instead when the range covers more cells
+    if (cellCount > _cells.length) {
+      for (final MapEntry<int, List<int>> cell in _cells.entries) {
+        final int row = cell.key ~/ _maxCols;
+        final int col = cell.key % _maxCols;
+        if (row >= rowFrom && row <= rowTo && col >= colFrom && col <= colTo) {
+          visitor(cell.value);
+        }
+      }
+      return;
+    }
+
+    for (int row = rowFrom; row <= rowTo; row++) {
+      for (int col = colFrom; col <= colTo; col++) {
+        final List<int>? slots = _cells[_cellKey(row, col)];
+        if (slots != null) {
+          visitor(slots);
+        }
+      }
+    }
+  }
+
+  void _visitRing(
+    final int centerRow,
+    final int centerCol,
+    final int ring,
+    final Set<int> visited,
+    final void Function(List<int> slots) visitor,
+  ) {
+    void visit(final int row, final int col) {
+      if (row < 0 || row >= _maxRows) {
+        return;
+      }
+      final int key = _cellKey(row, _wrapCol(col));
+      final List<int>? slots = _cells[key];
+      if (slots != null && visited.add(key)) {
+        visitor(slots);
+      }
+    }
+
+    if (ring == 0) {
+      visit(centerRow, centerCol);
+      return;
+    }
+    for (int d = -ring; d <= ring; d++) {
+      visit(centerRow - ring, centerCol + d);
+      visit(centerRow + ring, centerCol + d);
+    }
+    for (int d = -ring + 1; d <= ring - 1; d++) {
+      visit(centerRow + d, centerCol - ring);
+      visit(centerRow + d, centerCol + ring);
+    }
+  }
+
+  List<int> _scan(final _Query query, final double maxDistance) {
+    final List<int> found = <int>[];
+    for (final List<int> slots in _cells.values) {
+      for (final int slot in slots) {
+        if (query.accepts(this, slot) &&
+            query.distanceTo(this, slot) <= maxDistance) {
+          found.add(slot);
+        }
+      }
+    }
+    return found;
+  }
+
+  void _sortByDistance(final _Query query, final List<int> slots) {
+    slots.sort(
+      (final int a, final int b) =>
+          query.distanceTo(this, a).compareTo(query.distanceTo(this, b)),
+    );
+  }
+
+  LandmarkSpatialResults _page(
+    final _Query query,
+    final List<int> found,
+    final int offset,
+    final int limit,
+  ) {
+    final int start = min(max(offset, 0), found.length);
+    final int end = min(start + max(limit, 0), found.length);
+    return _toResults(query, found, start, end, found.length);
+  }
+
+  LandmarkSpatialResults _toResults(
+    final _Query query,
+    final List<int> slots,
+    final int start,
+    final int end,
+    final int totalCount,
+  ) {
+    final int length = end - start;
+    final Int32List ids = Int32List(length);
+    final Float64List coordinates = Float64List(2 * length);
+    final Float64List distances = Float64List(length);
+    for (int i = 0; i < length; i++) {
+      final int slot = slots[start + i];
+      ids[i] = _ids[slot];
+      coordinates[2 * i] = _latitudes[slot];
+      coordinates[2 * i + 1] = _longitudes[slot];
+      distances[i] = query.isArea ? 0 : query.distanceTo(this, slot);
+    }
+    return LandmarkSpatialResults(
+      ids: ids,
+      coordinates: coordinates,
+      distances: distances,
+      totalCount: totalCount,
+    );
+  }
+
+  int _row(final double latitude) =>
+      ((latitude.clamp(-90.0, 90.0) + 90) / cellSize)
+          .floor()
+          .clamp(0, _maxRows - 1);
+
+  int _col(final double longitude) =>
+      ((longitude.clamp(-180.0, 180.0) + 180) / cellSize)
+          .floor()
+          .clamp(0, _maxCols - 1);
+
+  int _wrapCol(final int col) => col % _maxCols;
+
+  int get _maxRows => (180 / cellSize).ceil();
+
+  int get _maxCols => (360 / cellSize).ceil();
+
+  int _cellKey(final int row, final int col) => row * _maxCols + col;
+
+  static const double _metersPerDegree = 111195;
+
+  static const int _magic = 0x4C535049;
+  static const int _version = 1;
+  static const int _headerSize = 20;
+  static const int _recordSize = 24;
+}
+
+class _Query {
+  _Query(final Coordinates position, this.categoryId)
+      : latitude = position.latitude,
+        longitude = position.longitude,
+        cosLat = cos(position.latitude * pi / 180),
+        isArea = false;
+
+  _Query.area(this.categoryId)
+      : latitude = 0,
+        longitude = 0,
+        cosLat = 1,
+        isArea = true;
+
+  final double latitude;
+  final double longitude;
+  final double cosLat;
+  final int categoryId;
+  final bool isArea;
+
+  bool accepts(final LandmarkSpatialIndex index, final int slot) =>
+      categoryId == LandmarkStore.invalidLandmarkCategId ||
+      index._categories[slot] == categoryId;
+
+  double distanceTo(final LandmarkSpatialIndex index, final int slot) {
+    double dLon = (index._longitudes[slot] - longitude).abs();
+    if (dLon > 180) {
+      dLon = 360 - dLon;
+    }
+    final double dx = dLon * cosLat;
+    final double dy = index._latitudes[slot] - latitude;
+    return sqrt(dx * dx + dy * dy) * LandmarkSpatialIndex._metersPerDegree;
+  }
+}
@@ -8,7 +8,6 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
 import 'dart:typed_data';
 
 import 'package:gem_kit/core.dart';
@@ -17,6 +16,8 @@ import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/core/lists.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
 import 'package:gem_kit/src/landmarkstore/landmark_browse_session.dart';
+import 'package:gem_kit/src/landmarkstore/landmark_columns.dart';
+import 'package:gem_kit/src/landmarkstore/landmark_store_observer.dart';
 import 'package:meta/meta.dart';
 
 /// Landmark store class
@@ -34,7 +35,7 @@ class LandmarkStore extends GemAutoreleaseObject {
   LandmarkStore.init(final int id, final int mapId)
       : _pointerId = id,
         _mapId = mapId {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'LandmarkStore');
   }
   final int _pointerId;
   final int _mapId;
@@ -43,6 +44,13 @@ class LandmarkStore extends GemAutoreleaseObject {
   int get pointerId => _pointerId;
   int get mapId => _mapId;
 
+  // Store id used to notify the observers, read only when there is an observer
+  late final int _storeId = id;
+
+  List<LandmarkStoreObserver> get _observers => LandmarkStoreObservers.isEmpty
+      ? const <LandmarkStoreObserver>[]
+      : LandmarkStoreObservers.of(_storeId);
+
   /// Add a new category to the store.
   ///
   /// After this method call, the category object that is passed as a parameter belongs to this landmark store. The category must have a name.
@@ -88,6 +96,10 @@ class LandmarkStore extends GemAutoreleaseObject {
         'categoryId': categoryId,
       },
     );
+
+    for (final LandmarkStoreObserver observer in _observers) {
+      observer.onLandmarkAdded(landmark, categoryId);
+    }
   }
 
   /// Get the specified landmark.
@@ -138,6 +150,10 @@ class LandmarkStore extends GemAutoreleaseObject {
       'updateLandmark',
       args: landmark.pointerId,
     );
+
+    for (final LandmarkStoreObserver observer in _observers) {
+      observer.onLandmarkUpdated(landmark);
+    }
   }
 
   /// Checks if the landmark store contains the landmark ID
@@ -423,12 +439,19 @@ class LandmarkStore extends GemAutoreleaseObject {
   ///
   /// * An exception if it fails.
   void removeLandmark(final Landmark landmark) {
+    final List<LandmarkStoreObserver> observers = _observers;
+    final int landmarkId = observers.isEmpty ? -1 : landmark.id;
+
     objectMethod(
       _pointerId,
       'LandmarkStore',
       'removeLandmark',
       args: landmark.pointerId,
     );
+
+    for (final LandmarkStoreObserver observer in observers) {
+      observer.onLandmarkRemoved(landmarkId);
+    }
   }
 
   /// Get the number of all landmarks within the specified category.
@@ -497,6 +520,10 @@ class LandmarkStore extends GemAutoreleaseObject {
       'setLandmarkCategory',
       args: <String, int>{'first': landmark.pointerId, 'second': categoryId},
     );
+
+    for (final LandmarkStoreObserver observer in _observers) {
+      observer.onLandmarkAdded(landmark, categoryId);
+    }
   }
 
   /// Asynchronously import landmarks from given file format
@@ -533,10 +560,21 @@ class LandmarkStore extends GemAutoreleaseObject {
     final EventDrivenProgressListener progressListener =
         EventDrivenProgressListener();
 
-    if (onCompleteCallback != null) {
+    final bool isObserved = _observers.isNotEmpty;
+    final int countBefore =
+        isObserved ? getLandmarkCount(categoryId: categoryId) : 0;
+    if (onCompleteCallback != null || isObserved) {
       progressListener.registerOnCompleteWithDataCallback(
-        (final int err, final String hint, final Map<dynamic, dynamic> json) =>
-            onCompleteCallback(GemErrorExtension.fromCode(err)),
+        (final int err, final String hint, final Map<dynamic, dynamic> json) {
+          final GemError error = GemErrorExtension.fromCode(err);
+          if (isObserved && error == GemError.success) {
+            _notifyLandmarksAdded(
+              categoryId,
+              getLandmarkCount(categoryId: categoryId) - countBefore,
+            );
+          }
+          onCompleteCallback?.call(error);
+        },
       );
     }
 
@@ -607,10 +645,21 @@ class LandmarkStore extends GemAutoreleaseObject {
     final EventDrivenProgressListener progressListener =
         EventDrivenProgressListener();
 
-    if (onCompleteCallback != null) {
+    final bool isObserved = _observers.isNotEmpty;
+    final int countBefore =
+        isObserved ? getLandmarkCount(categoryId: categoryId) : 0;
+    if (onCompleteCallback != null || isObserved) {
       progressListener.registerOnCompleteWithDataCallback(
-        (final int err, final String hint, final Map<dynamic, dynamic> json) =>
-            onCompleteCallback(GemErrorExtension.fromCode(err)),
+        (final int err, final String hint, final Map<dynamic, dynamic> json) {
+          final GemError error = GemErrorExtension.fromCode(err);
+          if (isObserved && error == GemError.success) {
+            _notifyLandmarksAdded(
+              categoryId,
+              getLandmarkCount(categoryId: categoryId) - countBefore,
+            );
+          }
+          onCompleteCallback?.call(error);
+        },
       );
     }
 
@@ -650,6 +699,159 @@ class LandmarkStore extends GemAutoreleaseObject {
     return progressListener;
   }
 
+  /// Add landmarks in bulk, in a single transaction.
+  ///
+  /// The rows are sent to the store as packed import buffers, one per category, instead of creating and adding one [Landmark] at a time.
+  /// If the store is not already in fast update mode, it is switched to it for the whole operation. The changes are then committed only if all the rows were added, otherwise they are discarded.
+  /// If the store is already in fast update mode, it is left in it and the categories imported before a failure are kept. Committing or discarding them is up to the caller.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *columns* The landmarks to be added.
+  /// * **IN** *image* The landmark map image.
+  /// * **IN** *onCompleteCallback* Callback that gets triggered with the associated [GemError] when the operation is completed.
+  ///   * Is called with [GemError.success] if all the landmarks were added and committed
+  ///   * Is called with [GemError.inUse] if an import is already in progress
+  ///   * Is called with [GemError.notFound] if one of the category ids is invalid
+  ///   * Is called with [GemError.cancel] if the operation was canceled with [cancelImportLandmarks]
+  /// * **IN** *onProgressUpdated* Callback that gets triggered with the overall progress, from 0 to 100.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails to initialize.
+  void addLandmarkColumns(
+    final LandmarkColumns columns, {
+    required final Img image,
+    final void Function(GemError error)? onCompleteCallback,
+    final void Function(int progress)? onProgressUpdated,
+  }) {
+    final List<MapEntry<int, List<int>>> groups =
+        columns.rowsByCategory().entries.toList();
+    if (columns.length == 0) {
+      onCompleteCallback?.call(GemError.success);
+      return;
+    }
+
+    final bool wasFastUpdateMode = isFastUpdateMode();
+    if (!wasFastUpdateMode) {
+      startFastUpdateMode();
+    }
+
+    // Number of groups imported so far
+    int importedCount = 0;
+
+    void finish(final GemError error) {
+      final bool isDiscarded = error != GemError.success && !wasFastUpdateMode;
+      if (!wasFastUpdateMode) {
+        stopFastUpdateMode(discard: isDiscarded);
+      }
+      if (!isDiscarded) {
+        for (int i = 0; i < importedCount; i++) {
+          _notifyLandmarksAdded(groups[i].key, groups[i].value.length);
+        }
+      }
+      onCompleteCallback?.call(error);
+    }
+
+    void importGroup(final int index) {
+      importedCount = index;
+      if (index == groups.length) {
+        finish(GemError.success);
+        return;
+      }
+
+      final MapEntry<int, List<int>> group = groups[index];
+      _importBuffer(
+        columns.encodeGeoJson(group.value),
+        image,
+        group.key,
+        onCompleteCallback: (final GemError error) {
+          if (error != GemError.success) {
+            finish(error);
+            return;
+          }
+          importGroup(index + 1);
+        },
+        onProgressUpdated: onProgressUpdated == null
+            ? null
+            : (final int progress) => onProgressUpdated(
+                  (index * 100 + progress) ~/ groups.length,
+                ),
+      );
+    }
+
+    importGroup(0);
+  }
+
+  void _importBuffer(
+    final Uint8List buffer,
+    final Img image,
+    final int categoryId, {
+    required final void Function(GemError error) onCompleteCallback,
+    final void Function(int progress)? onProgressUpdated,
+  }) {
+    final EventDrivenProgressListener progressListener =
+        EventDrivenProgressListener();
+
+    progressListener.registerOnCompleteWithDataCallback(
+      (final int err, final String hint, final Map<dynamic, dynamic> json) {
+        GemKitPlatform.instance.unregisterEventHandler(progressListener.id);
+        onCompleteCallback(GemErrorExtension.fromCode(err));
+      },
+    );
+    if (onProgressUpdated != null) {
+      progressListener.registerOnProgressCallback(onProgressUpdated);
+    }
+
+    GemKitPlatform.instance.registerEventHandler(
+      progressListener.id,
+      progressListener,
+    );
+    final dynamic dataBufferPointer =
+        GemKitPlatform.instance.toNativePointer(buffer);
+    final OperationResult resultString = objectMethod(
+      _pointerId,
+      'LandmarkStore',
+      'importLandmarksWithDataBuffer',
+      args: <String, dynamic>{
+        'dataBuffer': dataBufferPointer.address,
+        'dataBufferSize': buffer.length,
+        'fileFormat': LandmarkFileFormat.geoJson.id,
+        'image': image.pointerId,
+        'categoryId': categoryId,
+        'listener': progressListener.id,
+      },
+    );
+    GemKitPlatform.instance.freeNativePointer(dataBufferPointer);
+    final GemError errorCode = GemErrorExtension.fromCode(
+      resultString['result'],
+    );
+
+    if (errorCode != GemError.success) {
+      GemKitPlatform.instance.unregisterEventHandler(progressListener.id);
+      onCompleteCallback(errorCode);
+    }
+  }
+
+  // The import does not report the ids it assigns. The imported landmarks are
+  // the newest ones of their category, so only that many are read back
+  void _notifyLandmarksAdded(final int categoryId, final int count) {
+    final List<LandmarkStoreObserver> observers = _observers;
+    if (observers.isEmpty || count <= 0) {
+      return;
+    }
+    final List<Landmark> landmarks = createLandmarkBrowseSession(
+      settings: LandmarkBrowseSessionSettings(
+        descendingOrder: true,
+        orderBy: LandmarkOrder.date,
+        categoryIdFilter: categoryId,
+      ),
+    ).getLandmarks(0, count);
+    for (final LandmarkStoreObserver observer in observers) {
+      observer.onLandmarksAdded(landmarks, categoryId);
+    }
+  }
+
   /// Cancel async import landmarks operation
   ///
   /// **Throws**
@@ -782,13 +984,13 @@ class LandmarkStore extends GemAutoreleaseObject {
   /// * An exception if it fails.
   void removeAllLandmarks() {
     objectMethod(_pointerId, 'LandmarkStore', 'removeAllLandmarks');
+
+    for (final LandmarkStoreObserver observer in _observers) {
+      observer.onAllLandmarksRemoved();
+    }
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(
-          <String, dynamic>{'class': 'LandmarkStore', 'id': _pointerId},
-        ),
-      );
+  void dispose() => disposeNative('LandmarkStore', _pointerId);
 }
 
 /// Landmark import supported formats
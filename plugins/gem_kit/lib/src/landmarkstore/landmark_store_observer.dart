@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'package:gem_kit/core.dart';
+import 'package:meta/meta.dart';
+
+/// Receives the landmark changes made through the [LandmarkStore] methods of a store.
+///
+/// Used by the Dart side indexes built over a landmark store to stay up to date without rereading the store.
+/// `LandmarkStoreListener` is not enough for this purpose as it is not triggered for user created landmarks.
+@internal
+abstract class LandmarkStoreObserver {
+  /// A landmark was added to the store or its category was changed.
+  void onLandmarkAdded(final Landmark landmark, final int categoryId);
+
+  /// The information about a landmark of the store was updated.
+  void onLandmarkUpdated(final Landmark landmark);
+
+  /// A landmark was removed from the store.
+  void onLandmarkRemoved(final int landmarkId);
+
+  /// All the landmarks were removed from the store.
+  void onAllLandmarksRemoved();
+
+  /// Landmarks of a category were added to the store in bulk, by an import or a bulk insert.
+  void onLandmarksAdded(final List<Landmark> landmarks, final int categoryId);
+}
+
+/// Registry of the observers, by landmark store id.
+///
+/// Several [LandmarkStore] objects can refer to the same store, so the observers are not kept in the [LandmarkStore] object.
+@internal
+abstract class LandmarkStoreObservers {
+  static final Map<int, List<LandmarkStoreObserver>> _observers =
+      <int, List<LandmarkStoreObserver>>{};
+
+  /// Check if there is any observer registered. Allows skipping the store id lookup.
+  static bool get isEmpty => _observers.isEmpty;
+
+  static void add(final int storeId, final LandmarkStoreObserver observer) {
+    _observers
+        .putIfAbsent(storeId, () => <LandmarkStoreObserver>[])
+        .add(observer);
+  }
+
+  static void remove(final int storeId, final LandmarkStoreObserver observer) {
+    final List<LandmarkStoreObserver>? observers = _observers[storeId];
+    if (observers == null) {
+      return;
+    }
+    observers.remove(observer);
+    if (observers.isEmpty) {
+      _observers.remove(storeId);
+    }
+  }
+
+  static List<LandmarkStoreObserver> of(final int storeId) =>
+      _observers[storeId] ?? const <LandmarkStoreObserver>[];
+}
@@ -17,6 +17,7 @@ import 'package:gem_kit/src/contentstore/content_store_item.dart';
 import 'package:gem_kit/src/core/event_driven_progress_listener.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/core/gem_error.dart';
+import 'package:gem_kit/src/core/gem_scope.dart';
 import 'package:gem_kit/src/core/path.dart';
 import 'package:gem_kit/src/core/types.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
@@ -424,7 +425,7 @@ class FollowPositionPreferences extends GemAutoreleaseObject {
   FollowPositionPreferences.init(final int id, final int mapId)
       : _pointerId = id,
         _mapId = mapId {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: 'FollowPositionPreferences');
   }
   final int _pointerId;
   final int _mapId;
@@ -982,12 +983,7 @@ class FollowPositionPreferences extends GemAutoreleaseObject {
     return resultString['result'];
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'FollowPositionPreferences',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('FollowPositionPreferences', _pointerId);
 }
 
 /// Mapview preferences
@@ -1065,9 +1061,9 @@ class MapViewPreferences {
         'followPositionPreferences',
       );
 
-      _followPositionPreferences = FollowPositionPreferences.init(
-        resultString['result'],
-        _mapId,
+      // Cached for the lifetime of the map, not released by a scope
+      _followPositionPreferences = GemScope.detached(
+        () => FollowPositionPreferences.init(resultString['result'], _mapId),
       );
     }
     return _followPositionPreferences!;
@@ -1503,10 +1499,12 @@ class MapViewPreferences {
         'markers',
       );
 
-      _markers = MapViewMarkerCollections.init(
-        resultString['result'],
-        _mapId,
-        _mapPointerId,
+      _markers = GemScope.detached(
+        () => MapViewMarkerCollections.init(
+          resultString['result'],
+          _mapId,
+          _mapPointerId,
+        ),
       );
     }
     return _markers!;
@@ -1548,7 +1546,9 @@ class MapViewPreferences {
         'paths',
       );
 
-      _paths = MapViewPathCollection.init(resultString['result'], _mapId);
+      _paths = GemScope.detached(
+        () => MapViewPathCollection.init(resultString['result'], _mapId),
+      );
     }
     return _paths!;
   }
@@ -1570,7 +1570,9 @@ class MapViewPreferences {
         'routes',
       );
 
-      _routes = MapViewRoutesCollection.init(resultString['result']);
+      _routes = GemScope.detached(
+        () => MapViewRoutesCollection.init(resultString['result']),
+      );
     }
     return _routes!;
   }
@@ -404,7 +404,7 @@ class Marker extends GemAutoreleaseObject {
 
   @internal
   Marker.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: 'Marker');
   }
 
   final dynamic _pointerId;
@@ -661,11 +661,7 @@ class Marker extends GemAutoreleaseObject {
     return Marker.init(decodedVal['result']);
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, dynamic>{'class': 'Marker', 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative('Marker', _pointerId);
 }
 
 /// Marker collection class
@@ -683,7 +679,7 @@ class MarkerCollection extends GemAutoreleaseObject {
   MarkerCollection.init(final int id, final int mapId)
       : _pointerId = id,
         _mapId = mapId {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'MarkerCollection');
   }
   final int _pointerId;
   final int _mapId;
@@ -996,14 +992,7 @@ class MarkerCollection extends GemAutoreleaseObject {
     return MarkerCollection.init(decodedVal['result'], mapId);
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'MarkerCollection',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('MarkerCollection', _pointerId);
 }
 
 /// Marker match
@@ -1059,7 +1048,10 @@ class MapViewMarkerCollections extends GemAutoreleaseObject {
   )   : _pointerId = id,
         _mapId = mapId,
         _mapPointerId = mapPointerId {
-    super.registerAutoReleaseObject(pointerId);
+    super.registerAutoReleaseObject(
+      pointerId,
+      className: 'MapViewMarkerCollections',
+    );
   }
   final int _pointerId;
   final int _mapId;
@@ -1354,12 +1346,7 @@ class MapViewMarkerCollections extends GemAutoreleaseObject {
         );
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'MapViewMarkerCollections',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('MapViewMarkerCollections', _pointerId);
 }
 
 /// Marker render settings
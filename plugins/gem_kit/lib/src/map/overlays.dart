@@ -179,7 +179,7 @@ class OverlayInfo extends GemAutoreleaseObject {
 
   @internal
   OverlayInfo.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(id, className: 'OverlayInfo');
   }
   final int _pointerId;
   int get pointerId => _pointerId;
@@ -332,11 +332,7 @@ class OverlayInfo extends GemAutoreleaseObject {
     return resultString['result'];
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{'class': 'OverlayInfo', 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative('OverlayInfo', _pointerId);
 }
 
 /// Overlays collection.
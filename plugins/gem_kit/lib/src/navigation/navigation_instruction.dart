@@ -437,7 +437,10 @@ class NavigationInstruction extends GemAutoreleaseObject {
 
   @internal
   NavigationInstruction.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'NavigationInstruction',
+    );
   }
   final int _pointerId;
 
@@ -1143,14 +1146,7 @@ class NavigationInstruction extends GemAutoreleaseObject {
     return TimeDistance.fromJson(resultString['result']);
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'NavigationInstruction',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('NavigationInstruction', _pointerId);
 }
 
 /// The status of a [NextSpeedLimit] item
@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/sense.dart';
+import 'package:gem_kit/src/position/gem_position.dart';
+
+/// Single position pipeline fed with fixes from a platform location provider.
+///
+/// Each fix accepted by [push] is sent once to an external [DataSource] used by the [PositionService]
+/// and is also delivered to the app through [positions]. This way the SDK and the app share the same
+/// location provider instead of each running their own.
+///
+/// Fixes closer in time than [minInterval] or closer in space than [minDistance] to the last fix sent to the SDK
+/// are dropped before they cross the native bridge.
+/// Fixes less accurate than [maxAccuracyH] are still sent to the SDK, which weighs them by their accuracy,
+/// but are not delivered through [positions], so the SDK keeps positioning when the GPS is poor.
+///
+/// {@category Sensor Data Source}
+class ExternalPositionFeed {
+  ExternalPositionFeed._(
+    this._dataSource, {
+    required this.maxAccuracyH,
+    required this.minInterval,
+    required this.minDistance,
+  });
+
+  /// Create an external data source, set it as the [PositionService] data source and start it.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *maxAccuracyH* Fixes with a horizontal accuracy worse than this value, in meters, are not delivered through [positions]. Fixes without accuracy are always delivered.
+  /// * **IN** *minInterval* Minimum time between two fixes sent to the SDK.
+  /// * **IN** *minDistance* Minimum distance in meters between two fixes sent to the SDK.
+  ///
+  /// **Returns**
+  ///
+  /// * The feed on success, null if the data source could not be created or set.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  static ExternalPositionFeed? start({
+    final double maxAccuracyH = 10.0,
+    final Duration minInterval = const Duration(milliseconds: 900),
+    final double minDistance = 0.0,
+  }) {
+    final DataSource? dataSource =
+        DataSource.createExternalDataSource(<DataType>[DataType.position]);
+    if (dataSource == null) {
+      return null;
+    }
+
+    final GemError error =
+        PositionService.instance.setExternalDataSource(dataSource);
+    if (error != GemError.success && error != GemError.exist) {
+      return null;
+    }
+    dataSource.start();
+
+    return ExternalPositionFeed._(
+      dataSource,
+      maxAccuracyH: maxAccuracyH,
+      minInterval: minInterval,
+      minDistance: minDistance,
+    );
+  }
+
+  final DataSource _dataSource;
+  final StreamController<GemPosition> _controller =
+      StreamController<GemPosition>.broadcast();
+
+  GemPosition? _lastPushed;
+  GemPosition? _lastAccepted;
+  bool _isStopped = false;
+  int _acceptedCount = 0;
+  int _inaccurateCount = 0;
+  int _droppedCount = 0;
+
+  /// Fixes with a horizontal accuracy worse than this value, in meters, are not delivered through [positions].
+  final double maxAccuracyH;
+
+  /// Minimum time between two fixes sent to the SDK.
+  final Duration minInterval;
+
+  /// Minimum distance in meters between two fixes sent to the SDK.
+  final double minDistance;
+
+  /// The external data source the fixes are pushed to.
+  DataSource get dataSource => _dataSource;
+
+  /// Stream of the accepted fixes, in the order they were pushed to the SDK. Inaccurate fixes are not delivered.
+  Stream<GemPosition> get positions => _controller.stream;
+
+  /// The last accepted fix, if any.
+  GemPosition? get lastPosition => _lastAccepted;
+
+  /// Number of fixes pushed to the SDK and delivered through [positions].
+  int get acceptedCount => _acceptedCount;
+
+  /// Number of fixes pushed to the SDK but not delivered through [positions] because of their accuracy.
+  int get inaccurateCount => _inaccurateCount;
+
+  /// Number of fixes dropped by the time or distance filters, not pushed to the SDK.
+  int get droppedCount => _droppedCount;
+
+  /// Push a fix from the platform location provider.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *timestamp* Acquisition time of the fix.
+  /// * **IN** *latitude* Latitude in degrees.
+  /// * **IN** *longitude* Longitude in degrees.
+  /// * **IN** *altitude* Altitude in meters.
+  /// * **IN** *speed* Speed in m/s. Negative if not available.
+  /// * **IN** *course* Course in degrees. Negative if not available.
+  /// * **IN** *accuracyH* Horizontal accuracy in meters. Negative if not available.
+  /// * **IN** *accuracyV* Vertical accuracy in meters. Negative if not available.
+  /// * **IN** *speedAccuracy* Speed accuracy in m/s. Negative if not available.
+  /// * **IN** *courseAccuracy* Course accuracy in degrees. Negative if not available.
+  ///
+  /// **Returns**
+  ///
+  /// * True if the fix was pushed to the SDK and delivered through [positions], false if it was dropped or is inaccurate.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  bool push({
+    required final DateTime timestamp,
+    required final double latitude,
+    required final double longitude,
+    final double altitude = 0.0,
+    final double speed = -1.0,
+    final double course = -1.0,
+    final double accuracyH = -1.0,
+    final double accuracyV = -1.0,
+    final double speedAccuracy = -1.0,
+    final double courseAccuracy = -1.0,
+  }) {
+    if (_isStopped) {
+      return false;
+    }
+
+    final GemPosition? last = _lastPushed;
+    final bool isTooSoon = last != null &&
+        timestamp.difference(last.acquisitionTime) < minInterval;
+    final bool isTooClose = last != null &&
+        minDistance > 0 &&
+        Coordinates(latitude: latitude, longitude: longitude).distance(
+              Coordinates(latitude: last.latitude, longitude: last.longitude),
+              ignoreAltitude: true,
+            ) <
+            minDistance;
+    if (isTooSoon || isTooClose) {
+      _droppedCount++;
+      return false;
+    }
+
+    final GemPosition position = SenseDataFactory.producePosition(
+      acquisitionTime: timestamp,
+      satelliteTime: timestamp,
+      provider: Provider.gps,
+      latitude: latitude,
+      longitude: longitude,
+      altitude: altitude,
+      speed: speed,
+      speedAccuracy: speedAccuracy,
+      course: course,
+      courseAccuracy: courseAccuracy,
+      accuracyH: accuracyH,
+      accuracyV: accuracyV,
+      hasSpeed: speed >= 0,
+      hasSpeedAccuracy: speedAccuracy >= 0,
+      hasCourse: course >= 0,
+      hasCourseAccuracy: courseAccuracy >= 0,
+      hasHorizontalAccuracy: accuracyH >= 0,
+      hasVerticalAccuracy: accuracyV >= 0,
+    );
+
+    _dataSource.pushData(position);
+    _lastPushed = position;
+    if (accuracyH > maxAccuracyH) {
+      _inaccurateCount++;
+      return false;
+    }
+
+    _lastAccepted = position;
+    _acceptedCount++;
+    _controller.add(position);
+    return true;
+  }
+
+  /// Stop the data source, remove it from the [PositionService] and close [positions].
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *restoreLiveDataSource* If true, the live data source is set back on the [PositionService] so positioning keeps working.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  void stop({final bool restoreLiveDataSource = true}) {
+    if (_isStopped) {
+      return;
+    }
+    _isStopped = true;
+    _dataSource.stop();
+    PositionService.instance.removeDataSource();
+    if (restoreLiveDataSource) {
+      PositionService.instance.setLiveDataSource();
+    }
+    _controller.close();
+  }
+}
@@ -92,6 +92,89 @@ abstract class RoutingService {
     return TaskHandlerImpl(progListener.id);
   }
 
+  /// Recalculate a previously calculated route starting from the given position.
+  ///
+  /// This is a new calculation: the search state of [previousRoute] is not reused.
+  /// The part of [previousRoute] between a rejoin point located [rejoinDistance] meters ahead and the next intermediate waypoint is passed to the routing engine as a track, so the new route follows it after the detour from [currentPosition].
+  /// The intermediate waypoints not reached yet are kept as waypoints, the ones already passed are dropped.
+  /// The preferences of [previousRoute] are reused unless [routePreferences] is provided.
+  ///
+  /// If the rejoin point would fall past the next waypoint the route is recalculated as a full search towards the remaining waypoints.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *previousRoute* The route to be recalculated
+  /// * **IN** *currentPosition* The position from which the new route starts
+  /// * **IN** *onCompleteCallback* Will be invoked when the calculation is completed, see [calculateRoute] for the possible error codes.
+  /// * **IN** *rejoinDistance* Distance in meters, measured along [previousRoute] from the projection of [currentPosition], at which the new route rejoins the previous one
+  /// * **IN** *routePreferences* The preferences for the route calculation. If null, the preferences of [previousRoute] are used.
+  ///
+  /// **Returns**
+  ///
+  /// * The [TaskHandler] associated with the route calculation if it can be started otherwise null.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  static TaskHandler? recalculateRoute(
+    final Route previousRoute,
+    final Coordinates currentPosition,
+    final void Function(GemError err, List<Route> routes) onCompleteCallback, {
+    final int rejoinDistance = 1500,
+    final RoutePreferences? routePreferences,
+  }) {
+    final RoutePreferences preferences =
+        routePreferences ?? previousRoute.preferences;
+    final Landmark departure = Landmark.withCoordinates(currentPosition);
+
+    final int projectedDistance =
+        previousRoute.getDistanceOnRoute(currentPosition, false);
+    final int rejoinAt = projectedDistance + rejoinDistance;
+
+    // Waypoints not reached yet, with their distance on the previous route
+    final List<Landmark> remaining = <Landmark>[];
+    final List<int> remainingDistances = <int>[];
+    for (final Landmark waypoint in previousRoute.getWaypoints().skip(1)) {
+      final int distance =
+          previousRoute.getDistanceOnRoute(waypoint.coordinates, false);
+      if (projectedDistance < 0 || distance > projectedDistance) {
+        remaining.add(waypoint);
+        remainingDistances.add(distance);
+      }
+    }
+    if (remaining.isEmpty) {
+      onCompleteCallback(GemError.invalidInput, <Route>[]);
+      return null;
+    }
+
+    if (projectedDistance < 0 || rejoinAt >= remainingDistances.first) {
+      return calculateRoute(
+        <Landmark>[departure, ...remaining],
+        preferences,
+        onCompleteCallback,
+      );
+    }
+
+    final Path? track =
+        previousRoute.getPath(rejoinAt, remainingDistances.first);
+    if (track == null) {
+      onCompleteCallback(GemError.invalidInput, <Route>[]);
+      return null;
+    }
+
+    final List<Landmark> trackLandmarks;
+    try {
+      trackLandmarks = track.toLandmarkList();
+    } finally {
+      track.dispose();
+    }
+    return calculateRoute(
+      <Landmark>[departure, ...trackLandmarks, ...remaining],
+      preferences,
+      onCompleteCallback,
+    );
+  }
+
   /// Cancel the route calculation associated with the specified listener.
   ///
   /// **Parameters**
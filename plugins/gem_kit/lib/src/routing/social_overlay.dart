@@ -8,7 +8,6 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
 import 'dart:typed_data';
 
 import 'package:gem_kit/core.dart';
@@ -627,14 +626,7 @@ class SocialReportsOverlayInfo extends OverlayInfo {
   }
 
   @override
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'SocialReportsOverlayInfo',
-        'id': pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('SocialReportsOverlayInfo', pointerId);
 }
 
 /// Report category parameter keys
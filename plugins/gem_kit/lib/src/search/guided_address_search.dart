@@ -8,8 +8,6 @@
 // without an express license agreement from Magic Lane Intellectual Property B.V.
 // or its affiliates is strictly prohibited.
 
-import 'dart:convert';
-
 import 'package:gem_kit/core.dart';
 import 'package:gem_kit/src/core/event_driven_progress_listener.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
@@ -150,7 +148,10 @@ class GuidedAddressSearchPreferences extends GemAutoreleaseObject {
 
   @internal
   GuidedAddressSearchPreferences.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(id);
+    super.registerAutoReleaseObject(
+      id,
+      className: 'GuidedAddressSearchPreferences',
+    );
   }
   final int _pointerId;
 
@@ -325,12 +326,7 @@ class GuidedAddressSearchPreferences extends GemAutoreleaseObject {
     objectMethod(_pointerId, 'GuidedAddressSearchPreferences', 'reset');
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'GuidedAddressSearchPreferences',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('GuidedAddressSearchPreferences', _pointerId);
 }
 
 /// Class representing a guided address search service session.
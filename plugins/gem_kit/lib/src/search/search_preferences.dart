@@ -46,7 +46,7 @@ class SearchPreferences extends GemAutoreleaseObject {
 
   @internal
   SearchPreferences.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'SearchPreferences');
   }
   final int _pointerId;
 
@@ -455,10 +455,5 @@ class SearchPreferences extends GemAutoreleaseObject {
     return SearchPreferences.init(decodedVal['result']);
   }
 
-  void dispose() => GemKitPlatform.instance.callDeleteObject(
-        jsonEncode(<String, Object>{
-          'class': 'SearchPreferences',
-          'id': _pointerId,
-        }),
-      );
+  void dispose() => disposeNative('SearchPreferences', _pointerId);
 }
@@ -0,0 +1,497 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:math';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/src/search/search_preferences.dart';
+import 'package:gem_kit/src/search/search_service.dart';
+
+/// Provider of results coming from outside the SDK, such as a backend search endpoint.
+///
+/// **Parameters**
+///
+/// * **IN** *query* The text typed by the user.
+/// * **IN** *referenceCoordinates* The reference position given to [TypeAheadSearch.update].
+typedef TypeAheadRemoteProvider = Future<List<Landmark>> Function(
+  String query,
+  Coordinates referenceCoordinates,
+);
+
+/// Results delivered by [TypeAheadSearch] for one query.
+///
+/// {@category Places}
+class TypeAheadResults {
+  /// Create a results object.
+  TypeAheadResults({
+    required this.query,
+    required this.landmarks,
+    required this.error,
+    required this.latency,
+    this.isFromCache = false,
+    this.isFinal = true,
+  });
+
+  /// The query the results belong to.
+  final String query;
+
+  /// The results. Onboard results come first, followed by the remote results not already present.
+  final List<Landmark> landmarks;
+
+  /// The error reported by the onboard search. [GemError.success] if the results come from the cache.
+  final GemError error;
+
+  /// Time between the [TypeAheadSearch.update] call for [query] and the delivery of these results.
+  final Duration latency;
+
+  /// True if the onboard results were served from the cache without running a new onboard search.
+  final bool isFromCache;
+
+  /// False if more results are expected for [query] (the remote provider did not answer yet).
+  final bool isFinal;
+}
+
+/// Type-ahead search controller.
+///
+/// Feed it every change of the search text with [update] and listen to [results].
+///
+/// * Input is debounced so that only the last text typed within [debounce] is searched.
+/// * The onboard search of a superseded query is canceled with [SearchService.cancelSearch] and its late results are dropped.
+/// * Results of previous queries are kept in a least recently used cache. A query refining a cached query whose result list was not truncated is answered from the cache.
+///   Like the onboard search, a refined result must have every word of the query as the start of one of its name words.
+/// * Onboard results, searched or cached, are merged with the results of an optional [remoteProvider], which is called after [debounce].
+///
+/// {@category Places}
+class TypeAheadSearch {
+  /// Create a type-ahead search controller.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *debounce* Time to wait after the last [update] before searching.
+  /// * **IN** *cacheSize* Maximum number of queries kept in the cache.
+  /// * **IN** *minQueryLength* Queries shorter than this produce an empty result without searching.
+  /// * **IN** *preferences* The preferences of the onboard search. Optional.
+  /// * **IN** *remoteProvider* Provider of additional results. Optional.
+  /// * **IN** *cacheRadius* The cache is cleared when the reference position moves further than this distance, in meters.
+  TypeAheadSearch({
+    this.debounce = const Duration(milliseconds: 250),
+    this.cacheSize = 32,
+    this.minQueryLength = 1,
+    this.preferences,
+    this.remoteProvider,
+    this.cacheRadius = 2000,
+  });
+
+  /// Time to wait after the last [update] before searching.
+  final Duration debounce;
+
+  /// Maximum number of queries kept in the cache.
+  final int cacheSize;
+
+  /// Queries shorter than this produce an empty result without searching.
+  final int minQueryLength;
+
+  /// The preferences of the onboard search.
+  final SearchPreferences? preferences;
+
+  /// Provider of additional results merged with the onboard results.
+  final TypeAheadRemoteProvider? remoteProvider;
+
+  /// The cache is cleared when the reference position moves further than this distance, in meters.
+  final double cacheRadius;
+
+  final StreamController<TypeAheadResults> _controller =
+      StreamController<TypeAheadResults>.broadcast();
+  final LinkedHashMap<String, _TypeAheadCacheEntry> _cache =
+      LinkedHashMap<String, _TypeAheadCacheEntry>();
+  final List<int> _latencySamples = <int>[];
+  int _latencyNext = 0;
+
+  Timer? _debounceTimer;
+  TaskHandler? _runningTask;
+  Coordinates? _cacheReference;
+  int _generation = 0;
+  bool _isDisposed = false;
+
+  static const int _maxLatencySamples = 256;
+
+  /// Stream of results, in the order of the queries given to [update].
+  Stream<TypeAheadResults> get results => _controller.stream;
+
+  /// Median time between a keystroke and the first results for it. Null if no results were delivered yet.
+  Duration? get latencyP50 => _latencyPercentile(0.5);
+
+  /// 95th percentile of the time between a keystroke and the first results for it. Null if no results were delivered yet.
+  Duration? get latencyP95 => _latencyPercentile(0.95);
+
+  /// Number of latency samples used for [latencyP50] and [latencyP95].
+  int get latencySampleCount => _latencySamples.length;
+
+  /// Update the search text.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *query* The current search text.
+  /// * **IN** *referenceCoordinates* The reference position. Results will be relevant to this position.
+  void update(final String query, final Coordinates referenceCoordinates) {
+    if (_isDisposed) {
+      return;
+    }
+
+    final int generation = _supersede();
+    final Stopwatch keystroke = Stopwatch()..start();
+    final String key = _normalize(query);
+
+    if (key.length < minQueryLength) {
+      _emit(
+        generation,
+        keystroke,
+        TypeAheadResults(
+          query: query,
+          landmarks: <Landmark>[],
+          error: GemError.success,
+          latency: Duration.zero,
+          isFromCache: true,
+        ),
+      );
+      return;
+    }
+
+    _validateCache(referenceCoordinates);
+
+    final List<Landmark>? cached = _lookupCache(key);
+    if (cached != null) {
+      _emit(
+        generation,
+        keystroke,
+        TypeAheadResults(
+          query: query,
+          landmarks: cached,
+          error: GemError.success,
+          latency: keystroke.elapsed,
+          isFromCache: true,
+          isFinal: remoteProvider == null,
+        ),
+      );
+      if (remoteProvider != null) {
+        _debounceTimer = Timer(debounce, () {
+          _debounceTimer = null;
+          _mergeRemote(
+            generation,
+            keystroke,
+            query,
+            cached,
+            GemError.success,
+            remoteProvider!(query, referenceCoordinates),
+            isFromCache: true,
+          );
+        });
+      }
+      return;
+    }
+
+    _debounceTimer = Timer(debounce, () {
+      _debounceTimer = null;
+      _search(generation, keystroke, query, key, referenceCoordinates);
+    });
+  }
+
+  /// Cancel the pending and running searches. No results are delivered for the previous queries.
+  void cancel() => _supersede();
+
+  /// Remove all the cached queries.
+  void clearCache() {
+    _cache.clear();
+    _cacheReference = null;
+  }
+
+  /// Cancel the pending searches and close [results].
+  void dispose() {
+    if (_isDisposed) {
+      return;
+    }
+    _supersede();
+    _isDisposed = true;
+    _cache.clear();
+    _controller.close();
+  }
+
+  int _supersede() {
+    _debounceTimer?.cancel();
+    _debounceTimer = null;
+
+    final TaskHandler? task = _runningTask;
+    _runningTask = null;
+    if (task != null) {
+      SearchService.cancelSearch(task);
+    }
+
+    return ++_generation;
+  }
+
+  void _search(
+    final int generation,
+    final Stopwatch keystroke,
+    final String query,
+    final String key,
+    final Coordinates referenceCoordinates,
+  ) {
+    final Future<List<Landmark>>? remote =
+        remoteProvider?.call(query, referenceCoordinates);
+
+    final TaskHandler? task = SearchService.search(
+      query,
+      referenceCoordinates,
+      (final GemError err, final List<Landmark> onboard) {
+        if (generation != _generation || err == GemError.cancel) {
+          return;
+        }
+        _runningTask = null;
+
+        if (err == GemError.success || err == GemError.reducedResult) {
+          _store(
+            key,
+            onboard,
+            isComplete: err == GemError.success &&
+                onboard.length < (preferences?.maxMatches ?? 40),
+          );
+        }
+
+        _emit(
+          generation,
+          keystroke,
+          TypeAheadResults(
+            query: query,
+            landmarks: onboard,
+            error: err,
+            latency: keystroke.elapsed,
+            isFinal: remote == null,
+          ),
+        );
+
+        if (remote != null) {
+          _mergeRemote(generation, keystroke, query, onboard, err, remote);
+        }
+      },
+      preferences: preferences,
+    );
+
+    // The callback may already have run if the search could not be started
+    if (generation == _generation && task != null) {
+      _runningTask = task;
+    }
+  }
+
+  void _mergeRemote(
+    final int generation,
+    final Stopwatch keystroke,
+    final String query,
+    final List<Landmark> onboard,
+    final GemError error,
+    final Future<List<Landmark>> remote, {
+    final bool isFromCache = false,
+  }) {
+    remote.then((final List<Landmark> remoteResults) {
+      _emit(
+        generation,
+        keystroke,
+        TypeAheadResults(
+          query: query,
+          landmarks: _merge(onboard, remoteResults),
+          error: error,
+          latency: keystroke.elapsed,
+          isFromCache: isFromCache,
+        ),
+      );
+    }).catchError((final Object _) {
+      _emit(
+        generation,
+        keystroke,
+        TypeAheadResults(
+          query: query,
+          landmarks: onboard,
+          error: error,
+          latency: keystroke.elapsed,
+          isFromCache: isFromCache,
+        ),
+      );
+    });
+  }
+
+  void _emit(
+    final int generation,
+    final Stopwatch keystroke,
+    final TypeAheadResults results,
+  ) {
+    if (generation != _generation || _isDisposed) {
+      return;
+    }
+
+    // Only the first delivery for a keystroke counts towards the latency
+    if (keystroke.isRunning) {
+      keystroke.stop();
+      _addLatencySample(keystroke.elapsedMicroseconds);
+    }
+
+    _controller.add(results);
+  }
+
+  void _validateCache(final Coordinates referenceCoordinates) {
+    final Coordinates? reference = _cacheReference;
+    if (reference == null ||
+        reference.distance(referenceCoordinates, ignoreAltitude: true) >
+            cacheRadius) {
+      _cache.clear();
+      _cacheReference = referenceCoordinates;
+    }
+  }
+
+  List<Landmark>? _lookupCache(final String key) {
+    final _TypeAheadCacheEntry? exact = _cache.remove(key);
+    if (exact != null) {
+      _cache[key] = exact;
+      return exact.landmarks;
+    }
+
+    // Refine the longest cached prefix holding all its matches
+    for (int end = key.length - 1; end >= minQueryLength; end--) {
+      final String prefix = key.substring(0, end);
+      final _TypeAheadCacheEntry? entry = _cache.remove(prefix);
+      if (entry == null) {
+        continue;
+      }
+      _cache[prefix] = entry;
+      if (!entry.isComplete) {
+        return null;
+      }
+
+      final List<String> words = key.split(' ');
+      final List<Landmark> refined = <Landmark>[];
+      final List<String> refinedNames = <String>[];
+      for (int i = 0; i < entry.landmarks.length; i++) {
+        final String name = entry.names[i];
+        if (_matchesWords(name, words)) {
+          refined.add(entry.landmarks[i]);
+          refinedNames.add(name);
+        }
+      }
+      _put(key, _TypeAheadCacheEntry(refined, refinedNames, true));
+      return refined;
+    }
+
+    return null;
+  }
+
+  void _store(
+    final String key,
+    final List<Landmark> landmarks, {
+    required final bool isComplete,
+  }) {
+    _put(
+      key,
+      _TypeAheadCacheEntry(
+        landmarks,
+        landmarks
+            .map((final Landmark landmark) => _normalize(landmark.name))
+            .toList(),
+        isComplete,
+      ),
+    );
+  }
+
+  void _put(final String key, final _TypeAheadCacheEntry entry) {
+    _cache.remove(key);
+    _cache[key] = entry;
+    while (_cache.length > cacheSize) {
+      _cache.remove(_cache.keys.first);
+    }
+  }
+
+  void _addLatencySample(final int micros) {
+    if (_latencySamples.length < _maxLatencySamples) {
+      _latencySamples.add(micros);
+    } else {
+      _latencySamples[_latencyNext] = micros;
+      _latencyNext = (_latencyNext + 1) % _maxLatencySamples;
+    }
+  }
+
+  Duration? _latencyPercentile(final double percentile) {
+    if (_latencySamples.isEmpty) {
+      return null;
+    }
+
+    final List<int> sorted = List<int>.of(_latencySamples)..sort();
+    final int index = min(
+      sorted.length - 1,
+      (percentile * sorted.length).ceil() - 1,
+    );
+    return Duration(microseconds: sorted[max(0, index)]);
+  }
+
+  static List<Landmark> _merge(
+    final List<Landmark> onboard,
+    final List<Landmark> remote,
+  ) {
+    if (remote.isEmpty) {
+      return onboard;
+    }
+
+    final List<Landmark> merged = List<Landmark>.of(onboard);
+    final List<Coordinates> onboardCoords = onboard
+        .map((final Landmark landmark) => landmark.coordinates)
+        .toList();
+    final List<String> onboardNames =
+        onboard.map((final Landmark landmark) => landmark.name).toList();
+
+    for (final Landmark candidate in remote) {
+      final Coordinates coords = candidate.coordinates;
+      final String name = candidate.name;
+      bool isDuplicate = false;
+      for (int i = 0; i < onboardCoords.length && !isDuplicate; i++) {
+        isDuplicate = onboardNames[i] == name &&
+            onboardCoords[i].distance(coords, ignoreAltitude: true) <
+                _duplicateDistance;
+      }
+      if (!isDuplicate) {
+        merged.add(candidate);
+      }
+    }
+
+    return merged;
+  }
+
+  // Each query word must start one of the name words, as in the onboard search
+  static bool _matchesWords(final String name, final List<String> words) {
+    final List<String> nameWords = name.split(_wordSeparator);
+    return words.every(
+      (final String word) =>
+          nameWords.any((final String nameWord) => nameWord.startsWith(word)),
+    );
+  }
+
+  static final RegExp _wordSeparator = RegExp(r'[\s\-,.;:/()]+');
+
+  static String _normalize(final String text) =>
+      text.trim().toLowerCase().replaceAll(RegExp(r'\s+'), ' ');
+
+  // Remote results closer than this to an onboard result with the same name are dropped
+  static const double _duplicateDistance = 50;
+}
+
+class _TypeAheadCacheEntry {
+  _TypeAheadCacheEntry(this.landmarks, this.names, this.isComplete);
+
+  final List<Landmark> landmarks;
+  final List<String> names;
+  final bool isComplete;
+}
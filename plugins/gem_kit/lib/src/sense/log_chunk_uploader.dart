@@ -0,0 +1,638 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:crypto/crypto.dart';
+import 'package:gem_kit/src/core/gem_error.dart';
+
+/// A chunk of a log, compressed and ready to be uploaded by a [LogChunkUploader]
+///
+/// {@category Sensor Data Source}
+class LogChunk {
+  LogChunk._(this.id, this.offset, this.length, this.data);
+
+  /// SHA-256 of the uncompressed chunk, as 64 hexadecimal digits. Equal chunks have equal ids.
+  final String id;
+
+  /// Offset of the chunk in the log file.
+  final int offset;
+
+  /// Uncompressed size of the chunk in bytes.
+  final int length;
+
+  /// The gzip compressed chunk.
+  final Uint8List data;
+}
+
+/// Server side of a [LogChunkUploader]. Implemented on top of the upload server, or of a local stand-in.
+///
+/// {@category Sensor Data Source}
+abstract class LogChunkTransport {
+  /// Get the chunks the server does not have yet.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logName* The name of the log.
+  /// * **IN** *chunkIds* The ids of some chunks of the log.
+  ///
+  /// **Returns**
+  ///
+  /// * The ids of the chunks to upload. The other chunks are already stored on the server, for this log or another one.
+  Future<Set<String>> missingChunks(
+    final String logName,
+    final List<String> chunkIds,
+  );
+
+  /// Upload a chunk.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logName* The name of the log.
+  /// * **IN** *chunk* The chunk.
+  Future<void> uploadChunk(final String logName, final LogChunk chunk);
+
+  /// Complete the upload of a log, once all of its chunks are on the server.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logName* The name of the log.
+  /// * **IN** *chunkIds* The ids of all the chunks of the log, in file order.
+  /// * **IN** *size* The size of the log in bytes.
+  Future<void> commit(
+    final String logName,
+    final List<String> chunkIds,
+    final int size,
+  );
+
+  /// Abort the chunk uploads in progress for a log. Called when the upload of the log is cancelled.
+  ///
+  /// The aborted [uploadChunk] calls should fail with an [IOException]. By default the uploads in progress are left to complete.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logName* The name of the log.
+  void abortUploads(final String logName) {}
+}
+
+/// [LogChunkTransport] on top of an HTTP upload server.
+///
+/// The server implements three endpoints below [baseUri]:
+/// * `POST logs/<logName>/missing` with a JSON body `{"chunks": [<chunk id>, ...]}` replies `{"missing": [<chunk id>, ...]}`
+/// * `PUT chunks/<chunk id>` with the gzip compressed chunk as body stores the chunk
+/// * `POST logs/<logName>/commit` with a JSON body `{"chunks": [<chunk id>, ...], "size": <size>}` completes the log
+///
+/// A reply with a status other than 2xx fails with an [HttpException].
+///
+/// {@category Sensor Data Source}
+class HttpLogChunkTransport extends LogChunkTransport {
+  /// Create a transport.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *baseUri* The base URI of the upload server.
+  /// * **IN** *headers* Headers added to each request, for example for authorization.
+  /// * **IN** *timeout* The maximum duration of a request. A request taking longer fails with a [TimeoutException].
+  /// * **IN** *client* The HTTP client. By default a new client, closed by [close].
+  HttpLogChunkTransport(
+    this.baseUri, {
+    this.headers = const <String, String>{},
+    this.timeout = const Duration(seconds: 30),
+    final HttpClient? client,
+  }) : _client = client ?? HttpClient() {
+    _client.connectionTimeout = timeout;
+  }
+
+  /// The base URI of the upload server.
+  final Uri baseUri;
+
+  /// Headers added to each request.
+  final Map<String, String> headers;
+
+  /// The maximum duration of a request.
+  final Duration timeout;
+
+  final HttpClient _client;
+
+  // Chunk uploads in progress, by log name
+  final Map<String, Set<HttpClientRequest>> _uploads =
+      <String, Set<HttpClientRequest>>{};
+
+  @override
+  Future<Set<String>> missingChunks(
+    final String logName,
+    final List<String> chunkIds,
+  ) async {
+    final Uint8List reply = await _send(
+      'POST',
+      <String>['logs', logName, 'missing'],
+      utf8.encode(jsonEncode(<String, Object>{'chunks': chunkIds})),
+      ContentType.json,
+    );
+    final dynamic missing = jsonDecode(utf8.decode(reply))['missing'];
+    return <String>{
+      for (final dynamic id in missing as List<dynamic>) id as String,
+    };
+  }
+
+  @override
+  Future<void> uploadChunk(final String logName, final LogChunk chunk) =>
+      _send(
+        'PUT',
+        <String>['chunks', chunk.id],
+        chunk.data,
+        ContentType('application', 'gzip'),
+        logName: logName,
+      );
+
+  @override
+  Future<void> commit(
+    final String logName,
+    final List<String> chunkIds,
+    final int size,
+  ) =>
+      _send(
+        'POST',
+        <String>['logs', logName, 'commit'],
+        utf8.encode(
+          jsonEncode(<String, Object>{'chunks': chunkIds, 'size': size}),
+        ),
+        ContentType.json,
+      );
+
+  @override
+  void abortUploads(final String logName) {
+    final Set<HttpClientRequest>? uploads = _uploads.remove(logName);
+    if (uploads == null) {
+      return;
+    }
+    for (final HttpClientRequest request in uploads) {
+      request.abort();
+    }
+  }
+
+  /// Close the HTTP client. The requests in progress are aborted.
+  void close() => _client.close(force: true);
+
+  Future<Uint8List> _send(
+    final String method,
+    final List<String> path,
+    final List<int> body,
+    final ContentType contentType, {
+    final String? logName,
+  }) async {
+    final Uri uri = baseUri.replace(
+      pathSegments: <String>[
+        ...baseUri.pathSegments.where((final String s) => s.isNotEmpty),
+        ...path,
+      ],
+    );
+    final HttpClientRequest request =
+        await _client.openUrl(method, uri).timeout(timeout);
+    final Timer timer = Timer(
+      timeout,
+      () => request.abort(TimeoutException('$method $uri', timeout)),
+    );
+    final Set<HttpClientRequest>? uploads = logName == null
+        ? null
+        : _uploads.putIfAbsent(logName, () => <HttpClientRequest>{});
+    uploads?.add(request);
+    try {
+      headers.forEach(request.headers.set);
+      request.headers.contentType = contentType;
+      request.contentLength = body.length;
+      request.add(body);
+      final HttpClientResponse response = await request.close();
+      final BytesBuilder reply = BytesBuilder(copy: false);
+      await response.forEach(reply.add);
+      if (response.statusCode < 200 || response.statusCode >= 300) {
+        throw HttpException(
+          '$method failed with status ${response.statusCode}',
+          uri: uri,
+        );
+      }
+      return reply.takeBytes();
+    } finally {
+      timer.cancel();
+      uploads?.remove(request);
+      if (uploads != null && uploads.isEmpty) {
+        _uploads.remove(logName);
+      }
+    }
+  }
+}
+
+/// Progress of a [LogChunkUploader] upload
+///
+/// {@category Sensor Data Source}
+class LogChunkUploadProgress {
+  LogChunkUploadProgress._(this.logPath, this.totalBytes);
+
+  /// The path of the log.
+  final String logPath;
+
+  /// The size of the log in bytes.
+  final int totalBytes;
+
+  /// Number of bytes of the log chunked and compressed.
+  int processedBytes = 0;
+
+  /// Number of bytes of the log whose chunks are on the server.
+  int uploadedBytes = 0;
+
+  /// Number of compressed bytes sent to the server.
+  int sentBytes = 0;
+
+  /// Number of chunks found so far.
+  int chunkCount = 0;
+
+  /// Number of chunks sent to the server.
+  int sentChunkCount = 0;
+
+  /// Number of chunks not sent because the server already had them.
+  int deduplicatedChunkCount = 0;
+
+  final Stopwatch _stopwatch = Stopwatch();
+
+  /// Time elapsed since the upload started.
+  Duration get elapsed => _stopwatch.elapsed;
+
+  /// Progress between 0 and 100.
+  int get progress =>
+      totalBytes == 0 ? 100 : uploadedBytes * 100 ~/ totalBytes;
+
+  /// Log bytes uploaded per second, counting the deduplicated chunks.
+  double get bytesPerSecond => _stopwatch.elapsedMilliseconds == 0
+      ? 0
+      : uploadedBytes * 1000 / _stopwatch.elapsedMilliseconds;
+
+  /// Compressed bytes sent per second.
+  double get sentBytesPerSecond => _stopwatch.elapsedMilliseconds == 0
+      ? 0
+      : sentBytes * 1000 / _stopwatch.elapsedMilliseconds;
+}
+
+/// Uploads logs as compressed, content-defined chunks.
+///
+/// The log is split in chunks whose boundaries depend on the content, so unchanged parts of a log keep the same chunks when data is added or modified elsewhere.
+/// Chunks already stored on the server are not sent again, which also resumes an interrupted upload.
+/// Chunking and compression run in a background isolate, one window of the file at a time, while the previous chunks are uploaded in parallel.
+/// A window is the larger of 8 MiB and two maximal chunks, 8 times [averageChunkSize]. At most one window is read at a time and two compressed windows are held.
+///
+/// This uploader does not use the Magic Lane servers. Use [LogUploader] for bug reports.
+///
+/// {@category Sensor Data Source}
+class LogChunkUploader {
+  /// Create an uploader.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *transport* The server side.
+  /// * **IN** *parallelUploads* The maximum number of chunks uploaded at the same time.
+  /// * **IN** *averageChunkSize* The average chunk size in bytes. Must be a power of two.
+  /// * **IN** *compressionLevel* The gzip compression level, between 1 and 9.
+  /// * **IN** *maxRetries* The number of times a failed chunk upload is retried.
+  LogChunkUploader(
+    this.transport, {
+    this.parallelUploads = 4,
+    this.averageChunkSize = 1 << 20,
+    this.compressionLevel = 6,
+    this.maxRetries = 3,
+  }) : assert(
+          averageChunkSize >= 1024 &&
+              averageChunkSize & (averageChunkSize - 1) == 0,
+          'averageChunkSize must be a power of two of at least 1024',
+        );
+
+  /// The server side.
+  final LogChunkTransport transport;
+
+  /// The maximum number of chunks uploaded at the same time.
+  final int parallelUploads;
+
+  /// The average chunk size in bytes.
+  final int averageChunkSize;
+
+  /// The gzip compression level.
+  final int compressionLevel;
+
+  /// The number of times a failed chunk upload is retried.
+  final int maxRetries;
+
+  final Set<String> _cancelled = <String>{};
+
+  // Name on the server of the logs being uploaded, by path
+  final Map<String, String> _active = <String, String>{};
+
+  /// Upload a log.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logPath* The path of the log.
+  /// * **IN** *logName* The name of the log on the server. By default the file name.
+  /// * **IN** *onProgressUpdated* Called each time a window of the log is chunked and each time a chunk is uploaded.
+  ///
+  /// **Returns**
+  ///
+  /// * [GemError.success] on success.
+  /// * [GemError.notFound] if the log does not exist.
+  /// * [GemError.cancel] if the upload was cancelled with [cancel].
+  /// * [GemError.networkFailed] if the transport failed. Uploading again resumes from the chunks already on the server.
+  /// * [GemError.io] if the log cannot be read.
+  ///
+  /// **Throws**
+  ///
+  /// * The exceptions of the [transport] other than [IOException] and [TimeoutException].
+  Future<GemError> upload(
+    final String logPath, {
+    final String? logName,
+    final void Function(LogChunkUploadProgress progress)? onProgressUpdated,
+  }) async {
+    final File file = File(logPath);
+    if (!await file.exists()) {
+      return GemError.notFound;
+    }
+    final String name = logName ?? file.uri.pathSegments.last;
+    final int size = await file.length();
+    final LogChunkUploadProgress progress = LogChunkUploadProgress._(
+      logPath,
+      size,
+    ).._stopwatch.start();
+
+    _cancelled.remove(logPath);
+    _active[logPath] = name;
+    final List<String> chunkIds = <String>[];
+    final Queue<Future<GemError>> uploads = Queue<Future<GemError>>();
+    GemError error = GemError.success;
+    Future<_Window>? next;
+
+    try {
+      int offset = 0;
+      next = _chunkWindow(logPath, offset, size);
+      while (next != null) {
+        final _Window window = await next;
+        next = null;
+        if (_cancelled.contains(logPath)) {
+          error = GemError.cancel;
+          break;
+        }
+        offset = window.end;
+        // Chunk the next window while the chunks of this one are uploaded
+        next = offset < size ? _chunkWindow(logPath, offset, size) : null;
+
+        progress
+          ..processedBytes = offset
+          ..chunkCount += window.chunks.length;
+        onProgressUpdated?.call(progress);
+
+        // Copied, the transport may keep the set it returns
+        final Set<String> missing = Set<String>.of(
+          await transport.missingChunks(
+            name,
+            window.chunks.map((final LogChunk chunk) => chunk.id).toList(),
+          ),
+        );
+        for (final LogChunk chunk in window.chunks) {
+          if (_cancelled.contains(logPath)) {
+            error = GemError.cancel;
+            break;
+          }
+          chunkIds.add(chunk.id);
+          if (!missing.remove(chunk.id)) {
+            progress
+              ..deduplicatedChunkCount++
+              ..uploadedBytes += chunk.length;
+            continue;
+          }
+
+          while (uploads.length >= parallelUploads) {
+            error = await uploads.removeFirst();
+            if (error != GemError.success) {
+              break;
+            }
+          }
+          if (error != GemError.success) {
+            break;
+          }
+          if (_cancelled.contains(logPath)) {
+            error = GemError.cancel;
+            break;
+          }
+          uploads.add(
+            _uploadChunk(logPath, name, chunk, progress, onProgressUpdated),
+          );
+        }
+        onProgressUpdated?.call(progress);
+        if (error != GemError.success) {
+          break;
+        }
+      }
+
+      while (uploads.isNotEmpty) {
+        final GemError result = await uploads.removeFirst();
+        if (error == GemError.success) {
+          error = result;
+        }
+      }
+      if (error == GemError.success && _cancelled.contains(logPath)) {
+        error = GemError.cancel;
+      }
+      if (error == GemError.success) {
+        await transport.commit(name, chunkIds, size);
+      }
+    } on FileSystemException {
+      error = GemError.io;
+    } on IsolateSpawnException {
+      error = GemError.io;
+    } on IOException {
+      error = GemError.networkFailed;
+    } on TimeoutException {
+      error = GemError.networkFailed;
+    } finally {
+      // The window chunked ahead and the pending uploads are not needed after
+      // an error
+      next?.ignore();
+      for (final Future<GemError> upload in uploads) {
+        upload.ignore();
+      }
+      progress._stopwatch.stop();
+      _cancelled.remove(logPath);
+      _active.remove(logPath);
+    }
+    return error;
+  }
+
+  /// Cancel the upload of a log.
+  ///
+  /// No chunk is sent after the cancel and the chunk uploads in progress are aborted with [LogChunkTransport.abortUploads].
+  /// The chunks already uploaded are kept on the server, so uploading the log again resumes the upload.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logPath* The path of the log.
+  void cancel(final String logPath) {
+    _cancelled.add(logPath);
+    final String? name = _active[logPath];
+    if (name != null) {
+      transport.abortUploads(name);
+    }
+  }
+
+  Future<_Window> _chunkWindow(
+    final String path,
+    final int offset,
+    final int size,
+  ) {
+    final int averageChunkSize = this.averageChunkSize;
+    final int compressionLevel = this.compressionLevel;
+    return Isolate.run(
+      () => _Window.read(
+        path,
+        offset,
+        size,
+        averageChunkSize,
+        compressionLevel,
+      ),
+    );
+  }
+
+  Future<GemError> _uploadChunk(
+    final String path,
+    final String name,
+    final LogChunk chunk,
+    final LogChunkUploadProgress progress,
+    final void Function(LogChunkUploadProgress progress)? onProgressUpdated,
+  ) async {
+    for (int attempt = 0;; attempt++) {
+      if (_cancelled.contains(path)) {
+        return GemError.cancel;
+      }
+      try {
+        await transport.uploadChunk(name, chunk);
+        break;
+      } on Exception catch (e) {
+        if (e is! IOException && e is! TimeoutException) {
+          rethrow;
+        }
+        if (_cancelled.contains(path)) {
+          return GemError.cancel;
+        }
+        if (attempt == maxRetries) {
+          return GemError.networkFailed;
+        }
+        await Future<void>.delayed(Duration(milliseconds: 500 << attempt));
+      }
+    }
+    progress
+      ..sentChunkCount++
+      ..sentBytes += chunk.data.length
+      ..uploadedBytes += chunk.length;
+    onProgressUpdated?.call(progress);
+    return GemError.success;
+  }
+}
+
+/// Chunks found in a window of a log file. Built in a background isolate.
+class _Window {
+  _Window(this.end, this.chunks);
+
+  /// Read a window starting at a chunk boundary, chunk and compress it.
+  ///
+  /// The window ends at the last chunk boundary found, so the next window starts where the chunking would have continued.
+  factory _Window.read(
+    final String path,
+    final int offset,
+    final int size,
+    final int averageChunkSize,
+    final int compressionLevel,
+  ) {
+    final int minSize = averageChunkSize ~/ 4;
+    final int maxSize = averageChunkSize * 4;
+    final int mask = averageChunkSize - 1;
+    final int windowSize = max(2 * maxSize, _minWindowSize);
+    final int windowEnd = min(offset + windowSize, size);
+
+    final RandomAccessFile file = File(path).openSync();
+    final Uint8List data;
+    try {
+      file.setPositionSync(offset);
+      data = file.readSync(windowEnd - offset);
+    } finally {
+      file.closeSync();
+    }
+
+    final GZipCodec codec = GZipCodec(level: compressionLevel);
+    final List<LogChunk> chunks = <LogChunk>[];
+    int start = 0;
+    while (start < data.length) {
+      final int remaining = data.length - start;
+      int end;
+      if (remaining <= minSize) {
+        end = data.length;
+      } else {
+        final int limit = remaining < maxSize ? data.length : start + maxSize;
+        int hash = 0;
+        end = limit;
+        for (int i = start + minSize; i < limit; i++) {
+          hash = ((hash << 1) + _gear[data[i]]) & 0xFFFFFFFF;
+          if (hash & mask == 0) {
+            end = i + 1;
+            break;
+          }
+        }
+      }
+
+      // A chunk cut by the end of the window, not by the content, is read again with the next window
+      if (end == data.length && windowEnd < size && end - start < maxSize) {
+        break;
+      }
+
+      final Uint8List chunk = Uint8List.sublistView(data, start, end);
+      chunks.add(
+        LogChunk._(
+          _chunkId(chunk),
+          offset + start,
+          chunk.length,
+          Uint8List.fromList(codec.encode(chunk)),
+        ),
+      );
+      start = end;
+    }
+    return _Window(offset + start, chunks);
+  }
+
+  final int end;
+  final List<LogChunk> chunks;
+
+  static String _chunkId(final Uint8List chunk) =>
+      sha256.convert(chunk).toString();
+
+  static const int _minWindowSize = 8 << 20;
+
+  static final List<int> _gear = _buildGear();
+
+  static List<int> _buildGear() {
+    // Fixed pseudo random table, so the boundaries are the same on every
+    // device. 32 bit xorshift, exact on all platforms
+    int state = 0x9E3779B9;
+    return List<int>.generate(256, (final int _) {
+      state ^= (state << 13) & 0xFFFFFFFF;
+      state ^= state >>> 17;
+      state ^= (state << 5) & 0xFFFFFFFF;
+      return state;
+    });
+  }
+}
@@ -13,6 +13,7 @@ import 'dart:convert';
 import 'package:gem_kit/core.dart';
 import 'package:gem_kit/src/core/gem_autorelease_object.dart';
 import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+import 'package:gem_kit/src/sense/log_chunk_uploader.dart';
 import 'package:gem_kit/src/sense/logupload_listener.dart';
 
 /// Uploads a .gm or .mp4 recording to the Magic Lane servers.
@@ -29,6 +30,7 @@ class LogUploader extends GemAutoreleaseObject {
   ///   * **IN** *logPath*	The path to the log file to upload
   ///   * **IN** *status*	The status of the log upload
   ///   * **IN** *progress*	The progress of the log upload
+  /// * **IN** *chunkUploader* Uploader used by [uploadChunked] to send the logs to a server of the application.
   ///
   /// If the upload is successful, the error code will be [GemError.success]. It it will be different from [GemError.success] status and progress will be null.
   LogUploader({
@@ -38,7 +40,8 @@ class LogUploader extends GemAutoreleaseObject {
       LogUploaderState? status,
       int? progress,
     ) onLogStatusChangedCallback,
-  }) {
+    this.chunkUploader,
+  }) : _onLogStatusChanged = onLogStatusChangedCallback {
     _logUploadListener = LogUploadListener(
       onLogStatusChangedCallback:
           (final String logPath, final int status, final int progress) {
@@ -76,6 +79,15 @@ class LogUploader extends GemAutoreleaseObject {
   }
   late LogUploadListener _logUploadListener;
   dynamic _pointerId;
+  final void Function(
+    GemError error,
+    String logPath,
+    LogUploaderState? status,
+    int? progress,
+  ) _onLogStatusChanged;
+
+  /// Uploader used by [uploadChunked].
+  final LogChunkUploader? chunkUploader;
 
   /// Start an upload operation
   ///
@@ -121,9 +133,52 @@ class LogUploader extends GemAutoreleaseObject {
     return GemErrorExtension.fromCode(resultString['result']);
   }
 
+  /// Upload a log to a server of the application with the [chunkUploader], instead of the Magic Lane servers.
+  ///
+  /// Events about this operation are notified via the callback method given at [LogUploader] creation, as for [upload].
+  /// Uploading a log again resumes from the chunks already on the server.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logPath*	The path to the log file to upload
+  /// * **IN** *logName*	The name of the log on the server. By default the file name.
+  ///
+  /// **Returns**
+  ///
+  /// * [GemError.success] On success.
+  /// * [GemError.notSupported] If the uploader was created without a [chunkUploader].
+  /// * The other errors of [LogChunkUploader.upload].
+  Future<GemError> uploadChunked({
+    required final String logPath,
+    final String? logName,
+  }) async {
+    final LogChunkUploader? uploader = chunkUploader;
+    if (uploader == null) {
+      return GemError.notSupported;
+    }
+    final GemError error = await uploader.upload(
+      logPath,
+      logName: logName,
+      onProgressUpdated: (final LogChunkUploadProgress progress) =>
+          _onLogStatusChanged(
+        GemError.success,
+        logPath,
+        LogUploaderState.progress,
+        progress.progress,
+      ),
+    );
+    if (error == GemError.success) {
+      _onLogStatusChanged(error, logPath, LogUploaderState.ready, 100);
+    } else {
+      _onLogStatusChanged(error, logPath, null, null);
+    }
+    return error;
+  }
+
   /// Cancel an upload operation
   ///
   /// Events about this operation are notified via the callback method given at [LogUploader] creation.
+  /// The uploads started with [uploadChunked] are also cancelled.
   ///
   /// **Parameters**
   ///
@@ -137,6 +192,7 @@ class LogUploader extends GemAutoreleaseObject {
   ///
   /// * An exception if it fails.
   GemError cancel({required final String logPath}) {
+    chunkUploader?.cancel(logPath);
     final OperationResult resultString = objectMethod(
       _pointerId,
       'LogUploader',
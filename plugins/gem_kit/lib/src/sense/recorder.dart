@@ -232,7 +232,7 @@ class Recorder extends GemAutoreleaseObject {
   Recorder._() : _pointerId = -1;
 
   Recorder.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'Recorder');
   }
   final int _pointerId;
 
@@ -695,11 +695,7 @@ class Recorder extends GemAutoreleaseObject {
     return result;
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{'class': 'Recorder', 'id': _pointerId}),
-    );
-  }
+  void dispose() => disposeNative('Recorder', _pointerId);
 }
 
 /// Recorder bookmarks class
@@ -712,7 +708,7 @@ class RecorderBookmarks extends GemAutoreleaseObject {
   RecorderBookmarks._() : _pointerId = -1;
 
   RecorderBookmarks.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(_pointerId, className: 'RecorderBookmarks');
   }
   final int _pointerId;
   int get pointerId => _pointerId;
@@ -991,14 +987,7 @@ class RecorderBookmarks extends GemAutoreleaseObject {
     return GemErrorExtension.fromCode(jsonDecode(resultString)['result']);
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'RecorderBookmarks',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('RecorderBookmarks', _pointerId);
 }
 
 /// LogMetadata class
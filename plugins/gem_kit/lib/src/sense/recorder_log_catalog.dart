@@ -0,0 +1,493 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/core/coordinates.dart';
+import 'package:gem_kit/src/sense/recorder.dart';
+import 'package:gem_kit/src/sense/recorder_data_types.dart';
+
+/// Ways in which the logs of a [RecorderLogCatalog] can be ordered
+///
+/// {@category Sensor Data Source}
+enum RecorderLogOrder {
+  /// Order by start time
+  date,
+
+  /// Order by duration
+  duration,
+
+  /// Order by file size
+  size,
+
+  /// Order by path
+  path,
+}
+
+/// Summary of a recorder log, as stored in a [RecorderLogCatalog]
+///
+/// {@category Sensor Data Source}
+class RecorderLogEntry {
+  RecorderLogEntry._({
+    required this.path,
+    required this.startTimestampInMillis,
+    required this.endTimestampInMillis,
+    required this.durationMillis,
+    required this.transportMode,
+    required this.logSize,
+    required this.isUploaded,
+    required this.isProtected,
+    required this.startPosition,
+    required this.endPosition,
+    required int modifiedInMillis,
+    required int fileSize,
+  })  : _modifiedInMillis = modifiedInMillis,
+        _fileSize = fileSize;
+
+  /// The path of the log file.
+  final String path;
+
+  /// The start time of the log, in milliseconds since epoch.
+  final int startTimestampInMillis;
+
+  /// The end time of the log, in milliseconds since epoch.
+  final int endTimestampInMillis;
+
+  /// The duration of the log, in milliseconds.
+  final int durationMillis;
+
+  /// The transport mode used when the log was recorded. [RecordingTransportMode.unknown] for video logs.
+  final RecordingTransportMode transportMode;
+
+  /// The size of the log in bytes.
+  final int logSize;
+
+  /// Check if the log was uploaded to the server.
+  final bool isUploaded;
+
+  /// Check if the log is protected.
+  final bool isProtected;
+
+  /// The first recorded position. Invalid for video logs.
+  final Coordinates startPosition;
+
+  /// The last recorded position. Invalid for video logs.
+  final Coordinates endPosition;
+
+  final int _modifiedInMillis;
+  final int _fileSize;
+}
+
+/// Persistent catalog of the recorder logs of a folder.
+///
+/// Listing and filtering logs with [RecorderBookmarks] reads the metadata of each log file.
+/// The catalog keeps a summary of each log in a compact index file in the log folder, so only the logs added or modified since the last [refresh] are read.
+/// Finished logs are not expected to change, except through [RecorderBookmarks.markLogProtected] and [RecorderBookmarks.markLogUploaded], after which [invalidate] must be called.
+///
+/// {@category Sensor Data Source}
+class RecorderLogCatalog {
+  RecorderLogCatalog._(this.bookmarks, this.logsFolder);
+
+  /// Open the catalog of a log folder.
+  ///
+  /// The saved index is loaded, if any. Call [refresh] to take the changes of the folder into account.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *bookmarks* The bookmarks of the log folder.
+  /// * **IN** *logsFolder* The log folder, as given to [RecorderBookmarks.create].
+  ///
+  /// **Returns**
+  ///
+  /// * The catalog.
+  static Future<RecorderLogCatalog> open(
+    final RecorderBookmarks bookmarks,
+    final String logsFolder,
+  ) async {
+    final RecorderLogCatalog catalog =
+        RecorderLogCatalog._(bookmarks, logsFolder);
+    final File file = File(catalog._indexPath);
+    if (await file.exists()) {
+      try {
+        catalog._load(await file.readAsBytes());
+      } on FormatException {
+        catalog._entries.clear();
+        catalog._folderModifiedInMillis = 0;
+      }
+    }
+    return catalog;
+  }
+
+  /// The bookmarks of the log folder.
+  final RecorderBookmarks bookmarks;
+
+  /// The log folder.
+  final String logsFolder;
+
+  final Map<String, RecorderLogEntry> _entries = <String, RecorderLogEntry>{};
+  bool _isModified = false;
+
+  // Modification time of the folder. The log list is read again only if the
+  // folder changed
+  int _folderModifiedInMillis = 0;
+
+  /// Number of logs in the catalog.
+  int get length => _entries.length;
+
+  /// Get the summary of a log.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logPath* The path of the log.
+  ///
+  /// **Returns**
+  ///
+  /// * The summary, or null if the log is not in the catalog.
+  RecorderLogEntry? entryOf(final String logPath) => _entries[logPath];
+
+  /// Update the catalog with the logs of the folder.
+  ///
+  /// The log list is read only if logs were added or removed since the previous refresh. The metadata is read only for the new logs and the logs whose size or modification time changed.
+  /// Deleted logs are removed.
+  ///
+  /// **Returns**
+  ///
+  /// * The number of logs whose metadata was read.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  int refresh() {
+    final int folderModified =
+        Directory(logsFolder).statSync().modified.millisecondsSinceEpoch;
+    final Set<String> protectedLogs = bookmarks.protectedLogsList.toSet();
+
+    // Adding or removing a log changes the folder
+    final List<String> logs;
+    if (folderModified != _folderModifiedInMillis) {
+      logs = bookmarks.getLogsList();
+      final Set<String> present = logs.toSet();
+      final int before = _entries.length;
+      _entries.removeWhere(
+        (final String path, final RecorderLogEntry _) =>
+            !present.contains(path),
+      );
+      _isModified |= before != _entries.length;
+    } else {
+      logs = _entries.keys.toList();
+    }
+
+    // Writing to a log does not change the folder, so each file is checked
+    int readCount = 0;
+    for (final String path in logs) {
+      final RecorderLogEntry? entry = _entries[path];
+      final bool isProtected = protectedLogs.contains(path);
+      final FileStat stat = File(path).statSync();
+      if (stat.type == FileSystemEntityType.notFound) {
+        _isModified |= _entries.remove(path) != null;
+        continue;
+      }
+      if (entry != null &&
+          entry._fileSize == stat.size &&
+          entry._modifiedInMillis == stat.modified.millisecondsSinceEpoch &&
+          entry.isProtected == isProtected) {
+        continue;
+      }
+      _entries[path] = _read(path, stat, isProtected);
+      _isModified = true;
+      readCount++;
+    }
+
+    _isModified |= folderModified != _folderModifiedInMillis;
+    _folderModifiedInMillis = folderModified;
+    return readCount;
+  }
+
+  /// Read again the metadata of a log.
+  ///
+  /// To be called after [RecorderBookmarks.markLogProtected] or [RecorderBookmarks.markLogUploaded], which may not modify the log file.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logPath* The path of the log.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails.
+  void invalidate(final String logPath) {
+    final FileStat stat = File(logPath).statSync();
+    if (stat.type == FileSystemEntityType.notFound) {
+      _isModified |= _entries.remove(logPath) != null;
+      return;
+    }
+    _entries[logPath] = _read(
+      logPath,
+      stat,
+      bookmarks.protectedLogsList.contains(logPath),
+    );
+    _isModified = true;
+  }
+
+  /// Get the logs matching the given filters.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *startedAfter* Only logs started at or after this time.
+  /// * **IN** *startedBefore* Only logs started before this time.
+  /// * **IN** *minDuration* Only logs at least this long.
+  /// * **IN** *maxDuration* Only logs at most this long.
+  /// * **IN** *transportModes* Only logs recorded with one of these transport modes.
+  /// * **IN** *orderBy* The order of the logs.
+  /// * **IN** *sortOrder* Ascending or descending order. [FileSortOrder.no] keeps the catalog order.
+  /// * **IN** *offset* Number of matching logs skipped.
+  /// * **IN** *limit* Maximum number of logs returned.
+  ///
+  /// **Returns**
+  ///
+  /// * The matching logs.
+  List<RecorderLogEntry> query({
+    final DateTime? startedAfter,
+    final DateTime? startedBefore,
+    final Duration? minDuration,
+    final Duration? maxDuration,
+    final Set<RecordingTransportMode>? transportModes,
+    final RecorderLogOrder orderBy = RecorderLogOrder.date,
+    final FileSortOrder sortOrder = FileSortOrder.desc,
+    final int offset = 0,
+    final int? limit,
+  }) {
+    final int? from = startedAfter?.millisecondsSinceEpoch;
+    final int? to = startedBefore?.millisecondsSinceEpoch;
+    final int? minMillis = minDuration?.inMilliseconds;
+    final int? maxMillis = maxDuration?.inMilliseconds;
+
+    final List<RecorderLogEntry> result = <RecorderLogEntry>[];
+    for (final RecorderLogEntry entry in _entries.values) {
+      if ((from != null && entry.startTimestampInMillis < from) ||
+          (to != null && entry.startTimestampInMillis >= to) ||
+          (minMillis != null && entry.durationMillis < minMillis) ||
+          (maxMillis != null && entry.durationMillis > maxMillis) ||
+          (transportModes != null &&
+              !transportModes.contains(entry.transportMode))) {
+        continue;
+      }
+      result.add(entry);
+    }
+
+    if (sortOrder != FileSortOrder.no) {
+      final int sign = sortOrder == FileSortOrder.desc ? -1 : 1;
+      result.sort(
+        (final RecorderLogEntry a, final RecorderLogEntry b) =>
+            sign * _compare(a, b, orderBy),
+      );
+    }
+
+    final int start = offset.clamp(0, result.length);
+    final int end = limit == null
+        ? result.length
+        : (start + limit).clamp(start, result.length);
+    return result.sublist(start, end);
+  }
+
+  /// Save the catalog in the log folder, if it changed since it was opened or saved.
+  ///
+  /// **Throws**
+  ///
+  /// * [FileSystemException] if the index cannot be written.
+  Future<void> save() async {
+    if (!_isModified) {
+      return;
+    }
+    final File file = File(_indexPath);
+    final File staged = File('$_indexPath.tmp');
+    await staged.writeAsBytes(_toBytes(), flush: true);
+    await staged.rename(file.path);
+    _isModified = false;
+  }
+
+  String get _indexPath => '$logsFolder${Platform.pathSeparator}.log_catalog';
+
+  RecorderLogEntry _read(
+    final String path,
+    final FileStat stat,
+    final bool isProtected,
+  ) {
+    final LogMetadata? metadata = bookmarks.getLogMetadata(path);
+    final int modified = stat.modified.millisecondsSinceEpoch;
+
+    if (metadata == null) {
+      // Video logs have no metadata, only a duration
+      final int duration = bookmarks.getLogDurationInSeconds(path) * 1000;
+      return RecorderLogEntry._(
+        path: path,
+        startTimestampInMillis: modified - duration,
+        endTimestampInMillis: modified,
+        durationMillis: duration,
+        transportMode: RecordingTransportMode.unknown,
+        logSize: stat.size,
+        isUploaded: false,
+        isProtected: isProtected,
+        startPosition: Coordinates(),
+        endPosition: Coordinates(),
+        modifiedInMillis: modified,
+        fileSize: stat.size,
+      );
+    }
+
+    return RecorderLogEntry._(
+      path: path,
+      startTimestampInMillis: metadata.startTimestampInMillis,
+      endTimestampInMillis: metadata.endTimestampInMillis,
+      durationMillis: metadata.durationMillis,
+      transportMode: metadata.transportMode,
+      logSize: metadata.logSize,
+      isUploaded: metadata.isUploaded,
+      isProtected: metadata.isProtected,
+      startPosition: metadata.startPosition,
+      endPosition: metadata.endPosition,
+      modifiedInMillis: modified,
+      fileSize: stat.size,
+    );
+  }
+
+  void _load(final Uint8List bytes) {
+    if (bytes.length < _headerSize) {
+      throw const FormatException('Invalid log catalog');
+    }
+    final ByteData data = ByteData.sublistView(bytes);
+    final int count = data.getUint32(8);
+    if (data.getUint32(0) != _magic ||
+        data.getUint32(4) != _version ||
+        bytes.length < _headerSize + count * _recordSize) {
+      throw const FormatException('Invalid log catalog');
+    }
+    _folderModifiedInMillis = _getInt64(data, 12);
+
+    for (int i = 0; i < count; i++) {
+      final int offset = _headerSize + i * _recordSize;
+      final int pathStart = data.getUint32(offset + 88);
+      final int pathEnd = pathStart + data.getUint32(offset + 92);
+      if (pathEnd > bytes.length) {
+        throw const FormatException('Invalid log catalog');
+      }
+      final int flags = data.getUint32(offset + 44);
+      final String path =
+          utf8.decode(Uint8List.sublistView(bytes, pathStart, pathEnd));
+      _entries[path] = RecorderLogEntry._(
+        path: path,
+        startTimestampInMillis: _getInt64(data, offset),
+        endTimestampInMillis: _getInt64(data, offset + 8),
+        durationMillis: _getInt64(data, offset + 16),
+        modifiedInMillis: _getInt64(data, offset + 24),
+        fileSize: _getInt64(data, offset + 32),
+        transportMode: RecordingTransportModeExtension.fromId(
+          data.getInt32(offset + 40),
+        ),
+        isUploaded: flags & 1 != 0,
+        isProtected: flags & 2 != 0,
+        logSize: _getInt64(data, offset + 48),
+        startPosition: Coordinates(
+          latitude: data.getFloat64(offset + 56),
+          longitude: data.getFloat64(offset + 64),
+        ),
+        endPosition: Coordinates(
+          latitude: data.getFloat64(offset + 72),
+          longitude: data.getFloat64(offset + 80),
+        ),
+      );
+    }
+  }
+
+  Uint8List _toBytes() {
+    final List<Uint8List> paths = _entries.keys.map(utf8.encode).toList();
+    int pathsSize = 0;
+    for (final Uint8List path in paths) {
+      pathsSize += path.length;
+    }
+
+    final int recordsEnd = _headerSize + _entries.length * _recordSize;
+    final Uint8List bytes = Uint8List(recordsEnd + pathsSize);
+    final ByteData data = ByteData.sublistView(bytes)
+      ..setUint32(0, _magic)
+      ..setUint32(4, _version)
+      ..setUint32(8, _entries.length);
+    _setInt64(data, 12, _folderModifiedInMillis);
+
+    int i = 0;
+    int pathOffset = recordsEnd;
+    for (final RecorderLogEntry entry in _entries.values) {
+      final int offset = _headerSize + i * _recordSize;
+      final Uint8List path = paths[i];
+      _setInt64(data, offset, entry.startTimestampInMillis);
+      _setInt64(data, offset + 8, entry.endTimestampInMillis);
+      _setInt64(data, offset + 16, entry.durationMillis);
+      _setInt64(data, offset + 24, entry._modifiedInMillis);
+      _setInt64(data, offset + 32, entry._fileSize);
+      _setInt64(data, offset + 48, entry.logSize);
+      data
+        ..setInt32(offset + 40, entry.transportMode.id)
+        ..setUint32(
+          offset + 44,
+          (entry.isUploaded ? 1 : 0) | (entry.isProtected ? 2 : 0),
+        )
+        ..setFloat64(offset + 56, entry.startPosition.latitude)
+        ..setFloat64(offset + 64, entry.startPosition.longitude)
+        ..setFloat64(offset + 72, entry.endPosition.latitude)
+        ..setFloat64(offset + 80, entry.endPosition.longitude)
+        ..setUint32(offset + 88, pathOffset)
+        ..setUint32(offset + 92, path.length);
+      bytes.setRange(pathOffset, pathOffset + path.length, path);
+      pathOffset += path.length;
+      i++;
+    }
+    return bytes;
+  }
+
+  // The 64 bits ByteData accessors are not supported on web. The values are
+  // stored as big endian 32 bits halves, the same bytes as setInt64
+  static int _getInt64(final ByteData data, final int offset) =>
+      data.getInt32(offset) * _highUnit + data.getUint32(offset + 4);
+
+  static void _setInt64(
+    final ByteData data,
+    final int offset,
+    final int value,
+  ) {
+    final int high = (value / _highUnit).floor();
+    data
+      ..setInt32(offset, high)
+      ..setUint32(offset + 4, value - high * _highUnit);
+  }
+
+  static int _compare(
+    final RecorderLogEntry a,
+    final RecorderLogEntry b,
+    final RecorderLogOrder orderBy,
+  ) {
+    switch (orderBy) {
+      case RecorderLogOrder.date:
+        return a.startTimestampInMillis.compareTo(b.startTimestampInMillis);
+      case RecorderLogOrder.duration:
+        return a.durationMillis.compareTo(b.durationMillis);
+      case RecorderLogOrder.size:
+        return a.logSize.compareTo(b.logSize);
+      case RecorderLogOrder.path:
+        return a.path.compareTo(b.path);
+    }
+  }
+
+  static const int _magic = 0x524C4354;
+  static const int _version = 3;
+  static const int _headerSize = 20;
+  static const int _highUnit = 0x100000000;
+  static const int _recordSize = 96;
+}
@@ -0,0 +1,622 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/sense.dart';
+import 'package:gem_kit/src/gem_kit_platform_interface.dart';
+import 'package:gem_kit/src/position/gem_position.dart';
+import 'package:gem_kit/src/sense/sense_data_impl.dart';
+import 'package:meta/meta.dart';
+
+/// Ring buffer of sense data samples waiting to be pushed to a [DataSource].
+///
+/// Samples are stored as fixed-layout records (type, acquisition timestamp, fields) in a preallocated buffer, so appending a sample does not allocate.
+/// The buffered samples are sent to the SDK with [DataSource.pushBatch].
+///
+/// When the buffer is full the oldest sample is overwritten and [droppedCount] is increased.
+///
+/// {@category Sensor Data Source}
+class SenseDataBatch {
+  /// Create an empty batch.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *capacity* Maximum number of samples kept before the oldest ones are overwritten.
+  SenseDataBatch({this.capacity = 1024})
+      : assert(capacity > 0, 'capacity must be positive'),
+        _records = Float64List(capacity * _recordSize),
+        _payloads = List<Map<String, dynamic>?>.filled(capacity, null);
+
+  /// Maximum number of samples kept before the oldest ones are overwritten.
+  final int capacity;
+
+  final Float64List _records;
+  // JSON payloads of the variable-length samples (improved position, NMEA chunk)
+  final List<Map<String, dynamic>?> _payloads;
+  final StringBuffer _buffer = StringBuffer();
+
+  int _head = 0;
+  int _length = 0;
+  int _droppedCount = 0;
+
+  /// Number of samples waiting to be pushed.
+  int get length => _length;
+
+  /// Check if there are no samples waiting to be pushed.
+  bool get isEmpty => _length == 0;
+
+  /// Number of samples overwritten because the batch was full.
+  int get droppedCount => _droppedCount;
+
+  /// Remove all the samples waiting to be pushed.
+  void clear() {
+    _payloads.fillRange(0, capacity, null);
+    _head = 0;
+    _length = 0;
+  }
+
+  /// Append an acceleration sample.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *timestamp* Acquisition time in milliseconds since epoch.
+  /// * **IN** *x* Acceleration on the x axis.
+  /// * **IN** *y* Acceleration on the y axis.
+  /// * **IN** *z* Acceleration on the z axis.
+  /// * **IN** *unit* Unit of the values.
+  void addAcceleration(
+    final int timestamp,
+    final double x,
+    final double y,
+    final double z, {
+    final UnitOfMeasurementAcceleration unit = UnitOfMeasurementAcceleration.g,
+  }) {
+    final int offset = _reserve(DataType.acceleration.id, timestamp);
+    _records[offset] = x;
+    _records[offset + 1] = y;
+    _records[offset + 2] = z;
+    _records[offset + 3] = unit.id.toDouble();
+  }
+
+  /// Append a rotation rate sample.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *timestamp* Acquisition time in milliseconds since epoch.
+  /// * **IN** *x* Rotation rate around the x axis.
+  /// * **IN** *y* Rotation rate around the y axis.
+  /// * **IN** *z* Rotation rate around the z axis.
+  void addRotationRate(
+    final int timestamp,
+    final double x,
+    final double y,
+    final double z,
+  ) {
+    final int offset = _reserve(DataType.rotationRate.id, timestamp);
+    _records[offset] = x;
+    _records[offset + 1] = y;
+    _records[offset + 2] = z;
+  }
+
+  /// Append a magnetic field sample.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *timestamp* Acquisition time in milliseconds since epoch.
+  /// * **IN** *x* Magnetic field on the x axis.
+  /// * **IN** *y* Magnetic field on the y axis.
+  /// * **IN** *z* Magnetic field on the z axis.
+  void addMagneticField(
+    final int timestamp,
+    final double x,
+    final double y,
+    final double z,
+  ) {
+    final int offset = _reserve(DataType.magneticField.id, timestamp);
+    _records[offset] = x;
+    _records[offset + 1] = y;
+    _records[offset + 2] = z;
+  }
+
+  /// Append an attitude sample.
+  ///
+  /// Noise values are marked as available only when they are provided.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *timestamp* Acquisition time in milliseconds since epoch.
+  /// * **IN** *roll* Roll in degrees.
+  /// * **IN** *pitch* Pitch in degrees.
+  /// * **IN** *yaw* Yaw in degrees.
+  /// * **IN** *rollNoise* Roll noise in degrees.
+  /// * **IN** *pitchNoise* Pitch noise in degrees.
+  /// * **IN** *yawNoise* Yaw noise in degrees.
+  void addAttitude(
+    final int timestamp,
+    final double roll,
+    final double pitch,
+    final double yaw, {
+    final double? rollNoise,
+    final double? pitchNoise,
+    final double? yawNoise,
+  }) {
+    final int offset = _reserve(DataType.attitude.id, timestamp);
+    _records[offset] = roll;
+    _records[offset + 1] = pitch;
+    _records[offset + 2] = yaw;
+    _records[offset + 3] = rollNoise ?? 0;
+    _records[offset + 4] = pitchNoise ?? 0;
+    _records[offset + 5] = yawNoise ?? 0;
+    _records[offset + 6] = _flags(
+      pitchNoise != null,
+      rollNoise != null,
+      yawNoise != null,
+    );
+  }
+
+  /// Append a compass sample.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *timestamp* Acquisition time in milliseconds since epoch.
+  /// * **IN** *heading* Heading in degrees.
+  /// * **IN** *accuracy* Accuracy of the heading.
+  void addCompass(
+    final int timestamp,
+    final double heading, {
+    final CompassAccuracy accuracy = CompassAccuracy.unknown,
+  }) {
+    final int offset = _reserve(DataType.compass.id, timestamp);
+    _records[offset] = heading;
+    _records[offset + 1] = accuracy.id.toDouble();
+  }
+
+  /// Append a position sample.
+  ///
+  /// Optional values are marked as available only when they are not negative.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *timestamp* Acquisition time in milliseconds since epoch. Also used as satellite time.
+  /// * **IN** *latitude* Latitude in degrees.
+  /// * **IN** *longitude* Longitude in degrees.
+  /// * **IN** *altitude* Altitude in meters. Null if not available.
+  /// * **IN** *speed* Speed in m/s. Negative if not available.
+  /// * **IN** *course* Course in degrees. Negative if not available.
+  /// * **IN** *accuracyH* Horizontal accuracy in meters. Negative if not available.
+  /// * **IN** *accuracyV* Vertical accuracy in meters. Negative if not available.
+  /// * **IN** *speedAccuracy* Speed accuracy in m/s. Negative if not available.
+  /// * **IN** *courseAccuracy* Course accuracy in degrees. Negative if not available.
+  /// * **IN** *provider* Provider of the position.
+  /// * **IN** *fixQuality* Quality of the position.
+  void addPosition(
+    final int timestamp,
+    final double latitude,
+    final double longitude, {
+    final double? altitude,
+    final double speed = -1.0,
+    final double course = -1.0,
+    final double accuracyH = -1.0,
+    final double accuracyV = -1.0,
+    final double speedAccuracy = -1.0,
+    final double courseAccuracy = -1.0,
+    final Provider provider = Provider.gps,
+    final PositionQuality fixQuality = PositionQuality.high,
+  }) {
+    final int offset = _reserve(DataType.position.id, timestamp);
+    _records[offset] = timestamp.toDouble();
+    _records[offset + 1] = provider.id.toDouble();
+    _records[offset + 2] = fixQuality.id.toDouble();
+    _records[offset + 3] = latitude;
+    _records[offset + 4] = longitude;
+    _records[offset + 5] = altitude ?? 0;
+    _records[offset + 6] = speed;
+    _records[offset + 7] = speedAccuracy;
+    _records[offset + 8] = course;
+    _records[offset + 9] = courseAccuracy;
+    _records[offset + 10] = accuracyH;
+    _records[offset + 11] = accuracyV;
+    _records[offset + 12] = _flags(
+      true,
+      altitude != null,
+      speed >= 0,
+      speedAccuracy >= 0,
+      course >= 0,
+      courseAccuracy >= 0,
+      accuracyH >= 0,
+      accuracyV >= 0,
+    );
+  }
+
+  /// Append a sample of any type.
+  ///
+  /// Fixed-layout types are copied field by field. [GemImprovedPosition] and [NmeaChunk] samples are kept as JSON.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *data* The sample. Must be created with [SenseDataFactory].
+  ///
+  /// **Returns**
+  ///
+  /// * True if the sample was appended, false if its type is not supported.
+  bool add(final SenseData data) {
+    if (data is! SenseDataImpl) {
+      return false;
+    }
+
+    final int timestamp = data.acquisitionTime.millisecondsSinceEpoch;
+
+    if (data is GemImprovedPositionImpl || data is NmeaChunkImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _payloads[offset ~/ _recordSize] = data.toJson();
+      return true;
+    }
+
+    if (data is GemPositionImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.satelliteTime.millisecondsSinceEpoch.toDouble();
+      _records[offset + 1] = data.provider.id.toDouble();
+      _records[offset + 2] = data.fixQuality.id.toDouble();
+      _records[offset + 3] = data.latitude;
+      _records[offset + 4] = data.longitude;
+      _records[offset + 5] = data.altitude;
+      _records[offset + 6] = data.speed;
+      _records[offset + 7] = data.speedAccuracy;
+      _records[offset + 8] = data.course;
+      _records[offset + 9] = data.courseAccuracy;
+      _records[offset + 10] = data.accuracyH;
+      _records[offset + 11] = data.accuracyV;
+      _records[offset + 12] = _flags(
+        data.hasCoordinates,
+        data.hasAltitude,
+        data.hasSpeed,
+        data.hasSpeedAccuracy,
+        data.hasCourse,
+        data.hasCourseAccuracy,
+        data.hasHorizontalAccuracy,
+        data.hasVerticalAccuracy,
+      );
+    } else if (data is AccelerationImpl) {
+      addAcceleration(timestamp, data.x, data.y, data.z, unit: data.unit);
+    } else if (data is RotationRateImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.x;
+      _records[offset + 1] = data.y;
+      _records[offset + 2] = data.z;
+    } else if (data is MagneticFieldImpl) {
+      addMagneticField(timestamp, data.x, data.y, data.z);
+    } else if (data is AttitudeImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.roll;
+      _records[offset + 1] = data.pitch;
+      _records[offset + 2] = data.yaw;
+      _records[offset + 3] = data.rollNoise;
+      _records[offset + 4] = data.pitchNoise;
+      _records[offset + 5] = data.yawNoise;
+      _records[offset + 6] = _flags(
+        data.hasPitchNoise,
+        data.hasRollNoise,
+        data.hasYawNoise,
+      );
+    } else if (data is CompassImpl) {
+      addCompass(timestamp, data.heading, accuracy: data.accuracy);
+    } else if (data is BatteryImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.health.id.toDouble();
+      _records[offset + 1] = data.level.toDouble();
+      _records[offset + 2] = data.pluggedType.id.toDouble();
+      _records[offset + 3] = data.state.id.toDouble();
+      _records[offset + 4] = data.temperature.toDouble();
+      _records[offset + 5] = data.voltage.toDouble();
+      _records[offset + 6] = _flags(data.lowBatteryNoticed);
+    } else if (data is OrientationImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.face.id.toDouble();
+      _records[offset + 1] = data.orientation.id.toDouble();
+    } else if (data is TemperatureImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.level.id.toDouble();
+      _records[offset + 1] = data.temperature;
+    } else if (data is HeartRateImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.heartRate.toDouble();
+    } else if (data is MountInformationImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = _flags(
+        data.isMountedForCameraUse,
+        data.isPortraitMode,
+      );
+    } else if (data is ActivityImpl) {
+      final int offset = _reserve(data.type.id, timestamp);
+      _records[offset] = data.activityType.id.toDouble();
+      _records[offset + 1] = data.confidence.id.toDouble();
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  /// Push the buffered samples, oldest first, to the data source with the given pointer id and empty the batch.
+  ///
+  /// The request for each sample is written directly from the record, without building intermediate objects.
+  ///
+  /// Returns the number of samples accepted by the data source.
+  @internal
+  int drainInto(final int dataSourceId) {
+    int accepted = 0;
+
+    while (_length > 0) {
+      final int index = (_head - _length + capacity) % capacity;
+      final int offset = index * _recordSize;
+      _length--;
+
+      _buffer
+        ..clear()
+        ..write('{"id":')
+        ..write(dataSourceId)
+        ..write(',"class":"DataSourceContainer","method":"pushData","args":');
+
+      final Map<String, dynamic>? payload = _payloads[index];
+      if (payload != null) {
+        _payloads[index] = null;
+        _buffer.write(jsonEncode(payload));
+      } else {
+        _writeRecord(offset);
+      }
+      _buffer.write('}');
+
+      final String resultStr =
+          GemKitPlatform.instance.callObjectMethod(_buffer.toString());
+      if (OperationResult(jsonDecode(resultStr))['result'] == true) {
+        accepted++;
+      }
+    }
+
+    _head = 0;
+    return accepted;
+  }
+
+  /// Visit the buffered fixed-layout samples, oldest first. Improved position and NMEA samples are skipped.
+  ///
+  /// The fields of a sample start at `fieldsOffset` in `records`, in the order given by [columnNamesOf].
+  @internal
+  void forEachRecord(
+    final void Function(
+      int typeId,
+      int timestamp,
+      Float64List records,
+      int fieldsOffset,
+    ) visit,
+  ) {
+    for (int i = _length; i > 0; i--) {
+      final int index = (_head - i + capacity) % capacity;
+      if (_payloads[index] != null) {
+        continue;
+      }
+      final int offset = index * _recordSize;
+      visit(
+        _records[offset].toInt(),
+        _records[offset + 1].toInt(),
+        _records,
+        offset + _headerSize,
+      );
+    }
+  }
+
+  /// Get the names of the fields of a record type, in record order. The flags are packed in a single last field named `flags`.
+  ///
+  /// Returns null if the type has no fixed layout.
+  @internal
+  static List<String>? columnNamesOf(final int typeId) {
+    final List<_SenseField>? layout = _layouts[typeId];
+    if (layout == null) {
+      return null;
+    }
+    final List<String> names = <String>[
+      for (final _SenseField field in layout)
+        if (field.kind != _SenseFieldKind.flag) field.key,
+    ];
+    if (names.length != layout.length) {
+      names.add('flags');
+    }
+    return names;
+  }
+
+  /// Get the names of the flags of a record type. Flag `i` is bit `i` of the `flags` field.
+  @internal
+  static List<String> flagNamesOf(final int typeId) => <String>[
+        for (final _SenseField field
+            in _layouts[typeId] ?? const <_SenseField>[])
+          if (field.kind == _SenseFieldKind.flag) field.key,
+      ];
+
+  int _reserve(final int typeId, final int timestamp) {
+    if (_length == capacity) {
+      _droppedCount++;
+      _payloads[_head] = null;
+    } else {
+      _length++;
+    }
+
+    final int offset = _head * _recordSize;
+    _head = (_head + 1) % capacity;
+
+    _records[offset] = typeId.toDouble();
+    _records[offset + 1] = timestamp.toDouble();
+    return offset + _headerSize;
+  }
+
+  void _writeRecord(final int offset) {
+    final int typeId = _records[offset].toInt();
+    final List<_SenseField>? layout = _layouts[typeId];
+    if (layout == null) {
+      throw ArgumentError('Unsupported sense data type $typeId');
+    }
+
+    _buffer
+      ..write('{"senseDataType":')
+      ..write(typeId)
+      ..write(',"acquisitionTimestamp":')
+      ..write(_records[offset + 1].toInt());
+
+    final int fields = offset + _headerSize;
+    int flags = 0;
+    int bit = -1;
+    for (int i = 0; i < layout.length; i++) {
+      final _SenseField field = layout[i];
+      _buffer
+        ..write(',"')
+        ..write(field.key)
+        ..write('":');
+
+      switch (field.kind) {
+        case _SenseFieldKind.real:
+          final double value = _records[fields + i];
+          if (!value.isFinite) {
+            throw ArgumentError('Invalid value $value for ${field.key}');
+          }
+          _buffer.write(value);
+        case _SenseFieldKind.integer:
+          _buffer.write(_records[fields + i].toInt());
+        case _SenseFieldKind.flag:
+          // Flags come last and share the slot following the other fields
+          if (bit < 0) {
+            flags = _records[fields + i].toInt();
+            bit = 0;
+          }
+          _buffer.write((flags >> bit) & 1 == 1);
+          bit++;
+      }
+    }
+
+    _buffer.write('}');
+  }
+
+  static double _flags(
+    final bool b0, [
+    final bool b1 = false,
+    final bool b2 = false,
+    final bool b3 = false,
+    final bool b4 = false,
+    final bool b5 = false,
+    final bool b6 = false,
+    final bool b7 = false,
+  ]) {
+    final int mask = (b0 ? 1 : 0) |
+        (b1 ? 2 : 0) |
+        (b2 ? 4 : 0) |
+        (b3 ? 8 : 0) |
+        (b4 ? 16 : 0) |
+        (b5 ? 32 : 0) |
+        (b6 ? 64 : 0) |
+        (b7 ? 128 : 0);
+    return mask.toDouble();
+  }
+
+  static const int _headerSize = 2;
+  static const int _maxFields = 13;
+  static const int _recordSize = _headerSize + _maxFields;
+
+  // Field layouts, in record order. Flags are packed in a single slot placed after the other fields
+  static const List<_SenseField> _positionLayout = <_SenseField>[
+    _SenseField('timestamp', _SenseFieldKind.integer),
+    _SenseField('provider', _SenseFieldKind.integer),
+    _SenseField('fix', _SenseFieldKind.integer),
+    _SenseField('latitude', _SenseFieldKind.real),
+    _SenseField('longitude', _SenseFieldKind.real),
+    _SenseField('alt', _SenseFieldKind.real),
+    _SenseField('speed', _SenseFieldKind.real),
+    _SenseField('speedAccuracy', _SenseFieldKind.real),
+    _SenseField('course', _SenseFieldKind.real),
+    _SenseField('courseAccuracy', _SenseFieldKind.real),
+    _SenseField('accuracyH', _SenseFieldKind.real),
+    _SenseField('accuracyV', _SenseFieldKind.real),
+    _SenseField('hasCoordinates', _SenseFieldKind.flag),
+    _SenseField('hasAltitude', _SenseFieldKind.flag),
+    _SenseField('hasSpeed', _SenseFieldKind.flag),
+    _SenseField('hasSpeedAccuracy', _SenseFieldKind.flag),
+    _SenseField('hasCourse', _SenseFieldKind.flag),
+    _SenseField('hasCourseAccuracy', _SenseFieldKind.flag),
+    _SenseField('hasHorizontalAccuracy', _SenseFieldKind.flag),
+    _SenseField('hasVerticalAccuracy', _SenseFieldKind.flag),
+  ];
+
+  static const List<_SenseField> _xyzLayout = <_SenseField>[
+    _SenseField('x', _SenseFieldKind.real),
+    _SenseField('y', _SenseFieldKind.real),
+    _SenseField('z', _SenseFieldKind.real),
+  ];
+
+  static final Map<int, List<_SenseField>> _layouts = <int, List<_SenseField>>{
+    DataType.position.id: _positionLayout,
+    DataType.acceleration.id: const <_SenseField>[
+      ..._xyzLayout,
+      _SenseField('unit', _SenseFieldKind.integer),
+    ],
+    DataType.rotationRate.id: _xyzLayout,
+    DataType.magneticField.id: _xyzLayout,
+    DataType.attitude.id: const <_SenseField>[
+      _SenseField('roll', _SenseFieldKind.real),
+      _SenseField('pitch', _SenseFieldKind.real),
+      _SenseField('yaw', _SenseFieldKind.real),
+      _SenseField('rollNoise', _SenseFieldKind.real),
+      _SenseField('pitchNoise', _SenseFieldKind.real),
+      _SenseField('yawNoise', _SenseFieldKind.real),
+      _SenseField('hasPitchNoise', _SenseFieldKind.flag),
+      _SenseField('hasRollNoise', _SenseFieldKind.flag),
+      _SenseField('hasYawNoise', _SenseFieldKind.flag),
+    ],
+    DataType.compass.id: const <_SenseField>[
+      _SenseField('heading', _SenseFieldKind.real),
+      _SenseField('accuracy', _SenseFieldKind.integer),
+    ],
+    DataType.battery.id: const <_SenseField>[
+      _SenseField('health', _SenseFieldKind.integer),
+      _SenseField('level', _SenseFieldKind.integer),
+      _SenseField('pluggedType', _SenseFieldKind.integer),
+      _SenseField('state', _SenseFieldKind.integer),
+      _SenseField('temperature', _SenseFieldKind.integer),
+      _SenseField('voltage', _SenseFieldKind.integer),
+      _SenseField('lowBattery', _SenseFieldKind.flag),
+    ],
+    DataType.orientation.id: const <_SenseField>[
+      _SenseField('faceType', _SenseFieldKind.integer),
+      _SenseField('orientation', _SenseFieldKind.integer),
+    ],
+    DataType.temperature.id: const <_SenseField>[
+      _SenseField('temperatureLevel', _SenseFieldKind.integer),
+      _SenseField('temperatureDegrees', _SenseFieldKind.real),
+    ],
+    DataType.heartRate.id: const <_SenseField>[
+      _SenseField('heartRate', _SenseFieldKind.integer),
+    ],
+    DataType.mountInformation.id: const <_SenseField>[
+      _SenseField('mountedForCameraUse', _SenseFieldKind.flag),
+      _SenseField('isPortraitMode', _SenseFieldKind.flag),
+    ],
+    DataType.activity.id: const <_SenseField>[
+      _SenseField('activity', _SenseFieldKind.integer),
+      _SenseField('confidence', _SenseFieldKind.integer),
+    ],
+  };
+}
+
+enum _SenseFieldKind { real, integer, flag }
+
+class _SenseField {
+  const _SenseField(this.key, this.kind);
+
+  final String key;
+  final _SenseFieldKind kind;
+}
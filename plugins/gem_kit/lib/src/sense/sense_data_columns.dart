@@ -0,0 +1,456 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:gem_kit/src/core/gem_error.dart';
+import 'package:gem_kit/src/sense/data_source_listener.dart';
+import 'package:gem_kit/src/sense/sense_data.dart';
+import 'package:gem_kit/src/sense/sense_data_batch.dart';
+import 'package:gem_kit/src/sense/sense_data_source.dart';
+import 'package:gem_kit/src/sense/sense_data_types.dart';
+
+/// Samples of one data type, stored as columns of doubles.
+///
+/// Row `i` is made of `timestamps[i]` and the `i`-th value of each column.
+/// Integer and enum fields are stored as doubles. Boolean fields are packed in the `flags` column, see [flagNames].
+///
+/// {@category Sensor Data Source}
+class SenseDataTable {
+  SenseDataTable._(this.type, this.columnNames, this.flagNames)
+      : _columns = List<Float64List>.generate(
+          columnNames.length,
+          (final _) => Float64List(_initialCapacity),
+        );
+
+  /// The data type of the samples.
+  final DataType type;
+
+  /// The names of the columns, without the timestamps.
+  ///
+  /// The names are the ones used for the fields of the data type in the SDK, for example `latitude`, `speed`, `course` for positions and `x`, `y`, `z` for accelerations.
+  final List<String> columnNames;
+
+  /// The names of the boolean fields. Field `i` is bit `i` of the `flags` column.
+  final List<String> flagNames;
+
+  Float64List _timestamps = Float64List(_initialCapacity);
+  List<Float64List> _columns;
+  int _length = 0;
+
+  /// Number of samples.
+  int get length => _length;
+
+  /// Acquisition times in milliseconds since epoch.
+  Float64List get timestamps =>
+      Float64List.sublistView(_timestamps, 0, _length);
+
+  /// Get a column.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *name* The name of the column, one of [columnNames].
+  ///
+  /// **Returns**
+  ///
+  /// * The values of the column, one per sample.
+  ///
+  /// **Throws**
+  ///
+  /// * [ArgumentError] if there is no column with this name.
+  Float64List column(final String name) {
+    final int index = columnNames.indexOf(name);
+    if (index < 0) {
+      throw ArgumentError.value(name, 'name', 'Unknown column');
+    }
+    return Float64List.sublistView(_columns[index], 0, _length);
+  }
+
+  void _append(
+    final int timestamp,
+    final Float64List records,
+    final int fieldsOffset,
+  ) {
+    if (_length == _timestamps.length) {
+      _grow(_length * 2);
+    }
+    _timestamps[_length] = timestamp.toDouble();
+    for (int c = 0; c < _columns.length; c++) {
+      _columns[c][_length] = records[fieldsOffset + c];
+    }
+    _length++;
+  }
+
+  void _grow(final int capacity) {
+    _timestamps = Float64List(capacity)..setRange(0, _length, _timestamps);
+    _columns = <Float64List>[
+      for (final Float64List column in _columns)
+        Float64List(capacity)..setRange(0, _length, column),
+    ];
+  }
+
+  static const int _initialCapacity = 256;
+}
+
+/// Sense data samples stored as one [SenseDataTable] per data type.
+///
+/// Use [readLog] to decode a recorded log, and [toBytes] to export the columns for analysis.
+///
+/// {@category Sensor Data Source}
+class SenseDataColumns {
+  /// Create empty columns.
+  SenseDataColumns();
+
+  /// Load columns saved with [toBytes].
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *bytes* The saved columns.
+  ///
+  /// **Returns**
+  ///
+  /// * The columns.
+  ///
+  /// **Throws**
+  ///
+  /// * [FormatException] if the data is not valid.
+  factory SenseDataColumns.fromBytes(final Uint8List bytes) {
+    final ByteData data = ByteData.sublistView(bytes);
+    if (bytes.length < 16 ||
+        data.getUint32(0, Endian.little) != _magic ||
+        data.getUint32(4, Endian.little) != _version) {
+      throw const FormatException('Invalid sense data columns');
+    }
+
+    final SenseDataColumns result = SenseDataColumns();
+    final int tableCount = data.getUint32(8, Endian.little);
+    int offset = 16;
+    try {
+      for (int t = 0; t < tableCount; t++) {
+        final int typeId = data.getUint32(offset, Endian.little);
+        final int rows = data.getUint32(offset + 4, Endian.little);
+        final int columnCount = data.getUint32(offset + 8, Endian.little);
+        offset += 16;
+        // Each table has at least the timestamp column, and the columns must
+        // fit in the data before they are allocated
+        if (columnCount == 0 ||
+            offset + columnCount * (rows * 8 + 8) > bytes.length) {
+          throw const FormatException('Invalid sense data columns');
+        }
+
+        final List<String> names = <String>[];
+        final List<Float64List> columns = <Float64List>[];
+        for (int c = 0; c < columnCount; c++) {
+          final int nameLength = data.getUint32(offset, Endian.little);
+          names.add(
+            utf8.decode(
+              Uint8List.sublistView(bytes, offset + 4, offset + 4 + nameLength),
+            ),
+          );
+          offset = _align(offset + 4 + nameLength);
+          final Float64List column = Float64List(rows);
+          for (int r = 0; r < rows; r++) {
+            column[r] = data.getFloat64(offset + r * 8, Endian.little);
+          }
+          columns.add(column);
+          offset += rows * 8;
+        }
+
+        final DataType type = DataTypeExtension.fromId(typeId);
+        final SenseDataTable table = result._tableOf(type);
+        if (table.columnNames.length + 1 != columnCount) {
+          throw const FormatException('Invalid sense data columns');
+        }
+        table
+          .._timestamps = columns.first
+          .._columns = columns.sublist(1)
+          .._length = rows;
+      }
+    } on RangeError {
+      throw const FormatException('Invalid sense data columns');
+    } on ArgumentError {
+      throw const FormatException('Invalid sense data columns');
+    }
+    return result;
+  }
+
+  final Map<DataType, SenseDataTable> _tables = <DataType, SenseDataTable>{};
+
+  /// The tables, one per data type with samples.
+  List<SenseDataTable> get tables => _tables.values.toList();
+
+  /// Get the table of a data type.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *type* The data type.
+  ///
+  /// **Returns**
+  ///
+  /// * The table, or null if there are no samples of this type.
+  SenseDataTable? tableOf(final DataType type) => _tables[type];
+
+  /// Append the samples of a batch.
+  ///
+  /// Improved position and NMEA samples are not stored in columns and are skipped.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *batch* The samples.
+  /// * **IN** *until* Only samples acquired up to this time, in milliseconds since epoch, are appended.
+  ///
+  /// **Returns**
+  ///
+  /// * The number of samples appended.
+  int addBatch(final SenseDataBatch batch, {final int? until}) {
+    int count = 0;
+    batch.forEachRecord((
+      final int typeId,
+      final int timestamp,
+      final Float64List records,
+      final int fieldsOffset,
+    ) {
+      if (until != null && timestamp > until) {
+        return;
+      }
+      _tableOf(DataTypeExtension.fromId(typeId))
+          ._append(timestamp, records, fieldsOffset);
+      count++;
+    });
+    return count;
+  }
+
+  /// Export the columns.
+  ///
+  /// The format is little endian:
+  /// * header: magic `SDCL` (uint32), version (uint32), number of tables (uint32), reserved (uint32)
+  /// * for each table: data type id (uint32), number of rows (uint32), number of columns (uint32), reserved (uint32), then the columns
+  /// * for each column: name length (uint32), UTF-8 name padded to 8 bytes, then one float64 per row
+  ///
+  /// The first column of each table is `timestamp`. Each column is aligned to 8 bytes, so it can be read in place by most analysis tools.
+  ///
+  /// **Returns**
+  ///
+  /// * The exported columns, to be loaded with [SenseDataColumns.fromBytes].
+  Uint8List toBytes() {
+    final BytesBuilder builder = BytesBuilder(copy: false);
+    final ByteData header = ByteData(16)
+      ..setUint32(0, _magic, Endian.little)
+      ..setUint32(4, _version, Endian.little)
+      ..setUint32(8, _tables.length, Endian.little);
+    builder.add(header.buffer.asUint8List());
+
+    for (final SenseDataTable table in _tables.values) {
+      final ByteData tableHeader = ByteData(16)
+        ..setUint32(0, table.type.id, Endian.little)
+        ..setUint32(4, table.length, Endian.little)
+        ..setUint32(8, table.columnNames.length + 1, Endian.little);
+      builder.add(tableHeader.buffer.asUint8List());
+
+      _addColumn(builder, 'timestamp', table.timestamps);
+      for (int c = 0; c < table.columnNames.length; c++) {
+        _addColumn(
+          builder,
+          table.columnNames[c],
+          Float64List.sublistView(table._columns[c], 0, table.length),
+        );
+      }
+    }
+    return builder.takeBytes();
+  }
+
+  /// Decode a recorded log into columns.
+  ///
+  /// The log is played back at the maximum speed supported by the SDK and the samples are stored directly in columns, without keeping the [SenseData] objects.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *logPath* The path of the log.
+  /// * **IN** *dataTypes* The data types to decode. By default all the data types of the log with a fixed layout.
+  /// * **IN** *start* Offset from the beginning of the log of the first decoded sample.
+  /// * **IN** *end* Offset from the beginning of the log after which the decoding stops.
+  /// * **IN** *onProgressUpdated* Called with the playback progress.
+  /// * **IN** *timeout* Maximum time without any sample or progress from the playback, after which the decoding fails.
+  ///
+  /// **Returns**
+  ///
+  /// * [GemError.success] and the columns on success.
+  /// * [GemError.notFound] if the log cannot be opened.
+  /// * [GemError.invalidInput] if none of the data types is available in the log.
+  /// * [GemError.outOfRange] if the playback cannot be moved to [start].
+  /// * [GemError.operationTimeout] if the playback stalled for [timeout].
+  /// * The error of [DataSource.start] if the playback cannot be started.
+  static Future<(GemError, SenseDataColumns?)> readLog(
+    final String logPath, {
+    final List<DataType>? dataTypes,
+    final Duration start = Duration.zero,
+    final Duration? end,
+    final void Function(int progress)? onProgressUpdated,
+    final Duration timeout = const Duration(seconds: 30),
+  }) {
+    final DataSource? source = DataSource.createLogDataSource(logPath);
+    final Playback? playback = source?.playback;
+    if (source == null || playback == null) {
+      return Future<(GemError, SenseDataColumns?)>.value(
+        (GemError.notFound, null),
+      );
+    }
+
+    final List<DataType> types = (dataTypes ?? source.availableDataTypes)
+        .where(
+          (final DataType type) =>
+              SenseDataBatch.columnNamesOf(type.id) != null &&
+              source.isDataTypeAvailable(type),
+        )
+        .toList();
+    if (types.isEmpty) {
+      source.dispose();
+      return Future<(GemError, SenseDataColumns?)>.value(
+        (GemError.invalidInput, null),
+      );
+    }
+
+    final Completer<(GemError, SenseDataColumns?)> completer =
+        Completer<(GemError, SenseDataColumns?)>();
+    final SenseDataColumns columns = SenseDataColumns();
+    final SenseDataBatch batch = SenseDataBatch(capacity: _batchSize);
+    final int? range = end == null ? null : (end - start).inMilliseconds;
+    int? until;
+    late final DataSourceListener listener;
+    Timer? stallTimer;
+
+    void finish(final GemError error) {
+      if (completer.isCompleted) {
+        return;
+      }
+      stallTimer?.cancel();
+      columns.addBatch(batch, until: until);
+      batch.clear();
+      source
+        ..removeListenerAllDataTypes(listener)
+        ..stop()
+        ..dispose();
+      completer.complete(
+        error == GemError.success ? (error, columns) : (error, null),
+      );
+    }
+
+    // Restarted by each sample and progress update
+    void watchStall() {
+      stallTimer?.cancel();
+      stallTimer = Timer(
+        timeout,
+        () => finish(GemError.operationTimeout),
+      );
+    }
+
+    listener = DataSourceListener(
+      onNewData: (final SenseData data) {
+        if (completer.isCompleted) {
+          return;
+        }
+        watchStall();
+        final int timestamp = data.acquisitionTime.millisecondsSinceEpoch;
+        if (until == null && range != null) {
+          until = timestamp + range;
+        }
+        if (until != null && timestamp > until!) {
+          finish(GemError.success);
+          return;
+        }
+        batch.add(data);
+        if (batch.length == _batchSize) {
+          columns.addBatch(batch, until: until);
+          batch.clear();
+        }
+      },
+      onPlayingStatusChanged: (final DataType _, final PlayingStatus status) {
+        if (status == PlayingStatus.stopped) {
+          finish(GemError.success);
+        }
+      },
+      onProgressChanged: (final int progress) {
+        if (completer.isCompleted) {
+          return;
+        }
+        watchStall();
+        onProgressUpdated?.call(progress);
+        if (progress >= 100) {
+          finish(GemError.success);
+        }
+      },
+    );
+
+    for (final DataType type in types) {
+      source.addListener(listener: listener, dataType: type);
+    }
+    if (start > Duration.zero) {
+      final int position = start.inMilliseconds;
+      bool isMoved = position <= playback.duration;
+      if (isMoved) {
+        // The playback keeps its position if the seek is rejected
+        final int previous = playback.setCurrentPosition(position);
+        isMoved = playback.currentPosition != previous;
+      }
+      if (!isMoved) {
+        finish(GemError.outOfRange);
+        return completer.future;
+      }
+    }
+    playback.setSpeedMultiplier(playback.maxSpeedMultiplier);
+    final GemError error = source.start();
+    if (error != GemError.success) {
+      finish(error);
+      return completer.future;
+    }
+    watchStall();
+
+    return completer.future;
+  }
+
+  SenseDataTable _tableOf(final DataType type) => _tables.putIfAbsent(
+        type,
+        () => SenseDataTable._(
+          type,
+          SenseDataBatch.columnNamesOf(type.id) ??
+              (throw ArgumentError('Unsupported sense data type $type')),
+          SenseDataBatch.flagNamesOf(type.id),
+        ),
+      );
+
+  static void _addColumn(
+    final BytesBuilder builder,
+    final String name,
+    final Float64List values,
+  ) {
+    final Uint8List encodedName = utf8.encode(name);
+    final int headerSize = _align(4 + encodedName.length);
+    final ByteData header = ByteData(headerSize)
+      ..setUint32(0, encodedName.length, Endian.little);
+    header.buffer
+        .asUint8List()
+        .setRange(4, 4 + encodedName.length, encodedName);
+    builder.add(header.buffer.asUint8List());
+
+    final ByteData column = ByteData(values.length * 8);
+    for (int r = 0; r < values.length; r++) {
+      column.setFloat64(r * 8, values[r], Endian.little);
+    }
+    builder.add(column.buffer.asUint8List());
+  }
+
+  static int _align(final int offset) => (offset + 7) & ~7;
+
+  static const int _magic = 0x4C434453;
+  static const int _version = 1;
+  static const int _batchSize = 4096;
+}
@@ -111,7 +111,10 @@ class DataSource extends GemAutoreleaseObject {
   DataSource._() : _pointerId = -1;
 
   DataSource.init(final int id) : _pointerId = id {
-    super.registerAutoReleaseObject(_pointerId);
+    super.registerAutoReleaseObject(
+      _pointerId,
+      className: 'DataSourceContainer',
+    );
   }
   final int _pointerId;
 
@@ -656,6 +659,26 @@ class DataSource extends GemAutoreleaseObject {
     return resultString['result'];
   }
 
+  /// Push all the samples buffered in the given batch, oldest first, and empty the batch.
+  ///
+  /// Use this method instead of [pushData] for high-rate sensors (accelerometer, gyroscope, ...).
+  /// The samples are stored without creating [SenseData] objects and each request is written directly from the stored record.
+  ///
+  /// **Parameters**
+  ///
+  /// * **IN** *batch* The samples to be pushed
+  ///
+  /// **Returns**
+  ///
+  /// * The number of samples accepted by the data source.
+  ///
+  /// **Throws**
+  ///
+  /// * An exception if it fails
+  int pushBatch(final SenseDataBatch batch) {
+    return batch.drainInto(_pointerId);
+  }
+
   /// Register a listener for the data source
   ///
   /// **Parameters**
@@ -744,14 +767,7 @@ class DataSource extends GemAutoreleaseObject {
     );
   }
 
-  void dispose() {
-    GemKitPlatform.instance.callDeleteObject(
-      jsonEncode(<String, Object>{
-        'class': 'DataSourceContainer',
-        'id': _pointerId,
-      }),
-    );
-  }
+  void dispose() => disposeNative('DataSourceContainer', _pointerId);
 }
 
 /// Represents the operations that can be performed on a
@@ -0,0 +1,277 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/content_store.dart';
+import 'package:gem_kit/core.dart';
+
+const int _blockSize = 1024;
+
+/// Local stand-in for an update server publishing new content versions
+class _UpdateServer {
+  late final HttpServer _server;
+  bool _isClosed = false;
+
+  /// Content of the new versions, by item id
+  final Map<int, Uint8List> contents = <int, Uint8List>{};
+
+  /// Blocks served corrupted
+  final Set<int> corruptBlocks = <int>{};
+
+  /// Number of block requests received
+  int blockRequestCount = 0;
+
+  Uri get uri => Uri.parse('http://127.0.0.1:${_server.port}/');
+
+  Future<void> start() async {
+    _server = await HttpServer.bind(InternetAddress.loopbackIPv4, 0);
+    _server.listen(_handle);
+  }
+
+  Future<void> close() async {
+    if (!_isClosed) {
+      _isClosed = true;
+      await _server.close(force: true);
+    }
+  }
+
+  // GET /<item id>/manifest and GET /<item id>/blocks?list=<i>,<j>,...
+  Future<void> _handle(final HttpRequest request) async {
+    final List<String> path = request.uri.pathSegments;
+    final Uint8List? content = contents[int.parse(path[0])];
+    final HttpResponse response = request.response;
+    if (content == null) {
+      response.statusCode = HttpStatus.notFound;
+    } else if (path[1] == 'manifest') {
+      response.add(_manifestOf(content).toBytes());
+    } else {
+      blockRequestCount++;
+      for (final String index
+          in request.uri.queryParameters['list']!.split(',')) {
+        final int i = int.parse(index);
+        final Uint8List block = Uint8List.fromList(
+          content.sublist(
+            i * _blockSize,
+            min((i + 1) * _blockSize, content.length),
+          ),
+        );
+        if (corruptBlocks.contains(i)) {
+          block[0] ^= 0xFF;
+        }
+        response.add(block);
+      }
+    }
+    await response.close();
+  }
+
+  static ContentBlockManifest _manifestOf(final Uint8List content) {
+    final int count = (content.length + _blockSize - 1) ~/ _blockSize;
+    return ContentBlockManifest(
+      blockSize: _blockSize,
+      fileSize: content.length,
+      blockHashes: <int>[
+        for (int i = 0; i < count; i++)
+          ContentBlockManifest.hashBlock(
+            Uint8List.sublistView(
+              content,
+              i * _blockSize,
+              min((i + 1) * _blockSize, content.length),
+            ),
+          ),
+      ],
+    );
+  }
+}
+
+/// [ContentDeltaSource] on top of the [_UpdateServer]
+class _HttpDeltaSource implements ContentDeltaSource {
+  _HttpDeltaSource(this._uri);
+
+  final Uri _uri;
+  final HttpClient _client = HttpClient();
+
+  @override
+  Future<ContentBlockManifest?> getManifest(
+    final int itemId,
+    final Version version,
+  ) async {
+    final (int status, Uint8List body) = await _get('$itemId/manifest');
+    return status == HttpStatus.notFound
+        ? null
+        : ContentBlockManifest.fromBytes(body);
+  }
+
+  @override
+  Future<Uint8List> getBlocks(
+    final int itemId,
+    final Version version,
+    final List<int> blocks,
+  ) async {
+    final (int status, Uint8List body) =
+        await _get('$itemId/blocks?list=${blocks.join(',')}');
+    if (status != HttpStatus.ok) {
+      throw HttpException('Status $status');
+    }
+    return body;
+  }
+
+  void close() => _client.close(force: true);
+
+  Future<(int, Uint8List)> _get(final String path) async {
+    final HttpClientRequest request = await _client.getUrl(_uri.resolve(path));
+    final HttpClientResponse response = await request.close();
+    final BytesBuilder body = BytesBuilder(copy: false);
+    await response.forEach(body.add);
+    return (response.statusCode, body.takeBytes());
+  }
+}
+
+Uint8List _randomBytes(final int length, final int seed) {
+  final Random random = Random(seed);
+  return Uint8List.fromList(
+    List<int>.generate(length, (final int _) => random.nextInt(256)),
+  );
+}
+
+void main() {
+  late Directory directory;
+  late _UpdateServer server;
+  late _HttpDeltaSource source;
+  late String path;
+  late Uint8List old;
+
+  setUp(() async {
+    directory = await Directory.systemTemp.createTemp('content_delta_update');
+    server = _UpdateServer();
+    await server.start();
+    source = _HttpDeltaSource(server.uri);
+    path = '${directory.path}/map.cm';
+    old = _randomBytes(20 * _blockSize, 1);
+    await File(path).writeAsBytes(old);
+  });
+
+  tearDown(() async {
+    source.close();
+    await server.close();
+    await directory.delete(recursive: true);
+  });
+
+  Future<(GemError, ContentDeltaStatistics)> update({
+    final int maxBlocksPerRequest = 64,
+  }) async {
+    final ContentDeltaStatistics statistics = ContentDeltaStatistics();
+    final GemError error = await ContentDeltaUpdater(
+      source,
+      maxBlocksPerRequest: maxBlocksPerRequest,
+    ).updateFile(path, 1, Version(), statistics);
+    return (error, statistics);
+  }
+
+  Uint8List changed(final List<int> blocks) {
+    final Uint8List content = Uint8List.fromList(old);
+    for (final int block in blocks) {
+      content[block * _blockSize + 10] ^= 0x5A;
+    }
+    return content;
+  }
+
+  Future<void> expectNoLeftovers() async {
+    expect(await File('$path.delta').exists(), isFalse);
+    expect(await File('$path.bak').exists(), isFalse);
+  }
+
+  test('downloads only the changed blocks', () async {
+    server.contents[1] = changed(<int>[3, 10]);
+    final (GemError error, ContentDeltaStatistics statistics) = await update();
+
+    expect(error, GemError.success);
+    expect(await File(path).readAsBytes(), server.contents[1]);
+    expect(statistics.changedBlocks, 2);
+    expect(statistics.totalBlocks, 20);
+    expect(statistics.downloadedBytes, 2 * _blockSize);
+    await expectNoLeftovers();
+  });
+
+  test('downloads nothing for an unchanged file', () async {
+    server.contents[1] = old;
+    final (GemError error, ContentDeltaStatistics statistics) = await update();
+
+    expect(error, GemError.success);
+    expect(statistics.changedBlocks, 0);
+    expect(statistics.downloadedBytes, 0);
+    expect(server.blockRequestCount, 0);
+  });
+
+  test('grows and shrinks the file', () async {
+    server.contents[1] = Uint8List.fromList(
+      <int>[...old, ..._randomBytes(1500, 2)],
+    );
+    GemError error;
+    (error, _) = await update();
+    expect(error, GemError.success);
+    expect(await File(path).readAsBytes(), server.contents[1]);
+
+    server.contents[1] = Uint8List.sublistView(old, 0, 5 * _blockSize + 100);
+    (error, _) = await update();
+    expect(error, GemError.success);
+    expect(await File(path).readAsBytes(), server.contents[1]);
+    await expectNoLeftovers();
+  });
+
+  test('requests the blocks in batches', () async {
+    server.contents[1] = changed(<int>[0, 2, 4, 6, 8, 10, 12, 14, 16, 18]);
+    final (GemError error, _) = await update(maxBlocksPerRequest: 4);
+
+    expect(error, GemError.success);
+    expect(server.blockRequestCount, 3);
+    expect(await File(path).readAsBytes(), server.contents[1]);
+  });
+
+  test('keeps the local file when a block is corrupted', () async {
+    server.contents[1] = changed(<int>[3, 10]);
+    server.corruptBlocks.add(10);
+    final (GemError error, _) = await update();
+
+    expect(error, GemError.invalidInput);
+    expect(await File(path).readAsBytes(), old);
+    await expectNoLeftovers();
+  });
+
+  test('reports contents without a delta', () async {
+    final (GemError error, _) = await update();
+
+    expect(error, GemError.notSupported);
+    expect(await File(path).readAsBytes(), old);
+  });
+
+  test('reports an unreachable server', () async {
+    server.contents[1] = changed(<int>[3]);
+    await server.close();
+    final (GemError error, _) = await update();
+
+    expect(error, GemError.networkFailed);
+    expect(await File(path).readAsBytes(), old);
+    await expectNoLeftovers();
+  });
+
+  test('replaces a backup left by a previous update', () async {
+    server.contents[1] = changed(<int>[3]);
+    await File('$path.bak').writeAsBytes(<int>[1, 2, 3]);
+    final (GemError error, _) = await update();
+
+    expect(error, GemError.success);
+    expect(await File(path).readAsBytes(), server.contents[1]);
+    await expectNoLeftovers();
+  });
+}
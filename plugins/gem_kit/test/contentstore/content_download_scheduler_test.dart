@@ -0,0 +1,332 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/content_store.dart';
+import 'package:gem_kit/core.dart';
+
+int _byteAt(final int id, final int offset) => (offset * 31 + id) & 0xFF;
+
+/// Local stand-in for a content server, serving ranges of generated files
+class _ContentServer {
+  late final HttpServer _server;
+
+  /// Size of the served files
+  static const int fileSize = 64 << 10;
+
+  /// Number of requests being served
+  int activeCount = 0;
+
+  /// Highest number of requests served at the same time
+  int maxActiveCount = 0;
+
+  /// Start offsets of the requests, by file id
+  final Map<int, List<int>> requests = <int, List<int>>{};
+
+  /// Number of the next requests of a file closed after half of the data
+  final Map<int, int> failures = <int, int>{};
+
+  Future<void> start() async {
+    _server = await HttpServer.bind(InternetAddress.loopbackIPv4, 0);
+    _server.listen(_handle);
+  }
+
+  Future<void> close() => _server.close(force: true);
+
+  Uri uriOf(final int id) => Uri.parse('http://127.0.0.1:${_server.port}/$id');
+
+  Future<void> _handle(final HttpRequest request) async {
+    final int id = int.parse(request.uri.pathSegments.single);
+    final String? range = request.headers.value(HttpHeaders.rangeHeader);
+    final int start = range == null
+        ? 0
+        : int.parse(range.substring('bytes='.length, range.indexOf('-')));
+    requests.putIfAbsent(id, () => <int>[]).add(start);
+    final bool fail = (failures[id] ?? 0) > 0;
+    if (fail) {
+      failures[id] = failures[id]! - 1;
+    }
+
+    activeCount++;
+    maxActiveCount = max(maxActiveCount, activeCount);
+    bool isActive = true;
+    final HttpResponse response = request.response;
+    try {
+      response.statusCode =
+          start == 0 ? HttpStatus.ok : HttpStatus.partialContent;
+      // Sent in pieces, so that the downloads overlap
+      const int piece = 4096;
+      for (int offset = start; offset < fileSize; offset += piece) {
+        // A failed request ends early, the client gets less data than expected
+        if (fail && offset - start >= (fileSize - start) ~/ 2) {
+          break;
+        }
+        final int end = min(offset + piece, fileSize);
+        response.add(<int>[
+          for (int i = offset; i < end; i++) _byteAt(id, i),
+        ]);
+        await response.flush();
+        await Future<void>.delayed(const Duration(milliseconds: 5));
+      }
+      // The chunked reply only ends with the close, so the client cannot
+      // start another request before this one is counted out
+      activeCount--;
+      isActive = false;
+      await response.close();
+    } on Exception {
+      // The client paused the download
+    } finally {
+      if (isActive) {
+        activeCount--;
+      }
+    }
+  }
+}
+
+/// Download target fetching a file of the [_ContentServer] with range requests
+class _HttpTarget implements ContentDownloadTarget {
+  _HttpTarget(this.id, this._client, this._uri);
+
+  @override
+  final int id;
+
+  final HttpClient _client;
+  final Uri _uri;
+  final BytesBuilder data = BytesBuilder();
+  HttpClientRequest? _request;
+  int _run = 0;
+
+  @override
+  int get totalSize => _ContentServer.fileSize;
+
+  @override
+  int get downloadedSize => data.length;
+
+  @override
+  bool get isCompleted => data.length == totalSize;
+
+  @override
+  void start({
+    required final void Function(GemError error) onComplete,
+    required final void Function(int progress) onProgress,
+    required final bool allowChargedNetworks,
+    required final ContentDownloadThreadPriority priority,
+  }) {
+    final int run = ++_run;
+    () async {
+      try {
+        final HttpClientRequest request = await _client.getUrl(_uri);
+        _request = request;
+        if (data.length > 0) {
+          request.headers
+              .set(HttpHeaders.rangeHeader, 'bytes=${data.length}-');
+        }
+        final HttpClientResponse response = await request.close();
+        await for (final List<int> bytes in response) {
+          if (run != _run) {
+            return;
+          }
+          data.add(bytes);
+          onProgress(data.length * 100 ~/ totalSize);
+        }
+        if (run == _run) {
+          onComplete(isCompleted ? GemError.success : GemError.networkFailed);
+        }
+      } on IOException {
+        if (run == _run) {
+          onComplete(GemError.networkFailed);
+        }
+      }
+    }();
+  }
+
+  @override
+  GemError pause() {
+    _run++;
+    _request?.abort();
+    return GemError.success;
+  }
+
+  @override
+  GemError cancel() {
+    pause();
+    data.clear();
+    return GemError.success;
+  }
+
+  bool get hasExpectedContent {
+    final Uint8List bytes = data.toBytes();
+    for (int i = 0; i < bytes.length; i++) {
+      if (bytes[i] != _byteAt(id, i)) {
+        return false;
+      }
+    }
+    return bytes.length == totalSize;
+  }
+}
+
+void main() {
+  late _ContentServer server;
+  late HttpClient client;
+
+  setUp(() async {
+    server = _ContentServer();
+    await server.start();
+    client = HttpClient();
+  });
+
+  tearDown(() async {
+    client.close(force: true);
+    await server.close();
+  });
+
+  _HttpTarget target(final int id) =>
+      _HttpTarget(id, client, server.uriOf(id));
+
+  Future<GemError> enqueue(
+    final ContentDownloadScheduler scheduler,
+    final ContentDownloadTarget target, {
+    final ContentDownloadPriority priority = ContentDownloadPriority.normal,
+    final void Function(ContentDownloadStatistics statistics)?
+        onStatisticsUpdated,
+  }) {
+    final Completer<GemError> completer = Completer<GemError>();
+    scheduler.enqueue(
+      target,
+      priority: priority,
+      onComplete: completer.complete,
+      onStatisticsUpdated: onStatisticsUpdated,
+    );
+    return completer.future;
+  }
+
+  test('limits the parallel downloads', () async {
+    final ContentDownloadScheduler scheduler =
+        ContentDownloadScheduler(maxParallelDownloads: 2);
+    final List<_HttpTarget> targets = <_HttpTarget>[
+      for (int id = 1; id <= 5; id++) target(id),
+    ];
+    final List<Future<GemError>> results = <Future<GemError>>[
+      for (final _HttpTarget t in targets) enqueue(scheduler, t),
+    ];
+    expect(scheduler.activeCount, 2);
+    expect(scheduler.queuedCount, 3);
+
+    expect(await Future.wait(results), everyElement(GemError.success));
+    expect(server.maxActiveCount, 2);
+    expect(scheduler.activeCount, 0);
+    expect(
+      targets.every((final _HttpTarget t) => t.hasExpectedContent),
+      isTrue,
+    );
+  });
+
+  test('starts the downloads in priority order', () async {
+    final ContentDownloadScheduler scheduler =
+        ContentDownloadScheduler(maxParallelDownloads: 1);
+    final List<int> completed = <int>[];
+    Future<void> add(final int id, final ContentDownloadPriority priority) =>
+        enqueue(scheduler, target(id), priority: priority)
+            .then((final GemError _) => completed.add(id));
+
+    await Future.wait(<Future<void>>[
+      add(1, ContentDownloadPriority.normal),
+      add(2, ContentDownloadPriority.low),
+      add(3, ContentDownloadPriority.high),
+      add(4, ContentDownloadPriority.normal),
+    ]);
+    expect(completed, <int>[1, 3, 4, 2]);
+  });
+
+  test('resumes after a network error', () async {
+    final ContentDownloadScheduler scheduler = ContentDownloadScheduler(
+      retryDelay: const Duration(milliseconds: 10),
+    );
+    final _HttpTarget download = target(1);
+    server.failures[1] = 1;
+
+    expect(await enqueue(scheduler, download), GemError.success);
+    expect(download.hasExpectedContent, isTrue);
+    expect(server.requests[1], hasLength(2));
+    expect(server.requests[1]![0], 0);
+    expect(server.requests[1]![1], greaterThan(0));
+  });
+
+  test('fails after the maximum number of retries', () async {
+    final ContentDownloadScheduler scheduler = ContentDownloadScheduler(
+      maxRetries: 2,
+      retryDelay: const Duration(milliseconds: 10),
+    );
+    server.failures[1] = 1000;
+    ContentDownloadStatistics? last;
+
+    expect(
+      await enqueue(
+        scheduler,
+        target(1),
+        onStatisticsUpdated: (final ContentDownloadStatistics s) => last = s,
+      ),
+      GemError.networkFailed,
+    );
+    expect(server.requests[1], hasLength(3));
+    expect(last!.retryCount, 2);
+    expect(last!.lastError, GemError.networkFailed);
+  });
+
+  test('resumes paused downloads from their data', () async {
+    final ContentDownloadScheduler scheduler = ContentDownloadScheduler();
+    final _HttpTarget download = target(1);
+    final Completer<void> halfway = Completer<void>();
+    final Future<GemError> result = enqueue(
+      scheduler,
+      download,
+      onStatisticsUpdated: (final ContentDownloadStatistics statistics) {
+        if (!halfway.isCompleted &&
+            statistics.downloadedSize >= _ContentServer.fileSize ~/ 2) {
+          halfway.complete();
+        }
+      },
+    );
+
+    await halfway.future;
+    scheduler.pause();
+    expect(scheduler.activeCount, 0);
+    expect(scheduler.queuedCount, 1);
+    final int pausedSize = download.downloadedSize;
+
+    scheduler.resume();
+    expect(await result, GemError.success);
+    expect(download.hasExpectedContent, isTrue);
+    expect(server.requests[1]!.last, pausedSize);
+    expect(scheduler.statisticsOf(1), isNull);
+  });
+
+  test('deletes the data of removed downloads', () async {
+    final ContentDownloadScheduler scheduler =
+        ContentDownloadScheduler(maxParallelDownloads: 1);
+    final _HttpTarget first = target(1);
+    final _HttpTarget second = target(2);
+    final Future<GemError> firstResult = enqueue(scheduler, first);
+    bool secondCompleted = false;
+    enqueue(scheduler, second)
+        .then((final GemError _) => secondCompleted = true);
+
+    expect(scheduler.remove(2, deleteData: true), isTrue);
+    expect(await firstResult, GemError.success);
+    expect(secondCompleted, isFalse);
+    expect(second.downloadedSize, 0);
+    expect(server.requests.containsKey(2), isFalse);
+  });
+}
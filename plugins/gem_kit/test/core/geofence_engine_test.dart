@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/core.dart';
+
+final DateTime _start = DateTime.utc(2025);
+
+DateTime _at(final int milliseconds) =>
+    _start.add(Duration(milliseconds: milliseconds));
+
+List<GeofenceEventType> _types(final GeofenceEvaluation evaluation) =>
+    evaluation.events.map((final GeofenceEvent event) => event.type).toList();
+
+GeofenceEngine _engine({
+  final Duration enterDelay = Duration.zero,
+  final Duration exitDelay = const Duration(seconds: 10),
+  final Duration dwellTime = Duration.zero,
+  final int maxEventsPerSecond = 0,
+}) =>
+    GeofenceEngine(
+      enterDelay: enterDelay,
+      exitDelay: exitDelay,
+      dwellTime: dwellTime,
+      maxEventsPerSecond: maxEventsPerSecond,
+    )..addCircles(<String>['a'], Float64List.fromList(<double>[45, 25, 100]));
+
+void main() {
+  group('hysteresis', () {
+    test('reports the enter event after the enter delay', () {
+      final GeofenceEngine engine =
+          _engine(enterDelay: const Duration(seconds: 5));
+      expect(engine.evaluate(45, 25, time: _at(0)).events, isEmpty);
+      expect(engine.insideIds, isEmpty);
+      expect(engine.evaluate(45, 25, time: _at(4999)).events, isEmpty);
+      expect(
+        _types(engine.evaluate(45, 25, time: _at(5000))),
+        <GeofenceEventType>[GeofenceEventType.enter],
+      );
+      expect(engine.insideIds, <String>['a']);
+    });
+
+    test('restarts the enter delay when the position leaves', () {
+      final GeofenceEngine engine =
+          _engine(enterDelay: const Duration(seconds: 5));
+      engine.evaluate(45, 25, time: _at(0));
+      expect(engine.evaluate(45.01, 25, time: _at(2000)).events, isEmpty);
+      expect(engine.evaluate(45, 25, time: _at(6000)).events, isEmpty);
+      expect(engine.evaluate(45, 25, time: _at(10999)).events, isEmpty);
+      expect(
+        _types(engine.evaluate(45, 25, time: _at(11000))),
+        <GeofenceEventType>[GeofenceEventType.enter],
+      );
+    });
+
+    test('reports the exit event after the exit delay', () {
+      final GeofenceEngine engine = _engine();
+      expect(
+        _types(engine.evaluate(45, 25, time: _at(0))),
+        <GeofenceEventType>[GeofenceEventType.enter],
+      );
+      expect(engine.evaluate(45.01, 25, time: _at(1000)).events, isEmpty);
+      expect(engine.insideIds, <String>['a']);
+      expect(engine.evaluate(45.01, 25, time: _at(10999)).events, isEmpty);
+      expect(
+        _types(engine.evaluate(45.01, 25, time: _at(11000))),
+        <GeofenceEventType>[GeofenceEventType.exit],
+      );
+      expect(engine.insideIds, isEmpty);
+    });
+
+    test('cancels the pending exit when the position comes back', () {
+      final GeofenceEngine engine = _engine();
+      engine.evaluate(45, 25, time: _at(0));
+      engine.evaluate(45.01, 25, time: _at(1000));
+      expect(engine.evaluate(45, 25, time: _at(5000)).events, isEmpty);
+      expect(engine.evaluate(45.01, 25, time: _at(6000)).events, isEmpty);
+      expect(engine.evaluate(45.01, 25, time: _at(15000)).events, isEmpty);
+      expect(
+        _types(engine.evaluate(45.01, 25, time: _at(16000))),
+        <GeofenceEventType>[GeofenceEventType.exit],
+      );
+    });
+
+    test('reports the dwell event once', () {
+      final GeofenceEngine engine =
+          _engine(dwellTime: const Duration(seconds: 30));
+      engine.evaluate(45, 25, time: _at(0));
+      expect(engine.evaluate(45, 25, time: _at(29999)).events, isEmpty);
+      expect(
+        _types(engine.evaluate(45, 25, time: _at(30000))),
+        <GeofenceEventType>[GeofenceEventType.dwell],
+      );
+      expect(engine.evaluate(45, 25, time: _at(60000)).events, isEmpty);
+    });
+
+    test('does not report an exit for removed geofences', () {
+      final GeofenceEngine engine = _engine();
+      engine.evaluate(45, 25, time: _at(0));
+      engine.remove(<String>['a']);
+      expect(engine.evaluate(45.01, 25, time: _at(1000)).events, isEmpty);
+      expect(engine.evaluate(45.01, 25, time: _at(20000)).events, isEmpty);
+      expect(engine.insideIds, isEmpty);
+    });
+  });
+
+  group('rate limit', () {
+    test('defers the events above the limit', () {
+      final List<GeofenceEvent> delivered = <GeofenceEvent>[];
+      final GeofenceEngine engine = GeofenceEngine(
+        maxEventsPerSecond: 2,
+        onEvents: delivered.addAll,
+      )..addCircles(
+          <String>['a', 'b', 'c', 'd', 'e'],
+          Float64List.fromList(<double>[
+            for (int i = 0; i < 5; i++) ...<double>[45, 25, 100],
+          ]),
+        );
+
+      GeofenceEvaluation evaluation = engine.evaluate(45, 25, time: _at(0));
+      expect(evaluation.events, hasLength(2));
+      expect(evaluation.deferredEventCount, 3);
+
+      // Half a second refills one token
+      evaluation = engine.evaluate(45, 25, time: _at(500));
+      expect(evaluation.events, hasLength(1));
+      expect(evaluation.deferredEventCount, 2);
+
+      // The tokens are capped to one second of events
+      evaluation = engine.evaluate(45, 25, time: _at(5000));
+      expect(evaluation.events, hasLength(2));
+      expect(evaluation.deferredEventCount, 0);
+
+      expect(
+        delivered.map((final GeofenceEvent event) => event.id).toSet(),
+        <String>{'a', 'b', 'c', 'd', 'e'},
+      );
+      expect(
+        delivered.every(
+          (final GeofenceEvent event) =>
+              event.type == GeofenceEventType.enter,
+        ),
+        isTrue,
+      );
+    });
+
+    test('delivers all the events without a limit', () {
+      final GeofenceEngine engine = GeofenceEngine()
+        ..addCircles(
+          <String>['a', 'b', 'c'],
+          Float64List.fromList(<double>[
+            for (int i = 0; i < 3; i++) ...<double>[45, 25, 100],
+          ]),
+        );
+      final GeofenceEvaluation evaluation =
+          engine.evaluate(45, 25, time: _at(0));
+      expect(evaluation.events, hasLength(3));
+      expect(evaluation.deferredEventCount, 0);
+    });
+  });
+
+  group('geometry', () {
+    test('contains circles across the antimeridian', () {
+      final GeofenceEngine engine = GeofenceEngine()
+        ..addCircles(
+          <String>['east', 'west'],
+          Float64List.fromList(<double>[0, 179.999, 500, 0, -179.999, 500]),
+        );
+
+      GeofenceEvaluation evaluation =
+          engine.evaluate(0, -179.9995, time: _at(0));
+      expect(evaluation.insideCount, 2);
+      expect(engine.insideIds, unorderedEquals(<String>['east', 'west']));
+
+      evaluation = engine.evaluate(0, 179.9995, time: _at(1000));
+      expect(evaluation.insideCount, 2);
+
+      evaluation = engine.evaluate(0, 179.996, time: _at(2000));
+      expect(evaluation.insideCount, 1);
+    });
+
+    test('registers polygons from packed vertices', () {
+      final GeofenceEngine engine = GeofenceEngine()
+        ..addPolygons(
+          <String>['p1', 'p2'],
+          Int32List.fromList(<int>[0, 4, 8]),
+          Float64List.fromList(<double>[
+            45, 25, 45, 25.01, 45.01, 25.01, 45.01, 25, //
+            46, 25, 46, 25.01, 46.01, 25.01, 46.01, 25,
+          ]),
+        );
+      expect(engine.length, 2);
+      expect(engine.evaluate(45.005, 25.005, time: _at(0)).insideCount, 1);
+      expect(engine.insideIds, <String>['p1']);
+      expect(engine.evaluate(46.005, 25.005, time: _at(1000)).insideCount, 1);
+      expect(engine.evaluate(47, 25.005, time: _at(2000)).insideCount, 0);
+    });
+  });
+}
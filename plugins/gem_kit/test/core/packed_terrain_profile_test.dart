@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/src/core/packed_terrain_profile.dart';
+
+const String _failed = '{"result":null,"gemApiError":-1}';
+
+void main() {
+  test('decodes the replies', () {
+    final PackedTerrainProfile profile = PackedTerrainProfile.decode(
+      PackedTerrainProfileReplies(
+        startDistance: 100,
+        samples: '{"result":{"floatlist":[10,12.5,11],"sample":50}}',
+        minElevation: '{"result":10}',
+        maxElevation: '{"result":12.5}',
+        totalUp: '{"result":2.5}',
+        totalDown: '{"result":1.5}',
+        climbSections: '{"result":[{"startDistanceM":0,"endDistanceM":50,'
+            '"grade":2,"slope":5.0}]}',
+        surfaceSections: '{"result":[{"startDistanceM":0,"type":1}]}',
+        roadTypeSections: '{"result":[{"startDistanceM":0,"type":3}]}',
+        steepSections: '{"result":[{"startDistanceM":20,"categ":4}]}',
+      ),
+    );
+
+    expect(profile.elevations, <double>[10, 12.5, 11]);
+    expect(profile.sampleDistance, 50);
+    expect(profile.distanceAt(2), 200);
+    expect(profile.maxElevation, 12.5);
+    expect(profile.totalDown, 1.5);
+    expect(profile.climbSections.endDistanceAt(0), 50);
+    expect(profile.surfaceSections.values, <int>[1]);
+    expect(profile.roadTypeSections.values, <int>[3]);
+    expect(profile.steepSections.startDistances, <int>[20]);
+  });
+
+  test('decodes failed replies as an empty profile', () {
+    final PackedTerrainProfile profile = PackedTerrainProfile.decode(
+      PackedTerrainProfileReplies(
+        startDistance: 0,
+        samples: _failed,
+        minElevation: _failed,
+        maxElevation: _failed,
+        totalUp: _failed,
+        totalDown: _failed,
+        climbSections: _failed,
+        surfaceSections: _failed,
+        roadTypeSections: _failed,
+        steepSections: _failed,
+      ),
+    );
+
+    expect(profile.elevations, isEmpty);
+    expect(profile.sampleDistance, 0);
+    expect(profile.minElevation, 0);
+    expect(profile.climbSections.length, 0);
+    expect(profile.surfaceSections.length, 0);
+    expect(profile.roadTypeSections.length, 0);
+    expect(profile.steepSections.length, 0);
+  });
+}
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/core.dart';
+
+PolygonGeographicArea _polygon(final List<double> latLons) =>
+    PolygonGeographicArea(
+      coordinates: <Coordinates>[
+        for (int i = 0; i < latLons.length; i += 2)
+          Coordinates(latitude: latLons[i], longitude: latLons[i + 1]),
+      ],
+    );
+
+final PolygonGeographicArea _square =
+    _polygon(<double>[0, 0, 0, 10, 10, 10, 10, 0]);
+
+// Star with 8 branches around (45, 25)
+final PolygonGeographicArea _star = _polygon(<double>[
+  for (int i = 0; i < 16; i++) ...<double>[
+    45 + (i.isEven ? 1.0 : 0.3) * sin(i * pi / 8),
+    25 + (i.isEven ? 1.0 : 0.3) * cos(i * pi / 8),
+  ],
+]);
+
+// Square with a square hole, as a single ring joined by a bridge along
+// longitude 5
+final PolygonGeographicArea _withHole = _polygon(<double>[
+  0, 0, 0, 5, 3, 5, 3, 3, 7, 3, 7, 7, 3, 7, 3, 5, 0, 5, //
+  0, 10, 10, 10, 10, 0,
+]);
+
+// Rectangle with 65 vertices along its top edge
+final PolygonGeographicArea _dense = _polygon(<double>[
+  0, 0,
+  for (int i = 0; i <= 64; i++) ...<double>[4, i / 8],
+  0, 8,
+]);
+
+Iterable<Coordinates> _vertexAndEdgePoints(
+  final PolygonGeographicArea polygon,
+) sync* {
+  final List<Coordinates> coords = polygon.coordinates;
+  for (int i = 0; i < coords.length; i++) {
+    final Coordinates a = coords[i];
+    final Coordinates b = coords[(i + 1) % coords.length];
+    yield a;
+    for (final double t in <double>[0.25, 0.5, 0.75]) {
+      yield Coordinates(
+        latitude: a.latitude + (b.latitude - a.latitude) * t,
+        longitude: a.longitude + (b.longitude - a.longitude) * t,
+      );
+    }
+    // Points on the horizontal and vertical lines through the vertex
+    for (final double d in <double>[-1, -0.5, 0.5, 1]) {
+      yield Coordinates(latitude: a.latitude, longitude: a.longitude + d);
+      yield Coordinates(latitude: a.latitude + d, longitude: a.longitude);
+    }
+  }
+}
+
+Iterable<Coordinates> _randomPoints(
+  final PolygonGeographicArea polygon,
+  final int count,
+) sync* {
+  final RectangleGeographicArea box = polygon.boundingBox;
+  final double minLatitude = box.bottomRight.latitude;
+  final double minLongitude = box.topLeft.longitude;
+  final double height = box.topLeft.latitude - minLatitude;
+  final double width = box.bottomRight.longitude - minLongitude;
+  final Random random = Random(42);
+  for (int i = 0; i < count; i++) {
+    // Also cover the points around the bounding box
+    yield Coordinates(
+      latitude: minLatitude + height * (random.nextDouble() * 1.2 - 0.1),
+      longitude: minLongitude + width * (random.nextDouble() * 1.2 - 0.1),
+    );
+  }
+}
+
+void _expectSameResults(
+  final PolygonGeographicArea polygon,
+  final Iterable<Coordinates> points, {
+  final int? gridSize,
+}) {
+  final PreparedPolygonGeographicArea prepared =
+      PreparedPolygonGeographicArea(polygon, gridSize: gridSize);
+  for (final Coordinates point in points) {
+    expect(
+      prepared.containsCoordinates(point),
+      polygon.containsCoordinates(point),
+      reason: '$point',
+    );
+  }
+}
+
+void main() {
+  final Map<String, PolygonGeographicArea> polygons =
+      <String, PolygonGeographicArea>{
+    'convex': _square,
+    'concave': _star,
+    'with a hole': _withHole,
+    'with many vertices': _dense,
+  };
+
+  group('matches the unprepared polygon', () {
+    polygons.forEach((final String name, final PolygonGeographicArea polygon) {
+      test('for random points, $name', () {
+        _expectSameResults(polygon, _randomPoints(polygon, 5000));
+        _expectSameResults(polygon, _randomPoints(polygon, 1000), gridSize: 1);
+        _expectSameResults(polygon, _randomPoints(polygon, 1000), gridSize: 3);
+      });
+
+      test('for vertices and edges, $name', () {
+        _expectSameResults(polygon, _vertexAndEdgePoints(polygon));
+        _expectSameResults(polygon, _vertexAndEdgePoints(polygon), gridSize: 7);
+      });
+    });
+
+    test('for grid lines', () {
+      // With 10 rows and columns the cell borders fall on whole degrees
+      final List<Coordinates> points = <Coordinates>[
+        for (int lat = -1; lat <= 11; lat++)
+          for (int lon = -1; lon <= 11; lon++)
+            Coordinates(latitude: lat.toDouble(), longitude: lon.toDouble()),
+      ];
+      _expectSameResults(_square, points, gridSize: 10);
+      _expectSameResults(_withHole, points, gridSize: 10);
+    });
+  });
+
+  test('excludes the hole', () {
+    final PreparedPolygonGeographicArea prepared =
+        PreparedPolygonGeographicArea(_withHole);
+    expect(prepared.contains(1, 1), isTrue);
+    expect(prepared.contains(5, 6), isFalse);
+    expect(prepared.contains(8, 8), isTrue);
+    expect(prepared.contains(11, 5), isFalse);
+  });
+
+  test('prepares packed geometries as polygons', () {
+    final List<Coordinates> coords = _star.coordinates;
+    final PreparedPolygonGeographicArea packed =
+        PreparedPolygonGeographicArea.fromPackedGeometry(
+      PackedGeometry(
+        Float64List.fromList(<double>[
+          for (final Coordinates c in coords) ...<double>[
+            c.latitude,
+            c.longitude,
+          ],
+        ]),
+      ),
+    );
+    expect(packed.vertexCount, coords.length);
+    for (final Coordinates point in _randomPoints(_star, 1000)) {
+      expect(
+        packed.containsCoordinates(point),
+        _star.containsCoordinates(point),
+      );
+    }
+  });
+
+  test('tests batches of points', () {
+    final PreparedPolygonGeographicArea prepared =
+        PreparedPolygonGeographicArea(_withHole);
+    final List<Coordinates> points = _randomPoints(_withHole, 500).toList();
+    final Uint8List result = prepared.containsAll(
+      Float64List.fromList(<double>[
+        for (final Coordinates c in points) ...<double>[
+          c.latitude,
+          c.longitude,
+        ],
+      ]),
+    );
+    for (int i = 0; i < points.length; i++) {
+      expect(result[i] == 1, _withHole.containsCoordinates(points[i]));
+    }
+  });
+
+  test('contains nothing with less than three vertices', () {
+    final PreparedPolygonGeographicArea prepared =
+        PreparedPolygonGeographicArea(_polygon(<double>[0, 0, 1, 1]));
+    expect(prepared.contains(0, 0), isFalse);
+    expect(prepared.contains(0.5, 0.5), isFalse);
+  });
+
+  test('handles flat polygons', () {
+    final PolygonGeographicArea flat = _polygon(<double>[1, 0, 1, 5, 1, 10]);
+    _expectSameResults(flat, _vertexAndEdgePoints(flat));
+  });
+}
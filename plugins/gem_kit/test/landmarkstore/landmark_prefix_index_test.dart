@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/landmark_store.dart';
+
+List<int> _ids(final List<LandmarkPrefixMatch> matches) => matches
+    .map((final LandmarkPrefixMatch match) => match.landmarkId)
+    .toList();
+
+void main() {
+  group('normalize', () {
+    test('removes Latin diacritics and lower cases', () {
+      expect(LandmarkPrefixIndex.normalize('Café Crème'), 'cafe creme');
+      expect(LandmarkPrefixIndex.normalize('Ñandú'), 'nandu');
+      expect(LandmarkPrefixIndex.normalize('Łódź'), 'łodz');
+    });
+
+    test('removes Arabic vowel marks and tatweel', () {
+      expect(LandmarkPrefixIndex.normalize('مَدْرَسَة'), 'مدرسه');
+      expect(LandmarkPrefixIndex.normalize('مــكة'), 'مكه');
+    });
+
+    test('folds Arabic letter variants', () {
+      expect(LandmarkPrefixIndex.normalize('أحمد'), 'احمد');
+      expect(LandmarkPrefixIndex.normalize('إسلام'), 'اسلام');
+      expect(LandmarkPrefixIndex.normalize('آمنة'), 'امنه');
+      expect(LandmarkPrefixIndex.normalize('مستشفى'), 'مستشفي');
+      expect(LandmarkPrefixIndex.normalize('مؤسسة'), 'موسسه');
+      expect(LandmarkPrefixIndex.normalize('ماء'), 'ما');
+    });
+
+    test('maps Arabic-Indic digits to ASCII digits', () {
+      expect(LandmarkPrefixIndex.normalize('شارع ١٢٣'), 'شارع 123');
+      expect(LandmarkPrefixIndex.normalize('۴۵'), '45');
+    });
+
+    test('replaces separators with spaces', () {
+      expect(LandmarkPrefixIndex.normalize('مكتبة-النور'), 'مكتبه النور');
+      expect(LandmarkPrefixIndex.normalize("St. Mary's"), 'st  mary s');
+    });
+  });
+
+  group('search', () {
+    late LandmarkPrefixIndex index;
+
+    setUp(() {
+      index = LandmarkPrefixIndex.detached(<int, String>{
+        1: 'Café Central',
+        2: 'مكتبة النور',
+        3: 'Central Park',
+        4: 'Park Hotel',
+        5: 'المدرسة الأهلية',
+      });
+    });
+
+    test('matches word prefixes', () {
+      expect(_ids(index.search('cent')), unorderedEquals(<int>[1, 3]));
+      expect(_ids(index.search('central park')), <int>[3]);
+      expect(index.search('cafe park'), isEmpty);
+    });
+
+    test('ignores diacritics and case in queries and names', () {
+      expect(_ids(index.search('CAFÉ')), <int>[1]);
+      expect(_ids(index.search('cafe')), <int>[1]);
+      expect(_ids(index.search('مَكتبة')), <int>[2]);
+    });
+
+    test('folds Arabic letter variants', () {
+      expect(_ids(index.search('مكتبه')), <int>[2]);
+      expect(_ids(index.search('الاهلية')), <int>[5]);
+    });
+
+    test('matches names without their definite article', () {
+      expect(_ids(index.search('نور')), <int>[2]);
+      expect(_ids(index.search('مدرسة')), <int>[5]);
+    });
+
+    test('allows one edit per word by default', () {
+      final List<LandmarkPrefixMatch> matches = index.search('cantral');
+      expect(_ids(matches), unorderedEquals(<int>[1, 3]));
+      expect(matches.every((final LandmarkPrefixMatch m) => m.edits == 1),
+          isTrue);
+
+      // Missing letter
+      expect(_ids(index.search('centrl')), unorderedEquals(<int>[1, 3]));
+    });
+
+    test('respects the edit threshold', () {
+      // A transposition is two edits
+      expect(index.search('centarl'), isEmpty);
+      expect(
+        _ids(index.search('centarl', maxEdits: 2)),
+        unorderedEquals(<int>[1, 3]),
+      );
+      expect(index.search('cantral', maxEdits: 0), isEmpty);
+    });
+
+    test('requires short words to match exactly', () {
+      expect(_ids(index.search('pa')), unorderedEquals(<int>[3, 4]));
+      expect(index.search('pz'), isEmpty);
+    });
+
+    test('sums the edits of the words', () {
+      final List<LandmarkPrefixMatch> matches = index.search('cantral parc');
+      expect(_ids(matches), <int>[3]);
+      expect(matches.single.edits, 2);
+    });
+
+    test('ranks exact matches before fuzzy ones', () {
+      final LandmarkPrefixIndex ranked = LandmarkPrefixIndex.detached(
+        <int, String>{10: 'Bark', 11: 'Park'},
+      );
+      final List<LandmarkPrefixMatch> matches = ranked.search('park');
+      expect(_ids(matches), <int>[11, 10]);
+      expect(matches[0].edits, 0);
+      expect(matches[1].edits, 1);
+    });
+
+    test('applies the limit', () {
+      expect(index.search('cent', limit: 1), hasLength(1));
+      expect(index.search('cent', limit: 0), isEmpty);
+    });
+
+    test('forgets removed landmarks', () {
+      index.onLandmarkRemoved(1);
+      expect(_ids(index.search('cent')), <int>[3]);
+      expect(index.length, 4);
+    });
+  });
+}
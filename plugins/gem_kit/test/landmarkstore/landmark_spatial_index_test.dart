@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/core.dart';
+import 'package:gem_kit/landmark_store.dart';
+
+Coordinates _at(final double latitude, final double longitude) =>
+    Coordinates(latitude: latitude, longitude: longitude);
+
+void main() {
+  group('withinRadius', () {
+    late LandmarkSpatialIndex index;
+
+    setUp(() {
+      index = LandmarkSpatialIndex.detached(<int, Coordinates>{
+        1: _at(0, 179.995),
+        2: _at(0, -179.995),
+        3: _at(0, 179.99),
+        4: _at(0, 0),
+        5: _at(89.999, 0),
+        6: _at(89.999, 180),
+        7: _at(89.999, 90),
+      });
+    });
+
+    test('sorts the landmarks by distance', () {
+      final LandmarkSpatialResults results =
+          index.withinRadius(_at(0, 179.991), 2000);
+      expect(results.ids, <int>[3, 1, 2]);
+      expect(results.distances[0], lessThan(results.distances[1]));
+    });
+
+    test('includes landmarks across the antimeridian', () {
+      expect(index.withinRadius(_at(0, 179.999), 2000).ids, <int>[1, 2, 3]);
+      expect(index.withinRadius(_at(0, -179.999), 2000).ids, <int>[2, 1, 3]);
+      expect(index.countWithinRadius(_at(0, -179.999), 700), 2);
+    });
+
+    test('includes landmarks across a pole', () {
+      final LandmarkSpatialResults results =
+          index.withinRadius(_at(89.999, 0), 500);
+      expect(results.ids, unorderedEquals(<int>[5, 6, 7]));
+      expect(results.ids.first, 5);
+    });
+
+    test('pages the results', () {
+      final LandmarkSpatialResults page =
+          index.withinRadius(_at(0, 179.999), 2000, offset: 1, limit: 1);
+      expect(page.ids, <int>[2]);
+      expect(page.totalCount, 3);
+    });
+  });
+
+  group('nearest', () {
+    test('finds landmarks across the antimeridian', () {
+      final LandmarkSpatialIndex index =
+          LandmarkSpatialIndex.detached(<int, Coordinates>{
+        1: _at(0, -179.999),
+        2: _at(0, 179.99),
+      });
+      expect(index.nearest(_at(0, 179.999), 1).ids, <int>[1]);
+      expect(index.nearest(_at(0, 179.999), 2).ids, <int>[1, 2]);
+    });
+
+    test('returns each landmark once when the rings wrap around', () {
+      // One landmark in each cell of a 12 x 6 grid
+      final Map<int, Coordinates> positions = <int, Coordinates>{};
+      for (int row = 0; row < 6; row++) {
+        for (int col = 0; col < 12; col++) {
+          positions[row * 12 + col] =
+              _at(-75.0 + row * 30, -165.0 + col * 30);
+        }
+      }
+      final LandmarkSpatialIndex index =
+          LandmarkSpatialIndex.detached(positions, cellSize: 30);
+
+      final LandmarkSpatialResults results = index.nearest(_at(0, 0), 100);
+      expect(results.length, positions.length);
+      expect(results.ids.toSet(), hasLength(positions.length));
+      for (int i = 1; i < results.length; i++) {
+        expect(
+          results.distances[i],
+          greaterThanOrEqualTo(results.distances[i - 1]),
+        );
+      }
+    });
+
+    test('applies the maximum distance and the category', () {
+      final LandmarkSpatialIndex index = LandmarkSpatialIndex.detached(
+        <int, Coordinates>{1: _at(45, 25), 2: _at(45.01, 25)},
+        categoryId: 7,
+      );
+      expect(index.nearest(_at(45, 25), 5, maxDistance: 500).ids, <int>[1]);
+      expect(index.nearest(_at(45, 25), 5, categoryId: 7).length, 2);
+      expect(index.nearest(_at(45, 25), 5, categoryId: 8).length, 0);
+    });
+  });
+
+  group('inArea', () {
+    test('includes landmarks across the antimeridian', () {
+      final LandmarkSpatialIndex index =
+          LandmarkSpatialIndex.detached(<int, Coordinates>{
+        1: _at(0, 179.5),
+        2: _at(0, -179.5),
+        3: _at(0, 0),
+        4: _at(5, 179.5),
+      });
+      final RectangleGeographicArea area = RectangleGeographicArea(
+        topLeft: _at(1, 179),
+        bottomRight: _at(-1, -179),
+      );
+      expect(index.inArea(area).ids, unorderedEquals(<int>[1, 2]));
+      expect(index.countInArea(area), 2);
+    });
+  });
+
+  test('follows the removed landmarks', () {
+    final LandmarkSpatialIndex index =
+        LandmarkSpatialIndex.detached(<int, Coordinates>{
+      1: _at(0, 179.999),
+      2: _at(0, -179.999),
+    });
+    index.onLandmarkRemoved(2);
+    expect(index.withinRadius(_at(0, 179.999), 1000).ids, <int>[1]);
+    expect(index.length, 1);
+  });
+}
@@ -0,0 +1,256 @@
+// SPDX-FileCopyrightText: 1995-2025 Magic Lane Intellectual Property B.V. <info@magiclane.com>
+// SPDX-License-Identifier: LicenseRef-MagicLane-Proprietary
+//
+// Magic Lane Intellectual Property B.V, its affiliates and licensors retain all
+// intellectual property and proprietary rights in and to this material, related
+// documentation and any modifications thereto. Any use, reproduction,
+// disclosure or distribution of this material and related documentation
+// without an express license agreement from Magic Lane Intellectual Property B.V.
+// or its affiliates is strictly prohibited.
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:crypto/crypto.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:gem_kit/src/core/gem_error.dart';
+import 'package:gem_kit/src/sense/log_chunk_uploader.dart';
+
+/// Local stand-in for the upload server of [HttpLogChunkTransport]
+class _UploadServer {
+  late final HttpServer _server;
+
+  /// Stored chunks, uncompressed, by id
+  final Map<String, Uint8List> chunks = <String, Uint8List>{};
+
+  /// Committed logs, rebuilt from their chunks
+  final Map<String, Uint8List> logs = <String, Uint8List>{};
+
+  /// Number of chunk uploads received
+  int uploadCount = 0;
+
+  /// Number of the next chunk uploads failing with status 500
+  int failures = 0;
+
+  /// When set, the chunk uploads wait for it before replying
+  Completer<void>? gate;
+
+  /// Called when a chunk upload is received
+  void Function()? onUpload;
+
+  Uri get uri => Uri.parse('http://127.0.0.1:${_server.port}/api/');
+
+  Future<void> start() async {
+    _server = await HttpServer.bind(InternetAddress.loopbackIPv4, 0);
+    _server.listen(_handle);
+  }
+
+  Future<void> close() => _server.close(force: true);
+
+  Future<void> _handle(final HttpRequest request) async {
+    final BytesBuilder body = BytesBuilder(copy: false);
+    final List<String> path = request.uri.pathSegments;
+    final HttpResponse response = request.response;
+    try {
+      await request.forEach(body.add);
+      if (request.method == 'PUT' && path[1] == 'chunks') {
+        uploadCount++;
+        onUpload?.call();
+        await gate?.future;
+        if (failures > 0) {
+          failures--;
+          response.statusCode = HttpStatus.internalServerError;
+        } else {
+          final Uint8List chunk =
+              Uint8List.fromList(gzip.decode(body.takeBytes()));
+          if (sha256.convert(chunk).toString() == path[2]) {
+            chunks[path[2]] = chunk;
+          } else {
+            response.statusCode = HttpStatus.badRequest;
+          }
+        }
+      } else if (path[3] == 'missing') {
+        final Map<String, dynamic> json =
+            jsonDecode(utf8.decode(body.takeBytes()));
+        response
+          ..headers.contentType = ContentType.json
+          ..write(
+            jsonEncode(<String, Object>{
+              'missing': <String>[
+                for (final dynamic id in json['chunks'] as List<dynamic>)
+                  if (!chunks.containsKey(id)) id as String,
+              ],
+            }),
+          );
+      } else {
+        final Map<String, dynamic> json =
+            jsonDecode(utf8.decode(body.takeBytes()));
+        final BytesBuilder log = BytesBuilder(copy: false);
+        for (final dynamic id in json['chunks'] as List<dynamic>) {
+          log.add(chunks[id]!);
+        }
+        if (log.length == json['size']) {
+          logs[path[2]] = log.takeBytes();
+        } else {
+          response.statusCode = HttpStatus.badRequest;
+        }
+      }
+      await response.close();
+    } on IOException {
+      // The client aborted the request
+    }
+  }
+}
+
+/// Transport returning the same missing set for every window
+class _SharedSetTransport extends LogChunkTransport {
+  final Set<String> missing = <String>{};
+
+  @override
+  Future<Set<String>> missingChunks(
+    final String logName,
+    final List<String> chunkIds,
+  ) async {
+    missing.addAll(chunkIds);
+    return missing;
+  }
+
+  @override
+  Future<void> uploadChunk(final String logName, final LogChunk chunk) async {}
+
+  @override
+  Future<void> commit(
+    final String logName,
+    final List<String> chunkIds,
+    final int size,
+  ) async {}
+}
+
+Uint8List _randomBytes(final int length, final int seed) {
+  final Random random = Random(seed);
+  return Uint8List.fromList(
+    List<int>.generate(length, (final int _) => random.nextInt(256)),
+  );
+}
+
+void main() {
+  late Directory directory;
+  late _UploadServer server;
+  late HttpLogChunkTransport transport;
+  late String logPath;
+  late Uint8List content;
+
+  setUp(() async {
+    directory = await Directory.systemTemp.createTemp('log_chunk_uploader');
+    server = _UploadServer();
+    await server.start();
+    transport = HttpLogChunkTransport(server.uri);
+    logPath = '${directory.path}/drive.gm';
+    content = _randomBytes(1 << 20, 1);
+    await File(logPath).writeAsBytes(content);
+  });
+
+  tearDown(() async {
+    server.gate?.complete();
+    transport.close();
+    await server.close();
+    await directory.delete(recursive: true);
+  });
+
+  LogChunkUploader uploader({final int maxRetries = 0}) => LogChunkUploader(
+        transport,
+        averageChunkSize: 16 << 10,
+        maxRetries: maxRetries,
+      );
+
+  test('uploads the log in chunks', () async {
+    LogChunkUploadProgress? last;
+    final GemError error = await uploader().upload(
+      logPath,
+      onProgressUpdated: (final LogChunkUploadProgress progress) =>
+          last = progress,
+    );
+
+    expect(error, GemError.success);
+    expect(server.logs['drive.gm'], content);
+    expect(server.uploadCount, greaterThan(1));
+    expect(last!.progress, 100);
+    expect(last!.sentChunkCount, server.uploadCount);
+    expect(last!.deduplicatedChunkCount, 0);
+  });
+
+  test('sends only the changed chunks again', () async {
+    expect(await uploader().upload(logPath), GemError.success);
+    final int firstCount = server.uploadCount;
+
+    content.setRange(1000, 1100, _randomBytes(100, 2));
+    await File(logPath).writeAsBytes(content);
+    LogChunkUploadProgress? last;
+    final GemError error = await uploader().upload(
+      logPath,
+      logName: 'drive2.gm',
+      onProgressUpdated: (final LogChunkUploadProgress progress) =>
+          last = progress,
+    );
+
+    expect(error, GemError.success);
+    expect(server.logs['drive2.gm'], content);
+    expect(server.uploadCount - firstCount, lessThanOrEqualTo(2));
+    expect(last!.deduplicatedChunkCount, greaterThan(0));
+  });
+
+  test('retries the failed chunks', () async {
+    server.failures = 1;
+    expect(await uploader(maxRetries: 1).upload(logPath), GemError.success);
+    expect(server.logs['drive.gm'], content);
+  });
+
+  test('reports the transport failures', () async {
+    server.failures = 1;
+    expect(await uploader().upload(logPath), GemError.networkFailed);
+    expect(server.logs, isEmpty);
+
+    expect(await uploader().upload(logPath), GemError.success);
+    expect(server.logs['drive.gm'], content);
+  });
+
+  test('aborts the uploads in progress when cancelled', () async {
+    final LogChunkUploader chunkUploader = uploader();
+    server.gate = Completer<void>();
+    server.onUpload = () => chunkUploader.cancel(logPath);
+
+    // Completes while the server still holds the uploads
+    final GemError error = await chunkUploader
+        .upload(logPath)
+        .timeout(const Duration(seconds: 10));
+
+    expect(error, GemError.cancel);
+    expect(server.chunks, isEmpty);
+    expect(server.logs, isEmpty);
+    expect(
+      server.uploadCount,
+      lessThanOrEqualTo(chunkUploader.parallelUploads),
+    );
+  });
+
+  test('fails on a missing log', () async {
+    expect(
+      await uploader().upload('${directory.path}/missing.gm'),
+      GemError.notFound,
+    );
+  });
+
+  test('does not modify the set returned by the transport', () async {
+    final _SharedSetTransport shared = _SharedSetTransport();
+    final GemError error = await LogChunkUploader(
+      shared,
+      averageChunkSize: 16 << 10,
+    ).upload(logPath);
+
+    expect(error, GemError.success);
+    expect(shared.missing, isNotEmpty);
+  });
+}